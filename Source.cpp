@@ -22,7 +22,8 @@
 //     * OpenGL coding via GLAD, GLFW, and GLM
 //     * Complex game logic to handle collision processing
 //     * Custom classes designed to modularize specialized functionality
-//     * Inheritance through a GameObject parent class and multiple child classes
+//     * Inheritance through a GameObject parent class (player paddle)
+//     * Packed component arrays (archetypes) for the balls and bricks
 //     * Create custom files based on tilemap concept
 //     * Read data from file to build game levels
 //     * High Scalability due to ease of designing and adding additional levels
@@ -49,12 +50,38 @@
 //     * Initializing game elements:        game.cpp
 //     * Processes user input:              game.cpp
 //	   * Processes collisions:              game.cpp
+//	   * Detects collisions:                collision.cpp
 //     * Manages the game updates:          game.cpp
-//     * Manages rendering game elements:   game.cpp
+//     * Manages rendering game elements:   game_render.cpp
 //     * Loading the level from file:       game_level.cpp
 //     * Storing level/brick data:          game_level.cpp
 //	   * Manages level/brick data:          game_level.cpp
-//     * Manages level/brick rendering:     game_level.cpp
+//     * Manages level/brick rendering:     game_render.cpp
+//     * Loading the level pack manifest:   level_pack.cpp
+//     * Background level prefetching:     level_pack.cpp
+//     * Procedural level generation:      level_generator.cpp
+//     * Level scaling benchmark:          level_benchmark.cpp
+//     * Microbenchmark runner:            benchmark.cpp
+//     * Recording / playing input:        replay.cpp
+//     * Headless simulation:              headless_sim.cpp
+//     * Simulation microbenchmarks:       microbenchmarks.cpp
+//     * Ball / brick components:          components.h, archetype.h
+//     * Pipelined frames (job system):    job_system.cpp, render_list.cpp
+//     * Input latency measurement:        latency_tracker.cpp
+//     * Key event queue:                  input_queue.cpp
+//     * Frame pacing:                     frame_pacer.cpp
+//     * Level progression:                game.cpp
+//     * Section timing (profiler):        profiler.cpp
+//     * Deterministic physics:            game_fixed.cpp, fixed_point.h
+//     * State hashing / hash logs:        state_hash.cpp
+//     * Game state snapshots (rollback):  game_snapshot.cpp
+//     * Rollback netplay (loopback UDP):  rollback_session.cpp, udp_socket.cpp
+//     * Netplay test (two peers):         netplay_sim.cpp
+//     * Training environments (C API):   env_batch.cpp, breakout_env.h
+//     * Pixel observations (CPU):        frame_encoder.cpp
+//     * AI paddle (attract mode):        paddle_controller.cpp
+//     * Long session soak test:          soak_test.cpp
+//     * Level hot reload (file watcher):  level_watcher.cpp
 // 
 //  ------------------------------------------------------
 // 
@@ -85,7 +112,17 @@
 #include <GLFW/glfw3.h>
 
 #include "game.h"
-
+#include "replay.h"
+#include "job_system.h"
+#include "render_list.h"
+#include "latency_tracker.h"
+#include "input_queue.h"
+#include "frame_pacer.h"
+#include "rollback_session.h"
+#include "paddle_controller.h"
+
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
 
 
@@ -100,10 +137,19 @@ GLFWwindow* gameWindow = nullptr;
 // Call game constructor to create the game object
 Game game(SCREEN_WIDTH, SCREEN_HEIGHT);
 
+// Key events from key_callback, in order and timestamped, waiting for the simulation
+InputQueue inputQueue;
+
+// Input latency measurement (--latency, or --latency-log <file> to also save every key event)
+LatencyTracker latencyTracker;
+bool isTrackingLatency = false;
+
 // Forward Method Declarations
 void framebuffer_size_callback(GLFWwindow* window, int width, int height);
 void key_callback(GLFWwindow* window, int key, int scancode, int action, int mode);
 bool InitializeWindow(int argc, char* argv[], GLFWwindow** window);
+void WaitForFence(GLsync fence);
+void ProcessFrameInput(float dt, double sample_time, bool is_recording);
 
 
 //-------------------//
@@ -124,10 +170,185 @@ int main(int argc, char* argv[])
     // Call the Game::InitGame method to initialize the game
     game.InitGame();
 
+    // Check for a replay file to record the session to (--record <file>)
+    const char* recordFile = nullptr;
+    Replay recording;
+
+    // Check for pipelined frames (--pipeline) and the number of job threads to use (--job-threads <n>, 0 = one per core)
+    bool isPipelined = false;
+    unsigned int numJobThreads = 0;
+
+    // Check for low latency mode (--low-latency) and where to save the latency log (--latency-log <file>)
+    bool isLowLatency = false;
+    const char* latencyLogFile = nullptr;
+
+    // Check for the frame pacing mode (--pacing uncapped|vsync|adaptive|fixed) and the fixed mode frame rate (--fps <n>)
+    const char* pacingMode = nullptr;
+    float targetFps = 60.0f;
+
+    // Check for the deterministic (fixed point) physics mode (--fixed-point)
+    bool isFixedPoint = false;
+
+    // Check for co-op rollback netplay (--netplay <local port> <remote port>) and the simulated network
+    // (--net-latency <ms>, --net-jitter <ms>, --net-loss <fraction>)
+    bool isNetplay = false;
+    unsigned short localPort = 0;
+    unsigned short remotePort = 0;
+    double netLatency = 0.0;
+    double netJitter = 0.0;
+    double netLoss = 0.0;
+
+    // Check for attract mode (--attract), where the AI paddle controller plays the game
+    bool isAttractMode = false;
+
+    // Check for level hot reload (--hot-reload), which patches edited level files into the running game
+    bool isHotReloaded = false;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--pipeline") == 0)
+            isPipelined = true;
+
+        if (i + 1 < argc && std::strcmp(argv[i], "--record") == 0)
+            recordFile = argv[i + 1];
+
+        if (i + 1 < argc && std::strcmp(argv[i], "--job-threads") == 0)
+            numJobThreads = static_cast<unsigned int>(std::atoi(argv[i + 1]));
+
+        if (std::strcmp(argv[i], "--low-latency") == 0)
+            isLowLatency = true;
+
+        if (std::strcmp(argv[i], "--latency") == 0)
+            isTrackingLatency = true;
+
+        if (i + 1 < argc && std::strcmp(argv[i], "--latency-log") == 0)
+        {
+            latencyLogFile = argv[i + 1];
+            isTrackingLatency = true;
+        }
+
+        if (i + 1 < argc && std::strcmp(argv[i], "--pacing") == 0)
+            pacingMode = argv[i + 1];
+
+        if (i + 1 < argc && std::strcmp(argv[i], "--fps") == 0)
+            targetFps = static_cast<float>(std::atof(argv[i + 1]));
+
+        if (std::strcmp(argv[i], "--fixed-point") == 0)
+            isFixedPoint = true;
+
+        if (i + 2 < argc && std::strcmp(argv[i], "--netplay") == 0)
+        {
+            isNetplay = true;
+            localPort = static_cast<unsigned short>(std::atoi(argv[i + 1]));
+            remotePort = static_cast<unsigned short>(std::atoi(argv[i + 2]));
+        }
+
+        if (i + 1 < argc && std::strcmp(argv[i], "--net-latency") == 0)
+            netLatency = std::atof(argv[i + 1]) / 1000.0;
+
+        if (i + 1 < argc && std::strcmp(argv[i], "--net-jitter") == 0)
+            netJitter = std::atof(argv[i + 1]) / 1000.0;
+
+        if (i + 1 < argc && std::strcmp(argv[i], "--net-loss") == 0)
+            netLoss = std::atof(argv[i + 1]);
+
+        if (std::strcmp(argv[i], "--attract") == 0)
+            isAttractMode = true;
+
+        if (std::strcmp(argv[i], "--hot-reload") == 0)
+            isHotReloaded = true;
+    }
+
+    game.SetFixedPoint(isFixedPoint);
+
+    // Set up attract mode
+    // NOTE: The controller presses the game's keys on the main thread just before they are processed, so
+    //       attract mode turns off pipelined frames, recording and netplay
+    PaddleController attractController;
+
+    if (isAttractMode)
+    {
+        isPipelined = false;
+        recordFile = nullptr;
+
+        if (isNetplay)
+        {
+            std::cout << "Attract mode turns off netplay" << std::endl;
+            isNetplay = false;
+        }
+    }
+
+    // Start watching the level files
+    // NOTE: Edits are not part of the netplay inputs (or of snapshots), so the peers would drift apart
+    if (isHotReloaded)
+    {
+        if (isNetplay)
+            std::cout << "Level hot reload is not available during netplay" << std::endl;
+        else
+            game.WatchLevelFiles();
+    }
+
+    // Start the netplay session (both players must start the game with the same options)
+    // NOTE: The session steps the game one fixed 1/60 s frame per rendered frame, on the main thread, so
+    //       netplay turns off pipelined frames and recording
+    RollbackSession netplaySession;
+    bool netplayKeys[1024] = {};
+
+    if (isNetplay)
+    {
+        if (!netplaySession.Start(game, localPort, remotePort))
+        {
+            glfwTerminate();
+            return -1;
+        }
+
+        netplaySession.SetSimulatedNetwork(netLatency, netJitter, netLoss, localPort);
+        isPipelined = false;
+        recordFile = nullptr;
+    }
+
+    // Set up frame pacing (vsync unless another mode was chosen)
+    FramePacer framePacer;
+
+    // An unknown --pacing mode is reported by SetMode
+    if (pacingMode != nullptr && !framePacer.SetMode(pacingMode, targetFps))
+    {
+        glfwTerminate();
+        return -1;
+    }
+
+    int swapInterval = framePacer.GetSwapInterval();
+
+    // Adaptive vsync needs the swap control tear extension, otherwise use plain vsync
+    if (swapInterval < 0 && !glfwExtensionSupported("WGL_EXT_swap_control_tear") && !glfwExtensionSupported("GLX_EXT_swap_control_tear"))
+    {
+        std::cout << "Adaptive vsync is not supported, using vsync" << std::endl;
+        swapInterval = 1;
+    }
+
+    glfwSwapInterval(swapInterval);
+
+    // Variables used by pipelined frames
+    // NOTE: While frame N+1 is simulated on a job thread, the shapes for frame N are built from the
+    //       render state captured at the end of frame N, so the picture is always one frame behind
+    JobSystem jobSystem;
+    RenderState renderState;
+    RenderList renderList;
+
+    if (isPipelined)
+    {
+        jobSystem.Start(numJobThreads);
+        game.CaptureRenderState(renderState);
+    }
+
     // Create and initialize Delta Time Variables
     float deltaTime = 0.0f;
     float lastFrame = 0.0f;
 
+    // Number of the current frame, and the fence marking the end of the previous frame's GPU work (low latency mode)
+    unsigned int frameIndex = 0;
+    GLsync frameFence = nullptr;
+
     //-----------------//
     //                 //
     //  The Game Loop  //
@@ -136,6 +357,27 @@ int main(int argc, char* argv[])
 
     while (!glfwWindowShouldClose(gameWindow))
     {
+        frameIndex += 1;
+
+        // Frame Pacing
+        // ------------
+        // Wait for the next frame to be due (fixed mode only) and measure the frame time
+        framePacer.BeginFrame();
+
+        // Low Latency Mode
+        // ----------------
+        // Wait until the GPU has finished the previous frame before sampling the keys, so frames
+        // cannot queue up in the driver and the keys are read as late as possible before rendering
+        if (frameFence != nullptr)
+        {
+            WaitForFence(frameFence);
+            glDeleteSync(frameFence);
+            frameFence = nullptr;
+
+            if (isTrackingLatency)
+                latencyTracker.CompleteFrame(glfwGetTime());
+        }
+
         // Calculate Delta Time
         // --------------------
         float currentFrame = glfwGetTime();
@@ -143,16 +385,110 @@ int main(int argc, char* argv[])
         lastFrame = currentFrame;
         glfwPollEvents();
 
+        // Time at which this frame sampled the keys
+        double sampleTime = glfwGetTime();
+
         // Set the color for glClear
         glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
 
-        // Process User Input
-        // ------------------
-        game.ProcessInput(deltaTime);
+        // Record the keys for this frame, if recording
+        // NOTE: Replays hold the keys once per frame, so while recording the key events are applied at the start of the frame
+        bool isRecording = (recordFile != nullptr);
+
+        if (isRecording)
+        {
+            game.ApplyInputEvents(inputQueue, sampleTime);
+            recording.RecordFrame(game, deltaTime);
+        }
 
-        // Update the Game
+        // Pipelined Frame
         // ---------------
-        game.UpdateGame(deltaTime);
+        if (isPipelined)
+        {
+            JobCounter simulationJob(0);
+            JobCounter buildJob(0);
+
+            // Simulate this frame on a job thread...
+            jobSystem.Schedule([deltaTime, sampleTime, isRecording] {
+                ProcessFrameInput(deltaTime, sampleTime, isRecording);
+                game.UpdateGame(deltaTime);
+            }, simulationJob);
+
+            // ...while the shapes for the previous frame are built on another one
+            // NOTE: With a single job thread, the main thread may run the simulation itself while it waits
+            jobSystem.Schedule([&renderState, &renderList] {
+                renderState.BuildRenderList(renderList);
+            }, buildJob);
+
+            // Only the OpenGL calls stay on the main thread
+            jobSystem.Wait(buildJob);
+            glClear(GL_COLOR_BUFFER_BIT);
+            game.DrawRenderList(renderList);
+            glfwSwapBuffers(gameWindow);
+
+            if (isLowLatency)
+                frameFence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+            // The picture just swapped is the previous frame's, so stamp its key events before
+            // this frame claims its own
+            if (isTrackingLatency)
+            {
+                latencyTracker.SwapFrame(glfwGetTime());
+                latencyTracker.SampleFrame(frameIndex, sampleTime);
+            }
+
+            // Capture this frame's state once it has been simulated, ready to be drawn next frame
+            jobSystem.Wait(simulationJob);
+            game.CaptureRenderState(renderState);
+
+            continue;
+        }
+
+        // Claim the key events received so far for this frame
+        if (isTrackingLatency)
+            latencyTracker.SampleFrame(frameIndex, sampleTime);
+
+        // Netplay Frame
+        // -------------
+        // The local player's keys are kept apart from the game's keys, which the session sets to both players' keys
+        if (isNetplay)
+        {
+            InputEvent inputEvent;
+
+            while (inputQueue.Peek(inputEvent) && inputEvent.time <= sampleTime)
+            {
+                inputQueue.Pop();
+
+                if (inputEvent.key >= 0 && inputEvent.key < 1024)
+                    netplayKeys[inputEvent.key] = inputEvent.isPressed;
+            }
+
+            netplaySession.AdvanceFrame(game, RollbackSession::InputFromKeys(netplayKeys), sampleTime);
+        }
+        else if (isAttractMode)
+        {
+            // Attract Mode Frame
+            // ------------------
+            // The player's key events are thrown away and the controller presses the keys instead
+            InputEvent inputEvent;
+
+            while (inputQueue.Peek(inputEvent))
+                inputQueue.Pop();
+
+            attractController.Update(game, deltaTime);
+            game.ProcessInput(deltaTime);
+            game.UpdateGame(deltaTime);
+        }
+        else
+        {
+            // Process User Input
+            // ------------------
+            ProcessFrameInput(deltaTime, sampleTime, isRecording);
+
+            // Update the Game
+            // ---------------
+            game.UpdateGame(deltaTime);
+        }
 
         // Render the Frame
         // ----------------
@@ -162,8 +498,45 @@ int main(int argc, char* argv[])
 
         // Swap the front and back buffers to update displayed image for current frame
         glfwSwapBuffers(gameWindow);
+
+        // Mark the end of this frame's GPU work (low latency mode waits for it before the next frame)
+        if (isLowLatency)
+            frameFence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+        if (isTrackingLatency)
+            latencyTracker.SwapFrame(glfwGetTime());
+    }
+
+    if (frameFence != nullptr)
+        glDeleteSync(frameFence);
+
+    // Report the frame times, if a pacing mode was chosen
+    if (pacingMode != nullptr)
+        framePacer.PrintReport();
+
+    // Report the measured input latency
+    if (isTrackingLatency)
+    {
+        latencyTracker.PrintReport();
+
+        if (latencyLogFile != nullptr)
+            latencyTracker.Save(latencyLogFile);
     }
 
+    // Report the rollbacks and packets of the netplay session
+    if (isNetplay)
+        netplaySession.PrintReport();
+
+    // Save the recorded session
+    if (recordFile != nullptr)
+        recording.Save(recordFile);
+
+    // Stop the job threads before the game is shut down
+    jobSystem.Stop();
+
+    // Free the shader and shape renderer while the OpenGL context still exists
+    game.ReleaseRenderer();
+
     // Close the GLFW window
     glfwTerminate();
 
@@ -193,22 +566,43 @@ void key_callback(GLFWwindow* window, int key, int scancode, int action, int mod
     // Check standard keys
     if (key >= 0 && key < 1024)
     {
-        // If the user presses a key... 
-        if (action == GLFW_PRESS)
-        {
-            // Set the corresponding boolean in the game.keys array to true
-            game.keys[key] = true;
-        }
-        // If the user releases a key...
-        else if (action == GLFW_RELEASE)
+        // If the user presses or releases a key (repeats are ignored)...
+        if (action == GLFW_PRESS || action == GLFW_RELEASE)
         {
-            // Set the corresponding boolean in the game.keys array to false
-            game.keys[key] = false;
+            double eventTime = glfwGetTime();
+
+            // Queue the key event for the simulation, which updates the game.keys array from it
+            InputEvent inputEvent;
+            inputEvent.key = key;
+            inputEvent.isPressed = (action == GLFW_PRESS);
+            inputEvent.time = eventTime;
+
+            inputQueue.Push(inputEvent);
+
+            // Timestamp the key event for the input latency measurement
+            if (isTrackingLatency)
+                latencyTracker.AddKeyEvent(key, eventTime);
         }
     }
 }
 
 
+// Method which processes the user input for a frame
+// -------------------------------------------------
+void ProcessFrameInput(float dt, double sample_time, bool is_recording)
+{
+    // While recording, the keys were already applied for the whole frame (see the game loop)
+    if (is_recording)
+    {
+        game.ProcessInput(dt);
+        return;
+    }
+
+    // Otherwise move the player paddle at the exact time of each key event
+    game.ProcessInputEvents(inputQueue, sample_time, dt);
+}
+
+
 // Method which initializes the GLFW window
 // ----------------------------------------
 bool InitializeWindow(int argc, char* argv[], GLFWwindow** window)
@@ -262,3 +656,17 @@ bool InitializeWindow(int argc, char* argv[], GLFWwindow** window)
 
     return true;
 }
+
+
+// Method which waits until the GPU has passed a fence
+// ---------------------------------------------------
+void WaitForFence(GLsync fence)
+{
+    // Flush the commands once, then keep waiting in 1 ms steps until the fence is signaled (or the wait fails)
+    GLbitfield flags = GL_SYNC_FLUSH_COMMANDS_BIT;
+
+    while (glClientWaitSync(fence, flags, 1000000) == GL_TIMEOUT_EXPIRED)
+    {
+        flags = 0;
+    }
+}
@@ -0,0 +1,214 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//  BREAKOUT REMIX
+//  --------------
+//  by slate2b
+//
+//  The Archetype class stores every entity of one kind (e.g. every brick)
+//  with one packed std::vector per component (see components.h).  An
+//  entity is simply its index in those vectors.
+//
+//  Systems which only need a few components (e.g. collision checks only
+//  need the colliders and the Breakable flags of the bricks) loop through
+//  just those vectors, so they read memory in order and never load data
+//  they do not use.
+//
+//  The View class (e.g. BrickObject) is a thin object holding references
+//  to one entity's components.  Views are handed out by operator[] and by
+//  range-based for loops:
+//
+//     for (BrickObject brick_object : level.bricks) ...
+//
+//  NOTE: Adding entities can move the component vectors, which makes any
+//        existing view (or component reference) invalid.
+//
+///////////////////////////////////////////////////////////////////////////
+
+#ifndef ARCHETYPE_H
+#define ARCHETYPE_H
+
+#include <cstddef>
+#include <cstring>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+template <class View, class... Components>
+class Archetype
+{
+
+public:
+
+	// Iterator which returns a view for each entity (used by range-based for loops)
+	class Iterator
+	{
+
+	public:
+
+		Iterator(Archetype& archetype, unsigned int index)
+			: archetype(&archetype), index(index) {}
+
+		View operator*() const { return View(*this->archetype, this->index); }
+		Iterator& operator++() { this->index += 1; return *this; }
+		bool operator!=(const Iterator& other) const { return this->index != other.index; }
+
+	private:
+
+		Archetype* archetype;
+		unsigned int index;
+	};
+
+	// Method to add an entity with default components and return a view of it
+	View Add()
+	{
+		return this->Add(Components()...);
+	}
+
+	// Method to add an entity with the given components and return a view of it
+	View Add(const Components&... components)
+	{
+		// Push each component onto its own vector
+		int expand[] = { 0, (std::get<std::vector<Components>>(this->columns).push_back(components), 0)... };
+		(void)expand;
+
+		return View(*this, this->count++);
+	}
+
+	// Method to return the number of entities
+	unsigned int Size() const
+	{
+		return this->count;
+	}
+
+	// Method to reserve space for a number of entities in every component vector
+	void Reserve(unsigned int num_entities)
+	{
+		int expand[] = { 0, (std::get<std::vector<Components>>(this->columns).reserve(num_entities), 0)... };
+		(void)expand;
+	}
+
+	// Method to remove every entity
+	void Clear()
+	{
+		int expand[] = { 0, (std::get<std::vector<Components>>(this->columns).clear(), 0)... };
+		(void)expand;
+
+		this->count = 0;
+	}
+
+	// Method to exchange entities with another archetype of the same kind (no copying)
+	void Swap(Archetype& other)
+	{
+		this->columns.swap(other.columns);
+		std::swap(this->count, other.count);
+	}
+
+	// Method to return the number of bytes of components each entity has
+	static size_t GetEntityBytes()
+	{
+		size_t sizes[] = { 0, sizeof(Components)... };
+		size_t bytesPerEntity = 0;
+
+		for (size_t size : sizes)
+			bytesPerEntity += size;
+
+		return bytesPerEntity;
+	}
+
+	// Method to return the number of bytes SaveColumns writes for the current entities
+	size_t GetColumnBytes() const
+	{
+		return GetEntityBytes() * this->count;
+	}
+
+	// Method to copy every component of every entity into a buffer, one packed vector after another
+	// NOTE: Returns the end of the data written (GetColumnBytes bytes after buffer)
+	unsigned char* SaveColumns(unsigned char* buffer) const
+	{
+		int expand[] = { 0, (buffer = SaveColumn(std::get<std::vector<Components>>(this->columns), buffer), 0)... };
+		(void)expand;
+
+		return buffer;
+	}
+
+	// Method to replace every entity with num_entities entities read from a buffer written by SaveColumns
+	// NOTE: Returns the end of the data read.  Does not allocate if the vectors already have room.
+	const unsigned char* RestoreColumns(const unsigned char* buffer, unsigned int num_entities)
+	{
+		int expand[] = { 0, (buffer = RestoreColumn(std::get<std::vector<Components>>(this->columns), buffer, num_entities), 0)... };
+		(void)expand;
+
+		this->count = num_entities;
+		return buffer;
+	}
+
+	// Method to return the packed vector holding one component for every entity
+	template <class Component>
+	std::vector<Component>& Column()
+	{
+		return std::get<std::vector<Component>>(this->columns);
+	}
+
+	template <class Component>
+	const std::vector<Component>& Column() const
+	{
+		return std::get<std::vector<Component>>(this->columns);
+	}
+
+	// Method to return one component of an entity
+	template <class Component>
+	Component& Get(unsigned int index)
+	{
+		return std::get<std::vector<Component>>(this->columns)[index];
+	}
+
+	// Method to return a view of an entity
+	View operator[](unsigned int index)
+	{
+		return View(*this, index);
+	}
+
+	// Methods used by range-based for loops
+	Iterator begin() { return Iterator(*this, 0); }
+	Iterator end() { return Iterator(*this, this->count); }
+
+private:
+
+	// Method to copy one packed vector into a buffer (components must be plain data)
+	template <class Component>
+	static unsigned char* SaveColumn(const std::vector<Component>& column, unsigned char* buffer)
+	{
+		static_assert(std::is_trivially_copyable<Component>::value, "Components must be trivially copyable to be saved");
+
+		size_t bytes = column.size() * sizeof(Component);
+
+		if (bytes > 0)
+			std::memcpy(buffer, column.data(), bytes);
+
+		return buffer + bytes;
+	}
+
+	// Method to fill one packed vector with num_entities components read from a buffer
+	template <class Component>
+	static const unsigned char* RestoreColumn(std::vector<Component>& column, const unsigned char* buffer, unsigned int num_entities)
+	{
+		static_assert(std::is_trivially_copyable<Component>::value, "Components must be trivially copyable to be restored");
+
+		size_t bytes = num_entities * sizeof(Component);
+		column.resize(num_entities);
+
+		if (bytes > 0)
+			std::memcpy(column.data(), buffer, bytes);
+
+		return buffer + bytes;
+	}
+
+	// One packed vector per component
+	std::tuple<std::vector<Components>...> columns;
+
+	// Number of entities
+	unsigned int count = 0;
+};
+
+#endif
@@ -6,14 +6,21 @@
 //
 //  The BallObject class represents the ball objects used to break bricks
 //  in the game.
-//  This class inherits from the GameObject class.
+//  The ball data is stored in a BallArchetype (one packed array per
+//  component, see archetype.h).  A BallObject is a thin view holding
+//  references to one ball's components, so code can keep using
+//  ball_object.Position, ball_object.isHeld, etc.
+//
+//  NOTE: A view is only valid until another ball is added to the archetype.
 // 
-//  The BallObject class adds these additional attributes:
+//  The BallObject class has these attributes:
 // 
+//     * Position, Size, Velocity and Color (same as the player paddle)
 //     * float Radius: Used to process collisions, not to render a circle)
 //     * bool isHeld: Whether the ball is being held by the player paddle)
+//     * bool isInPlay / isDestroyed: Whether the ball is in play / has dropped out
 // 
-//  The BallObject class adds this additional method:
+//  The BallObject class has this additional method:
 // 
 //     * MoveBall: Calculates new position for the ball. Called from the 
 //		 Game class's UpdateGame method.
@@ -22,19 +29,18 @@
 
 #include "ball_object.h"
 
-BallObject::BallObject()
-	: GameObject() {}
-
-BallObject::BallObject(unsigned int window_width, unsigned int window_height, Player& player)
-    : GameObject(glm::vec2(1.0f), glm::vec2(1.0f), glm::vec3(1.0f), glm::vec2(1.0f))
+BallObject::BallObject(BallArchetype& balls, unsigned int index)
+	: Position(balls.Get<Transform>(index).position),
+	  Size(balls.Get<Transform>(index).size),
+	  Velocity(balls.Get<::Velocity>(index).velocity),
+	  Color(balls.Get<Renderable>(index).color),
+	  Radius(balls.Get<CircleCollider>(index).radius),
+	  isHeld(balls.Get<BallState>(index).isHeld),
+	  isInPlay(balls.Get<BallState>(index).isInPlay),
+	  isDestroyed(balls.Get<BallState>(index).isDestroyed)
 {
-    // Setting initial size, position, and color in the InitBall method
-    this->InitBall(window_width, window_height, player);
 }
 
-BallObject::BallObject(glm::vec2 position, glm::vec2 size, glm::vec2 velocity)
-	: GameObject(position, size, glm::vec3(0.6f, 0.2f, 0.1f), velocity) {}
-
 
 // Method to initialize the ball object
 void BallObject::InitBall(unsigned int window_width, unsigned int window_height, Player& player)
@@ -71,13 +77,6 @@ void BallObject::InitBall(unsigned int window_width, unsigned int window_height,
     this->Radius = (ballSize.x / 2.0f);  // using ballSize.x is arbitrary. ballSize.y would have worked just as well.
 }
 
-// Method to draw the ball object
-void BallObject::DrawBall(ShapeRenderer& shape_renderer, Shader& shader)
-{
-    // Calling the GameObject class's Draw method
-    this->DrawObject(shape_renderer, shader);
-}
-
 // Method to calculate new position and return it via a vec2
 glm::vec2 BallObject::MoveBall(float dt, unsigned int window_width)
 {
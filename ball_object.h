@@ -6,14 +6,21 @@
 //
 //  The BallObject class represents the ball objects used to break bricks
 //  in the game.
-//  This class inherits from the GameObject class.
+//  The ball data is stored in a BallArchetype (one packed array per
+//  component, see archetype.h).  A BallObject is a thin view holding
+//  references to one ball's components, so code can keep using
+//  ball_object.Position, ball_object.isHeld, etc.
+//
+//  NOTE: A view is only valid until another ball is added to the archetype.
 // 
-//  The BallObject class adds these additional attributes:
+//  The BallObject class has these attributes:
 // 
+//     * Position, Size, Velocity and Color (same as the player paddle)
 //     * float Radius: Used to process collisions, not to render a circle)
 //     * bool isHeld: Whether the ball is being held by the player paddle)
+//     * bool isInPlay / isDestroyed: Whether the ball is in play / has dropped out
 // 
-//  The BallObject class adds this additional method:
+//  The BallObject class has this additional method:
 // 
 //     * MoveBall: Calculates new position for the ball. Called from the 
 //		 Game class's UpdateGame method.
@@ -23,43 +30,50 @@
 #ifndef BALLOBJECT_H
 #define BALLOBJECT_H
 
-#include <glad/glad.h>
 #include <glm/glm.hpp>
 
-#include "game_object.h"
+#include "archetype.h"
+#include "components.h"
 #include "player.h"
 
-class BallObject : public GameObject
+class BallObject;
+
+// Archetype holding the components of every ball
+typedef Archetype<BallObject, Transform, Velocity, CircleCollider, Renderable, BallState, FixedBody> BallArchetype;
+
+class BallObject
 {
 
 public:
 
+	// References to the ball's components
+	glm::vec2& Position;
+	glm::vec2& Size;
+	glm::vec2& Velocity;
+	glm::vec3& Color;
+
 	// Variable for radius
 	// NOTE: Not used to draw the ball, but used in collision processing
-	float Radius;
+	float& Radius;
 	
 	// Variable for whether the paddle is holding the ball
-	bool isHeld;
-
-
+	bool& isHeld;
 
-	bool isInPlay;
 
 
+	bool& isInPlay;
+	bool& isDestroyed;
 
-	// Default Constructor
-	BallObject();
 
-	// Constructor #2
-	BallObject(unsigned int window_width, unsigned int window_height, Player& player);
 
-	// Full Constructor
-	BallObject(glm::vec2 position, glm::vec2 size, glm::vec2 velocity);
+	// Constructor (view of the ball at index in the balls archetype)
+	BallObject(BallArchetype& balls, unsigned int index);
 
 	// Method to initialize the ball object
 	void InitBall(unsigned int window_width, unsigned int window_height, Player& player);
 
 	// Method to draw the ball object
+	// NOTE: Defined in game_render.cpp (renderer library)
 	void DrawBall(ShapeRenderer& shape_renderer, Shader& shader);
 
 	// Method to calculate new position and return it via a vec2
@@ -0,0 +1,390 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//  BREAKOUT REMIX
+//  --------------
+//  by slate2b
+//
+//  A small, portable microbenchmark runner modelled on Google Benchmark.
+//
+//  Each benchmark is a function taking a BenchmarkState.  The function
+//  runs its body state.iterations times, and the runner keeps raising
+//  the iteration count until the run lasts long enough to be measured.
+//
+//  The runner accepts the same flags as Google Benchmark, and writes the
+//  same JSON layout, so results can be diffed between commits with
+//  Google Benchmark's compare.py.
+//
+///////////////////////////////////////////////////////////////////////////
+
+#include "benchmark.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+// Address sink used by DoNotOptimizeAddress
+const void* volatile benchmarkSink = nullptr;
+
+// Method to keep the compiler from optimizing away a value the benchmark computed
+void DoNotOptimizeAddress(const void* address)
+{
+    benchmarkSink = address;
+}
+
+
+////////////////////
+//
+// Benchmark State
+//
+////////////////////
+
+BenchmarkState::BenchmarkState(unsigned long long num_iterations, const std::vector<long long>& args)
+{
+    iterations = num_iterations;
+    arguments = args;
+    itemsProcessed = 0;
+    realSeconds = 0.0;
+    cpuSeconds = 0.0;
+    isTiming = false;
+
+    this->ResumeTiming();
+}
+
+// Method to return one of the arguments the benchmark was registered with
+long long BenchmarkState::Range(unsigned int index) const
+{
+    return (index < this->arguments.size()) ? this->arguments[index] : 0;
+}
+
+// Method to report how many items were processed in total (reported as items_per_second)
+void BenchmarkState::SetItemsProcessed(unsigned long long items)
+{
+    this->itemsProcessed = items;
+}
+
+// Method to stop measuring time (e.g. while setting up the next batch of work)
+void BenchmarkState::PauseTiming()
+{
+    if (!this->isTiming)
+        return;
+
+    this->realSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - this->realStart).count();
+    this->cpuSeconds += static_cast<double>(std::clock() - this->cpuStart) / CLOCKS_PER_SEC;
+    this->isTiming = false;
+}
+
+// Method to start measuring time again
+void BenchmarkState::ResumeTiming()
+{
+    if (this->isTiming)
+        return;
+
+    this->cpuStart = std::clock();
+    this->realStart = std::chrono::steady_clock::now();
+    this->isTiming = true;
+}
+
+double BenchmarkState::GetRealSeconds() const
+{
+    return this->realSeconds;
+}
+
+double BenchmarkState::GetCpuSeconds() const
+{
+    return this->cpuSeconds;
+}
+
+unsigned long long BenchmarkState::GetItemsProcessed() const
+{
+    return this->itemsProcessed;
+}
+
+
+//////////////
+//
+// Benchmark
+//
+//////////////
+
+Benchmark::Benchmark(const char* benchmark_name, BenchmarkFunction benchmark_function)
+{
+    name = benchmark_name;
+    function = benchmark_function;
+}
+
+// Method to add a run with a single argument
+Benchmark* Benchmark::Arg(long long arg)
+{
+    this->argumentSets.push_back(std::vector<long long>(1, arg));
+    return this;
+}
+
+// Method to add a run with two arguments
+Benchmark* Benchmark::Args(long long arg_one, long long arg_two)
+{
+    std::vector<long long> args;
+    args.push_back(arg_one);
+    args.push_back(arg_two);
+    this->argumentSets.push_back(args);
+    return this;
+}
+
+// Method to add a run for every combination of the two argument lists
+Benchmark* Benchmark::ArgsProduct(const std::vector<long long>& first_args, const std::vector<long long>& second_args)
+{
+    for (long long first : first_args)
+    {
+        for (long long second : second_args)
+        {
+            this->Args(first, second);
+        }
+    }
+
+    return this;
+}
+
+// Method to add a run for every combination of the three argument lists
+Benchmark* Benchmark::ArgsProduct(const std::vector<long long>& first_args, const std::vector<long long>& second_args, const std::vector<long long>& third_args)
+{
+    for (long long first : first_args)
+    {
+        for (long long second : second_args)
+        {
+            for (long long third : third_args)
+            {
+                std::vector<long long> args;
+                args.push_back(first);
+                args.push_back(second);
+                args.push_back(third);
+                this->argumentSets.push_back(args);
+            }
+        }
+    }
+
+    return this;
+}
+
+
+///////////
+//
+// Runner
+//
+///////////
+
+// Method to return the list of registered benchmarks
+// NOTE: A function-level static so registration works regardless of static initialization order
+std::vector<Benchmark*>& RegisteredBenchmarks()
+{
+    static std::vector<Benchmark*> benchmarks;
+    return benchmarks;
+}
+
+// Method to register a benchmark with the runner
+Benchmark* RegisterBenchmark(const char* benchmark_name, BenchmarkFunction benchmark_function)
+{
+    Benchmark* benchmark = new Benchmark(benchmark_name, benchmark_function);
+    RegisteredBenchmarks().push_back(benchmark);
+    return benchmark;
+}
+
+// Struct to hold the result of a single benchmark run
+struct BenchmarkResult
+{
+    std::string name;
+    unsigned long long iterations;
+    double realTimeNs;
+    double cpuTimeNs;
+    double itemsPerSecond;
+};
+
+// Method to escape a string for use inside JSON
+std::string EscapeJson(const std::string& text)
+{
+    std::string escaped;
+
+    for (char c : text)
+    {
+        if (c == '"' || c == '\\')
+            escaped += '\\';
+
+        escaped += c;
+    }
+
+    return escaped;
+}
+
+// Method to write the results using Google Benchmark's JSON layout
+bool WriteJsonResults(const char* file, const char* executable, double min_time, const std::vector<BenchmarkResult>& results)
+{
+    std::ofstream fstream(file);
+
+    if (!fstream)
+    {
+        std::cout << "Error: Writing Benchmark Results " << file << std::endl;
+        return false;
+    }
+
+    // Record the local date and time of the run
+    std::time_t now = std::time(nullptr);
+    char date[64];
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+    fstream << "{\n";
+    fstream << "  \"context\": {\n";
+    fstream << "    \"date\": \"" << date << "\",\n";
+    fstream << "    \"executable\": \"" << EscapeJson(executable) << "\",\n";
+    fstream << "    \"num_cpus\": " << std::thread::hardware_concurrency() << ",\n";
+    fstream << "    \"min_time\": " << min_time << ",\n";
+#ifdef NDEBUG
+    fstream << "    \"library_build_type\": \"release\"\n";
+#else
+    fstream << "    \"library_build_type\": \"debug\"\n";
+#endif
+    fstream << "  },\n";
+    fstream << "  \"benchmarks\": [\n";
+
+    for (unsigned int i = 0; i < results.size(); ++i)
+    {
+        const BenchmarkResult& result = results[i];
+
+        fstream << "    {\n";
+        fstream << "      \"name\": \"" << EscapeJson(result.name) << "\",\n";
+        fstream << "      \"run_name\": \"" << EscapeJson(result.name) << "\",\n";
+        fstream << "      \"run_type\": \"iteration\",\n";
+        fstream << "      \"iterations\": " << result.iterations << ",\n";
+        fstream << "      \"real_time\": " << result.realTimeNs << ",\n";
+        fstream << "      \"cpu_time\": " << result.cpuTimeNs << ",\n";
+
+        if (result.itemsPerSecond > 0.0)
+            fstream << "      \"items_per_second\": " << result.itemsPerSecond << ",\n";
+
+        fstream << "      \"time_unit\": \"ns\"\n";
+        fstream << ((i + 1 < results.size()) ? "    },\n" : "    }\n");
+    }
+
+    fstream << "  ]\n";
+    fstream << "}\n";
+
+    return static_cast<bool>(fstream);
+}
+
+// Method to run one benchmark with one argument set until it has run for at least min_time seconds
+BenchmarkResult RunBenchmark(Benchmark& benchmark, const std::vector<long long>& args, const std::string& run_name, double min_time)
+{
+    unsigned long long iterations = 1;
+
+    while (true)
+    {
+        BenchmarkState state(iterations, args);
+        benchmark.function(state);
+        state.PauseTiming();
+
+        double elapsed = state.GetRealSeconds();
+
+        // Stop once the run is long enough (or the iteration count is absurdly high)
+        if (elapsed >= min_time || iterations >= 1000000000ULL)
+        {
+            BenchmarkResult result;
+            result.name = run_name;
+            result.iterations = iterations;
+            result.realTimeNs = elapsed * 1e9 / iterations;
+            result.cpuTimeNs = state.GetCpuSeconds() * 1e9 / iterations;
+            result.itemsPerSecond = (state.GetItemsProcessed() > 0 && elapsed > 0.0) ? state.GetItemsProcessed() / elapsed : 0.0;
+            return result;
+        }
+
+        // Predict how many iterations will reach the minimum time, growing by at most 10x per attempt
+        double multiplier = (elapsed > 0.0) ? (min_time * 1.4) / elapsed : 10.0;
+
+        if (multiplier > 10.0)
+            multiplier = 10.0;
+        if (multiplier < 2.0)
+            multiplier = 2.0;
+
+        iterations = static_cast<unsigned long long>(iterations * multiplier);
+    }
+}
+
+// Method to run the registered benchmarks (call from main)
+int RunBenchmarks(int argc, char* argv[])
+{
+    // Runner settings
+    std::string filter;
+    double minTime = 0.5;
+    const char* outFile = nullptr;
+    bool listOnly = false;
+
+    // Read the command line flags
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strncmp(argv[i], "--benchmark_filter=", 19) == 0)
+            filter = argv[i] + 19;
+        else if (std::strncmp(argv[i], "--benchmark_min_time=", 21) == 0)
+            minTime = std::strtod(argv[i] + 21, nullptr);
+        else if (std::strncmp(argv[i], "--benchmark_out=", 16) == 0)
+            outFile = argv[i] + 16;
+        else if (std::strcmp(argv[i], "--benchmark_list_tests") == 0)
+            listOnly = true;
+        else if (std::strncmp(argv[i], "--benchmark_out_format=", 23) == 0)
+            continue; // Only JSON output is supported
+        else
+        {
+            std::cout << "Error: Unknown option " << argv[i] << std::endl;
+            return -1;
+        }
+    }
+
+    std::vector<BenchmarkResult> results;
+
+    std::cout << "Benchmark                                          Time (ns)        CPU (ns)   Iterations" << std::endl;
+    std::cout << "-----------------------------------------------------------------------------------------" << std::endl;
+
+    for (Benchmark* benchmark : RegisteredBenchmarks())
+    {
+        // Benchmarks registered without arguments run once with no arguments
+        std::vector<std::vector<long long>> argumentSets = benchmark->argumentSets;
+
+        if (argumentSets.empty())
+            argumentSets.push_back(std::vector<long long>());
+
+        for (const std::vector<long long>& args : argumentSets)
+        {
+            // Build the run name in Google Benchmark's "name/arg1/arg2" form
+            std::ostringstream runName;
+            runName << benchmark->name;
+
+            for (long long arg : args)
+            {
+                runName << '/' << arg;
+            }
+
+            if (!filter.empty() && runName.str().find(filter) == std::string::npos)
+                continue;
+
+            if (listOnly)
+            {
+                std::cout << runName.str() << std::endl;
+                continue;
+            }
+
+            BenchmarkResult result = RunBenchmark(*benchmark, args, runName.str(), minTime);
+            results.push_back(result);
+
+            std::cout.width(45); std::cout << std::left << result.name;
+            std::cout.width(16); std::cout << std::right << result.realTimeNs;
+            std::cout.width(16); std::cout << result.cpuTimeNs;
+            std::cout.width(13); std::cout << result.iterations << std::endl;
+        }
+    }
+
+    if (outFile != nullptr && !listOnly)
+    {
+        if (!WriteJsonResults(outFile, argv[0], minTime, results))
+            return -1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,124 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//  BREAKOUT REMIX
+//  --------------
+//  by slate2b
+//
+//  A small, portable microbenchmark runner modelled on Google Benchmark.
+//
+//  Each benchmark is a function taking a BenchmarkState.  The function
+//  runs its body state.iterations times, and the runner keeps raising
+//  the iteration count until the run lasts long enough to be measured.
+//
+//  The runner accepts the same flags as Google Benchmark, and writes the
+//  same JSON layout, so results can be diffed between commits with
+//  Google Benchmark's compare.py:
+//
+//     --benchmark_filter=TEXT       Only run benchmarks whose name contains TEXT
+//     --benchmark_min_time=SECONDS  Minimum run time per benchmark (default 0.5)
+//     --benchmark_out=FILE          Write the results to FILE as JSON
+//     --benchmark_list_tests        List the benchmark names and exit
+//
+///////////////////////////////////////////////////////////////////////////
+
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <string>
+#include <vector>
+#include <chrono>
+#include <ctime>
+
+class BenchmarkState
+{
+
+public:
+
+	// Number of times the benchmark body should run
+	unsigned long long iterations;
+
+	// Constructor
+	BenchmarkState(unsigned long long num_iterations, const std::vector<long long>& args);
+
+	// Method to return one of the arguments the benchmark was registered with
+	long long Range(unsigned int index) const;
+
+	// Method to report how many items were processed in total (reported as items_per_second)
+	void SetItemsProcessed(unsigned long long items);
+
+	// Methods to leave setup work out of the measured time
+	void PauseTiming();
+	void ResumeTiming();
+
+	// Methods used by the runner to read the results
+	double GetRealSeconds() const;
+	double GetCpuSeconds() const;
+	unsigned long long GetItemsProcessed() const;
+
+private:
+
+	std::vector<long long> arguments;
+	unsigned long long itemsProcessed;
+
+	// Time measured so far, and the start of the current measured section
+	double realSeconds;
+	double cpuSeconds;
+	std::chrono::steady_clock::time_point realStart;
+	std::clock_t cpuStart;
+	bool isTiming;
+};
+
+// Typedef for a benchmark function
+typedef void (*BenchmarkFunction)(BenchmarkState& state);
+
+class Benchmark
+{
+
+public:
+
+	std::string name;
+	BenchmarkFunction function;
+
+	// Argument lists the benchmark runs with (one run per list)
+	std::vector<std::vector<long long>> argumentSets;
+
+	// Constructor
+	Benchmark(const char* benchmark_name, BenchmarkFunction benchmark_function);
+
+	// Method to add a run with a single argument
+	Benchmark* Arg(long long arg);
+
+	// Method to add a run with two arguments
+	Benchmark* Args(long long arg_one, long long arg_two);
+
+	// Method to add a run for every combination of the two argument lists
+	Benchmark* ArgsProduct(const std::vector<long long>& first_args, const std::vector<long long>& second_args);
+
+	// Method to add a run for every combination of the three argument lists
+	Benchmark* ArgsProduct(const std::vector<long long>& first_args, const std::vector<long long>& second_args, const std::vector<long long>& third_args);
+};
+
+// Method to register a benchmark with the runner
+Benchmark* RegisterBenchmark(const char* benchmark_name, BenchmarkFunction benchmark_function);
+
+// Method to run the registered benchmarks (call from main)
+int RunBenchmarks(int argc, char* argv[]);
+
+// Method to keep the compiler from optimizing away a value the benchmark computed
+void DoNotOptimizeAddress(const void* address);
+
+template <class T>
+inline void DoNotOptimize(const T& value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	asm volatile("" : : "r,m"(value) : "memory");
+#else
+	DoNotOptimizeAddress(&value);
+#endif
+}
+
+// Macro to register a benchmark function at startup
+#define BREAKOUT_BENCHMARK(function_name) \
+	static Benchmark* function_name##_registration = RegisterBenchmark(#function_name, function_name)
+
+#endif
@@ -0,0 +1,109 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//  BREAKOUT REMIX
+//  --------------
+//  by slate2b
+//
+//  C API for training agents against the game (reinforcement learning).
+//
+//  A BreakoutEnv holds a batch of game environments which are reset and
+//  stepped together.  Every call writes into buffers owned by the caller,
+//  one row per environment:
+//
+//     observations   num_envs * BREAKOUT_ENV_OBSERVATION_SIZE floats
+//     rewards        num_envs floats (the points scored by the step)
+//     dones          num_envs bytes (1 = the episode ended with the step)
+//
+//  The environments are split across worker threads.  Each one runs the
+//  same ProcessInput / UpdateGame path as the game, without a window.
+//  An episode ends when every ball is lost, or after max_episode_steps
+//  steps (0 = no limit).  An environment whose episode ended is reset
+//  straight away, so the observation returned with done = 1 is the first
+//  observation of the next episode.
+//
+//  The level files (levels.pack and the .lvl files) are loaded from the
+//  working folder, as for the game.
+//
+//     BreakoutEnv* env = breakout_env_create(64, 0, 10000);
+//     breakout_env_reset(env, 1, observations);
+//     breakout_env_step(env, actions, observations, rewards, dones);
+//     ...
+//     breakout_env_destroy(env);
+//
+//  Pixel observations can be drawn on the CPU with breakout_env_render,
+//  into num_envs * height * width * channels bytes (rows from the top,
+//  1 channel = grayscale, 3 = RGB), e.g. 84x84 grayscale.
+//
+//  Observation of one environment (positions divided by the window size,
+//  velocities by 500 pixels per second):
+//
+//     0        paddle centre x
+//     1        fraction of the level's bricks still standing
+//     2        1 if Space can hold or release a ball this step, otherwise 0
+//     3 + 6b   ball b: x, y, velocity x, velocity y, in play (0 / 1), held (0 / 1)
+//
+///////////////////////////////////////////////////////////////////////////
+
+#ifndef BREAKOUTENV_H
+#define BREAKOUTENV_H
+
+#include <stdint.h>
+
+#if defined(_WIN32) && defined(BREAKOUT_ENV_EXPORTS)
+#define BREAKOUT_ENV_API __declspec(dllexport)
+#else
+#define BREAKOUT_ENV_API
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Number of balls described by each observation (every game has 5 balls)
+#define BREAKOUT_ENV_MAX_BALLS 5
+
+// Number of floats in the observation of one environment
+#define BREAKOUT_ENV_OBSERVATION_SIZE (3 + 6 * BREAKOUT_ENV_MAX_BALLS)
+
+// Actions (one per environment per step)
+enum BreakoutAction {
+	BREAKOUT_ACTION_NOOP = 0,
+	BREAKOUT_ACTION_LEFT = 1,
+	BREAKOUT_ACTION_RIGHT = 2,
+	BREAKOUT_ACTION_FIRE = 3,
+	BREAKOUT_ACTION_LEFT_FIRE = 4,
+	BREAKOUT_ACTION_RIGHT_FIRE = 5
+};
+
+// Number of actions
+#define BREAKOUT_ENV_NUM_ACTIONS 6
+
+// Opaque batch of environments
+typedef struct BreakoutEnv BreakoutEnv;
+
+// Function to create num_envs environments stepped by num_threads threads (0 = one per core)
+// NOTE: Returns NULL if the environments could not be created (out of memory, or no level with bricks could be loaded)
+BREAKOUT_ENV_API BreakoutEnv* breakout_env_create(unsigned int num_envs, unsigned int num_threads, unsigned int max_episode_steps);
+
+// Function to destroy the environments
+BREAKOUT_ENV_API void breakout_env_destroy(BreakoutEnv* env);
+
+// Function to return the number of environments
+BREAKOUT_ENV_API unsigned int breakout_env_count(const BreakoutEnv* env);
+
+// Function to start a new episode in every environment and write the first observations
+// NOTE: The start of each episode (the paddle position) comes from seed, so the same seed gives the same episodes
+BREAKOUT_ENV_API void breakout_env_reset(BreakoutEnv* env, uint64_t seed, float* observations);
+
+// Function to step every environment with its action and write the observations, rewards and dones
+BREAKOUT_ENV_API void breakout_env_step(BreakoutEnv* env, const int* actions, float* observations, float* rewards, unsigned char* dones);
+
+// Function to draw every environment into pixels (width * height * channels bytes each, channels 1 or 3)
+// NOTE: Returns 0, or -1 if the format is not valid (nothing is drawn)
+BREAKOUT_ENV_API int breakout_env_render(BreakoutEnv* env, unsigned int width, unsigned int height, unsigned int channels, unsigned char* pixels);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -5,49 +5,49 @@
 //  by slate2b
 //
 //  The BrickObject class represents the brick objects in the game.
-//  This class inherits from the GameObject class.
+//
+//  The brick data is stored in a BrickArchetype (one packed array per
+//  component, see archetype.h).  A BrickObject is a thin view holding
+//  references to one brick's components.
+//
+//  NOTE: A view is only valid until another brick is added to the archetype.
 // 
 ///////////////////////////////////////////////////////////////////////////
 
 #include "brick_object.h"
 
-BrickObject::BrickObject(unsigned int window_width, unsigned int window_height)
-	: GameObject(glm::vec2(0.0f, 0.0f), glm::vec2(1.0f, 1.0f), glm::vec3(1.0f, 1.0f, 1.0f), glm::vec2(0.0f, 0.0f))
+BrickObject::BrickObject(BrickArchetype& bricks, unsigned int index)
+	: Position(bricks.Get<Transform>(index).position),
+	  Size(bricks.Get<Transform>(index).size),
+	  Color(bricks.Get<Renderable>(index).color),
+	  isDestroyed(bricks.Get<Breakable>(index).isDestroyed),
+	  Collider(bricks.Get<BoxCollider>(index))
 {
-	// Setting initial size, position, and color in the InitBrick method
-	this->InitBrick(window_width, window_height);
-
 }
 
-BrickObject::BrickObject(glm::vec2 pos, glm::vec2 size, glm::vec3 color, glm::vec2 velocity, bool is_destroyed)
-	: GameObject(pos, size, color, velocity, is_destroyed)
+// Method to add a brick to the bricks archetype and return a view of it
+BrickObject BrickObject::Create(BrickArchetype& bricks, glm::vec2 pos, glm::vec2 size, glm::vec3 color, bool is_destroyed)
 {
-}
+	// Setting the brick's components
+	Transform transform;
+	transform.position = pos;
+	transform.size = size;
 
-BrickObject::~BrickObject()
-{
-	GameObject::~GameObject();
-}
+	// Calculating the box used in collision checks once, because bricks never move
+	BoxCollider collider;
+	collider.halfExtents = glm::vec2(size.x / 2.0f, size.y / 2.0f);
+	collider.center = glm::vec2(pos.x + collider.halfExtents.x, pos.y + collider.halfExtents.y);
 
-// Method to initizlize the brick object
-void BrickObject::InitBrick(unsigned int window_width, unsigned int window_height)
-{
-	// Setting the brick's initial color
-	glm::vec3 brickColor = glm::vec3(0.2f, 0.6f, 0.2f);
-	this->Color = brickColor;
+	// Fixed point copy of the box for the deterministic physics mode
+	FixedBoxCollider fixedCollider;
+	fixedCollider.halfExtents = FixedVec2::FromVec2(collider.halfExtents);
+	fixedCollider.center = FixedVec2::FromVec2(collider.center);
 
-	// Setting the brick's initial size based on window size
-	glm::vec2 brickSize = glm::vec2((window_width / 10.0f), window_height / 36.0f);
-	this->Size = brickSize;
+	Renderable renderable;
+	renderable.color = color;
 
-	// Setting the brick's initial position based on window size
-	glm::vec2 brickPos = glm::vec2((window_width / 2.0f) - (this->Size.x / 2.0f), 0.0f);
-	this->Position = brickPos;
-}
+	Breakable breakable;
+	breakable.isDestroyed = is_destroyed;
 
-// Method to draw the brick
-void BrickObject::DrawBrick(ShapeRenderer& shape_renderer, Shader& shader)
-{
-	// Calling the GameObject class's Draw method
-	this->DrawObject(shape_renderer, shader);
+	return bricks.Add(transform, collider, renderable, breakable, fixedCollider);
 }
@@ -5,33 +5,55 @@
 //  by slate2b
 //
 //  The BrickObject class represents the brick objects in the game.
-//  This class inherits from the GameObject class.
+//
+//  The brick data is stored in a BrickArchetype (one packed array per
+//  component, see archetype.h).  A BrickObject is a thin view holding
+//  references to one brick's components.
+//
+//  NOTE: A view is only valid until another brick is added to the archetype.
 // 
 ///////////////////////////////////////////////////////////////////////////
 
 #ifndef BRICKOBJECT_H
 #define BRICKOBJECT_H
 
-#include "game_object.h"
+#include <glm/glm.hpp>
+
+#include "archetype.h"
+#include "components.h"
+
+// Forward declarations for the renderer classes (only needed by the draw methods)
+class ShapeRenderer;
+class Shader;
+
+class BrickObject;
+
+// Archetype holding the components of every brick
+// NOTE: Bricks never move, so they have no Velocity component
+typedef Archetype<BrickObject, Transform, BoxCollider, Renderable, Breakable, FixedBoxCollider> BrickArchetype;
 
-class BrickObject : public GameObject
+class BrickObject
 {
 
 public:
 
-	// Constructor
-	BrickObject(unsigned int window_width, unsigned int window_height);
+	// References to the brick's components
+	glm::vec2& Position;
+	glm::vec2& Size;
+	glm::vec3& Color;
+	bool& isDestroyed;
 
-	// Full Constructor
-	BrickObject(glm::vec2 pos, glm::vec2 size, glm::vec3 color, glm::vec2 velocity, bool is_destroyed);
+	// Reference to the box used in collision checks (calculated from Position and Size when the brick is created)
+	BoxCollider& Collider;
 
-	// Destructor
-	~BrickObject();
+	// Constructor (view of the brick at index in the bricks archetype)
+	BrickObject(BrickArchetype& bricks, unsigned int index);
 
-	// Method to initialize brick object
-	void InitBrick(unsigned int window_width, unsigned int window_height);
+	// Method to add a brick to the bricks archetype and return a view of it
+	static BrickObject Create(BrickArchetype& bricks, glm::vec2 pos, glm::vec2 size, glm::vec3 color, bool is_destroyed);
 
 	// Method to draw the brick
+	// NOTE: Defined in game_render.cpp (renderer library)
 	void DrawBrick(ShapeRenderer& shape_renderer, Shader& shader);
 
 };
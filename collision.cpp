@@ -0,0 +1,211 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//  BREAKOUT REMIX 
+//  --------------
+//  by slate2b
+//
+//  The collision functions detect collisions between a ball object and
+//  a box-shaped game object (a brick or the player paddle), and between
+//  two ball objects.
+// 
+//  The collision functions are responsible for the following:
+// 
+//     * AABB - Circle collision detection
+//     * Circle - Circle collision detection
+//	   * Determining which side of the box the ball collided with
+//     * Fixed point versions of the above for the deterministic physics mode
+//
+///////////////////////////////////////////////////////////////////////////
+
+#include "collision.h"
+
+
+// Method to perform collision detection when a circle collides with a box: Returns Collosion object
+// aka: AABB - Circle collision
+// NOTE: Shared by the DetectCircleCollision methods below (inline so each of them is a single call)
+// -------------------------------------------------------------------------------------------------
+static inline Collision CircleBoxCollision(glm::vec2 center, float radius, glm::vec2 aabb_center, glm::vec2 aabb_half_extents)
+{
+    // ----------------------------------------------------------------------------------------
+    // Using the point of impact on the surface of the box-shaped object in order to 
+    // determine the new movement vector and direction the BallObject will travel after impact.
+    // The goal is to determine which surface of the box-shaped GameObject should exert the 
+    // influence over the ball's change in direction after impact.
+    // ----------------------------------------------------------------------------------------
+
+    // Calculate the vector between center of BallObject and the center of the box-shaped GameObject
+    //    This represents which part of the box-shaped game object the ball collided with
+    glm::vec2 impactPoint = center - aabb_center;
+    // Clamp the impact point vector
+    glm::vec2 clamped = glm::clamp(impactPoint, -aabb_half_extents, aabb_half_extents);
+    // Calculate the point of the box-shaped GameObject closest to the BallObject by adding the clamped impact point vector to the center
+    glm::vec2 closest = aabb_center + clamped;
+    // Calculate the final point of impact by calculating the difference between
+    //    the center of the BallObject and the closest point on the box-shaped GameObject
+    impactPoint = closest - center;
+
+    // If the length of the impact vector is less than the radius of the BallObject...
+    if (glm::length(impactPoint) < radius)
+    {
+        // Return collision true, call the VectorDirection method to calculate Direction then return it, and also return the difference vector
+        return std::make_tuple(true, VectorDirection(impactPoint), impactPoint);
+    }
+    // If the length of the difference vector is equal to or more than the radius of the BallObject...
+    else
+        // Return collision false, Direction UP, and difference vector of zero
+        return std::make_tuple(false, UP, glm::vec2(0.0f, 0.0f));
+}
+
+
+// Method to perform collision detection between a ball and a box collider (e.g. a brick's)
+// -----------------------------------------------------------------------------------------
+Collision DetectCircleCollision(const glm::vec2& ball_position, const CircleCollider& one, const BoxCollider& two)
+{
+    // The center point of the circle shape (BallObject), and the box which was calculated when the brick was created
+    return CircleBoxCollision(ball_position + one.radius, one.radius, two.center, two.halfExtents);
+}
+
+
+// Method to perform collision detection between a ball and a box-shaped object (the player paddle)
+// ------------------------------------------------------------------------------------------------
+Collision DetectCircleCollision(const BallObject& one, const GameObject& two)
+{
+    // Calculate values for the box shape (Player Paddle)
+    glm::vec2 aabb_half_extents(two.Size.x / 2.0f, two.Size.y / 2.0f);
+    glm::vec2 aabb_center(two.Position.x + aabb_half_extents.x, two.Position.y + aabb_half_extents.y);
+
+    return CircleBoxCollision(one.Position + one.Radius, one.Radius, aabb_center, aabb_half_extents);
+}
+
+
+// Method to perform collision detection between two balls
+// --------------------------------------------------------
+bool DetectBallCollision(const glm::vec2& one_position, const CircleCollider& one, const glm::vec2& two_position, const CircleCollider& two, glm::vec2& difference_out)
+{
+    // Vector between the centers of the two balls
+    glm::vec2 difference = (two_position + two.radius) - (one_position + one.radius);
+    float distanceSquared = glm::dot(difference, difference);
+    float minDistance = one.radius + two.radius;
+
+    // The balls collide if their centers are closer than the sum of their radii
+    // NOTE: Balls with exactly the same center are skipped, because there is no direction to push them apart
+    if (distanceSquared >= minDistance * minDistance || distanceSquared == 0.0f)
+        return false;
+
+    difference_out = difference;
+    return true;
+}
+
+
+// Method to calculate a compass direction based on the point of impact
+//    The goal is to determine which surface of the box-shaped GameObject should exert the primary
+//    influence over the ball's change in direction after impact
+// -----------------------------------------------------------------------------------------------
+Direction VectorDirection(glm::vec2 impact_point)
+{
+    // Creating vec2s for the four compass directions
+    glm::vec2 compass[] = {
+        glm::vec2(0.0f, 1.0f),	// Up
+        glm::vec2(1.0f, 0.0f),	// Right
+        glm::vec2(0.0f, -1.0f),	// Down
+        glm::vec2(-1.0f, 0.0f)	// Left
+    };
+
+    // Variables used in calculations below to identify the compass direction which most closely matches the impact point vector
+    // -------------------------------------------------------------------------------------------------------------------------
+    // Variable to store the highest dot product so far. Initializing to zero.
+    float highestValue = 0.0f;
+    // Variable to store the compass direction which most closely matches the impact point. Initializing to -1.
+    unsigned int bestMatch = -1;
+
+    // Loop through the four compass directions
+    for (unsigned int i = 0; i < 4; i++)
+    {
+        // Normalize the impact point vector argument, then calculate the dot product between the normalized vector and the compass direction
+        float dotProduct = glm::dot(glm::normalize(impact_point), compass[i]);
+
+        // If the dot product is greater than the highest value calculated so far...
+        if (dotProduct > highestValue)
+        {
+            // Assign the value of highestValue with the dot product calculated through this iteration of the loop
+            highestValue = dotProduct;
+            // Assign the value of bestMatch with the compass direction from this iteration of the loop
+            bestMatch = i;
+        }
+    }
+
+    // After comparing all the compass directions to the impact point vector, return the closest compass direction
+    return (Direction)bestMatch;
+}
+
+
+// Method to perform fixed point AABB - Circle collision detection between a ball and a fixed point box collider
+// NOTE: The same steps as CircleBoxCollision, but the distance is compared squared, so no square root is needed
+// -------------------------------------------------------------------------------------------------------------
+FixedCollision DetectFixedCircleCollision(const FixedVec2& ball_position, Fixed radius, const FixedBoxCollider& box)
+{
+    // The center point of the circle shape (BallObject)
+    FixedVec2 center(ball_position.x + radius, ball_position.y + radius);
+
+    // Clamp the vector from the center of the box to the center of the ball to the box,
+    //    which gives the point of the box closest to the ball
+    FixedVec2 impactPoint = center - box.center;
+    FixedVec2 clamped(FixedClamp(impactPoint.x, -box.halfExtents.x, box.halfExtents.x), FixedClamp(impactPoint.y, -box.halfExtents.y, box.halfExtents.y));
+    FixedVec2 closest = box.center + clamped;
+
+    // Calculate the final point of impact (from the center of the ball to the closest point)
+    impactPoint = closest - center;
+
+    // If the closest point is inside the ball...
+    if (FixedLengthSquared(impactPoint) < FixedSquared(radius))
+        return std::make_tuple(true, FixedVectorDirection(impactPoint), impactPoint);
+    else
+        return std::make_tuple(false, UP, FixedVec2());
+}
+
+
+// Method to perform fixed point Circle - Circle collision detection between two balls
+// -----------------------------------------------------------------------------------
+bool DetectFixedBallCollision(const FixedVec2& one_position, Fixed one_radius, const FixedVec2& two_position, Fixed two_radius, FixedVec2& difference_out)
+{
+    // Vector between the centers of the two balls
+    FixedVec2 oneCenter(one_position.x + one_radius, one_position.y + one_radius);
+    FixedVec2 twoCenter(two_position.x + two_radius, two_position.y + two_radius);
+    FixedVec2 difference = twoCenter - oneCenter;
+    uint64_t distanceSquared = FixedLengthSquared(difference);
+
+    // The balls collide if their centers are closer than the sum of their radii
+    // NOTE: Balls with exactly the same center are skipped, because there is no direction to push them apart
+    if (distanceSquared >= FixedSquared(one_radius + two_radius) || distanceSquared == 0)
+        return false;
+
+    difference_out = difference;
+    return true;
+}
+
+
+// Method to calculate the compass direction which most closely matches a fixed point impact vector
+// NOTE: Normalizing the vector does not change which compass direction gives the highest dot product,
+//       so the components are compared directly (in the same order as VectorDirection, so ties match).
+//       A zero vector (the ball's center inside the box) is treated as DOWN, which is how the float
+//       collision response ends up handling VectorDirection's result for a zero vector.
+// ------------------------------------------------------------------------------------------------------
+Direction FixedVectorDirection(const FixedVec2& impact_point)
+{
+    // Dot products with the compass directions: Up (0, 1), Right (1, 0), Down (0, -1) and Left (-1, 0)
+    Fixed dotProducts[] = { impact_point.y, impact_point.x, -impact_point.y, -impact_point.x };
+
+    Fixed highestValue;
+    Direction bestMatch = DOWN;
+
+    for (unsigned int i = 0; i < 4; i++)
+    {
+        if (dotProducts[i] > highestValue)
+        {
+            highestValue = dotProducts[i];
+            bestMatch = (Direction)i;
+        }
+    }
+
+    return bestMatch;
+}
\ No newline at end of file
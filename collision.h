@@ -0,0 +1,73 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//  BREAKOUT REMIX 
+//  --------------
+//  by slate2b
+//
+//  The collision functions detect collisions between a ball object and
+//  a box-shaped game object (a brick or the player paddle), and between
+//  two ball objects.
+// 
+//  The collision functions are responsible for the following:
+// 
+//     * AABB - Circle collision detection
+//     * Circle - Circle collision detection
+//	   * Determining which side of the box the ball collided with
+//     * Fixed point versions of the above for the deterministic physics mode
+//
+///////////////////////////////////////////////////////////////////////////
+
+#ifndef COLLISION_H
+#define COLLISION_H
+
+#include <tuple>
+
+#include <glm/glm.hpp>
+
+#include "components.h"
+#include "game_object.h"
+#include "ball_object.h"
+
+// enum used for directions in collision detection
+enum Direction {
+	UP,
+	RIGHT,
+	DOWN,
+	LEFT
+};
+
+// typedef used to hold collision information
+// ------------------------------------------
+//   bool: whether or not a collision
+//   Direction: collision direction
+//   vec2: difference between the center and closest point of impact
+//   ---------------------------------------------------------------
+typedef std::tuple<bool, Direction, glm::vec2> Collision; // <collision?, what direction?, difference vector center - closest point>
+
+// Method to perform AABB - Circle collision detection between a ball (top left position and collider) and a box collider (e.g. a brick's)
+Collision DetectCircleCollision(const glm::vec2& ball_position, const CircleCollider& one, const BoxCollider& two);
+
+// Method to perform AABB - Circle collision detection between a ball and a box-shaped object (the player paddle)
+Collision DetectCircleCollision(const BallObject& one, const GameObject& two);
+
+// Method to perform Circle - Circle collision detection between two balls (top left positions and colliders)
+// NOTE: On a collision, difference_out is the vector from the center of ball one to the center of ball two
+bool DetectBallCollision(const glm::vec2& one_position, const CircleCollider& one, const glm::vec2& two_position, const CircleCollider& two, glm::vec2& difference_out);
+
+// Method to calculate the compass direction which most closely matches the point of impact
+Direction VectorDirection(glm::vec2 impact_point);
+
+// typedef used to hold fixed point collision information (same layout as Collision)
+typedef std::tuple<bool, Direction, FixedVec2> FixedCollision;
+
+// Method to perform fixed point AABB - Circle collision detection between a ball (top left position and radius) and a fixed point box collider
+FixedCollision DetectFixedCircleCollision(const FixedVec2& ball_position, Fixed radius, const FixedBoxCollider& box);
+
+// Method to perform fixed point Circle - Circle collision detection between two balls (top left positions and radii)
+// NOTE: On a collision, difference_out is the vector from the center of ball one to the center of ball two
+bool DetectFixedBallCollision(const FixedVec2& one_position, Fixed one_radius, const FixedVec2& two_position, Fixed two_radius, FixedVec2& difference_out);
+
+// Method to calculate the compass direction which most closely matches a fixed point impact vector
+Direction FixedVectorDirection(const FixedVec2& impact_point);
+
+#endif
@@ -0,0 +1,98 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//  BREAKOUT REMIX
+//  --------------
+//  by slate2b
+//
+//  Components hold the data for the entities (balls and bricks) in the
+//  game.  Each kind of entity only has the components it needs, and each
+//  component is stored in its own packed array (see archetype.h):
+//
+//     * Transform:        Position and size
+//     * Velocity:         Movement per second (balls only, bricks never move)
+//     * BoxCollider:      Center and half extents used by collision checks
+//     * CircleCollider:   Radius used by collision checks
+//     * Renderable:       Color used to draw the entity
+//     * Breakable:        Whether a brick has been destroyed
+//     * BallState:        Whether a ball is in play, held or destroyed
+//     * FixedBody:        Fixed point position and velocity (balls, used by
+//                         the deterministic physics mode)
+//     * FixedBoxCollider: Fixed point copy of the BoxCollider (bricks)
+//
+///////////////////////////////////////////////////////////////////////////
+
+#ifndef COMPONENTS_H
+#define COMPONENTS_H
+
+#include <glm/glm.hpp>
+
+#include "fixed_point.h"
+
+// Position and size of an entity
+struct Transform
+{
+	glm::vec2 position = glm::vec2(0.0f, 0.0f);
+	glm::vec2 size = glm::vec2(1.0f, 1.0f);
+};
+
+// Movement per second of an entity
+struct Velocity
+{
+	glm::vec2 velocity = glm::vec2(0.0f, 0.0f);
+};
+
+// Box shape used in collision checks
+// NOTE: Calculated once from the Transform, because bricks never move
+struct BoxCollider
+{
+	glm::vec2 center = glm::vec2(0.5f, 0.5f);
+	glm::vec2 halfExtents = glm::vec2(0.5f, 0.5f);
+};
+
+// Circle shape used in collision checks
+struct CircleCollider
+{
+	float radius = 0.5f;
+};
+
+// Color used to draw an entity
+struct Renderable
+{
+	glm::vec3 color = glm::vec3(1.0f, 1.0f, 1.0f);
+};
+
+// Whether a breakable entity (brick) has been destroyed
+struct Breakable
+{
+	bool isDestroyed = false;
+};
+
+// State flags for a ball
+struct BallState
+{
+	bool isHeld = false;
+	bool isInPlay = false;
+	bool isDestroyed = false;
+};
+
+// Fixed point position, velocity and radius of a ball (see Game::UpdateBallsFixed)
+// NOTE: Only kept up to date while the deterministic physics mode is on.  isMoving records
+//       whether the ball was moving at the end of the last fixed point step, so a ball which
+//       has just been released is picked up from its Transform and Velocity again.
+struct FixedBody
+{
+	FixedVec2 position;
+	FixedVec2 velocity;
+	Fixed radius;
+	bool isMoving = false;
+};
+
+// Fixed point box shape used in collision checks by the deterministic physics mode
+// NOTE: Converted once from the BoxCollider when the brick is created
+struct FixedBoxCollider
+{
+	FixedVec2 center;
+	FixedVec2 halfExtents;
+};
+
+#endif
@@ -0,0 +1,330 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//  BREAKOUT REMIX
+//  --------------
+//  by slate2b
+//
+//  The EnvBatch class holds a batch of game environments for training
+//  agents, and implements the C API in breakout_env.h.
+//
+//  The EnvBatch class is responsible for the following:
+//
+//     * Creating the environments and the worker threads
+//     * Resetting and stepping every environment in parallel
+//     * Writing the observations, rewards and episode ends
+//     * Drawing the pixel observations of every environment
+//
+///////////////////////////////////////////////////////////////////////////
+
+#include "env_batch.h"
+
+#include <algorithm>
+#include <exception>
+#include <iostream>
+#include <thread>
+
+// Size of the simulated screen (matches Source.cpp)
+const unsigned int ENV_SCREEN_WIDTH = 800;
+const unsigned int ENV_SCREEN_HEIGHT = 600;
+
+// Fixed time step of every environment step (60 steps per second of game time)
+const float ENV_FRAME_DT = 1.0f / 60.0f;
+
+
+EnvBatch::EnvBatch(unsigned int num_envs, unsigned int num_threads, unsigned int max_episode_steps)
+{
+    // Number of tasks handed to each thread per step (a few, so threads which finish early can help the others)
+    const unsigned int TASKS_PER_THREAD = 4;
+
+    this->maxEpisodeSteps = max_episode_steps;
+
+    // Create the games (each one loads the level pack, so every episode can start from the same snapshot)
+    // NOTE: The games build their levels on the calling thread, so thousands of environments do not start a loader thread each
+    this->environments.resize(num_envs);
+
+    for (Environment& environment : this->environments)
+    {
+        environment.game.reset(new Game(ENV_SCREEN_WIDTH, ENV_SCREEN_HEIGHT));
+        environment.game->levelPack.SetBackgroundLoading(false);
+        environment.game->InitSimulation();
+        environment.episodeSteps = 0;
+    }
+
+    if (num_envs > 0)
+        this->startSnapshot.Save(*this->environments[0].game);
+
+    // Start the worker threads
+    if (num_threads == 0)
+        num_threads = std::max(std::thread::hardware_concurrency(), 1u);
+
+    this->workers.SetThreadCount(num_threads);
+
+    unsigned int numTasks = this->workers.GetThreadCount() * TASKS_PER_THREAD;
+    this->envsPerTask = std::max((num_envs + numTasks - 1) / numTasks, 1u);
+}
+
+
+// Method to return the number of environments
+// -------------------------------------------
+unsigned int EnvBatch::GetCount() const
+{
+    return static_cast<unsigned int>(this->environments.size());
+}
+
+
+// Method to return whether every environment has bricks to break
+// ---------------------------------------------------------------
+bool EnvBatch::HasLiveBricks() const
+{
+    for (const Environment& environment : this->environments)
+    {
+        if (environment.game->activeLevel.liveBricks == 0)
+            return false;
+    }
+
+    return true;
+}
+
+
+// Method to start a new episode in every environment and write the first observations
+// ------------------------------------------------------------------------------------
+void EnvBatch::Reset(uint64_t seed, float* observations)
+{
+    unsigned int numEnvs = this->GetCount();
+    unsigned int numTasks = (numEnvs + this->envsPerTask - 1) / this->envsPerTask;
+
+    this->workers.Run(numTasks, [this, seed, observations, numEnvs](unsigned int task_index, unsigned int /* worker_index */) {
+        unsigned int first = task_index * this->envsPerTask;
+        unsigned int last = std::min(first + this->envsPerTask, numEnvs);
+
+        for (unsigned int i = first; i < last; ++i)
+        {
+            Environment& environment = this->environments[i];
+
+            // Give every environment its own sequence of episodes
+            std::seed_seq seedSequence{ static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32), i };
+            environment.random.seed(seedSequence);
+
+            this->ResetEnvironment(environment);
+            WriteObservation(*environment.game, observations + static_cast<size_t>(i) * BREAKOUT_ENV_OBSERVATION_SIZE);
+        }
+    });
+}
+
+
+// Method to step every environment with its action and write the observations, rewards and dones
+// ----------------------------------------------------------------------------------------------
+void EnvBatch::Step(const int* actions, float* observations, float* rewards, unsigned char* dones)
+{
+    unsigned int numEnvs = this->GetCount();
+    unsigned int numTasks = (numEnvs + this->envsPerTask - 1) / this->envsPerTask;
+
+    this->workers.Run(numTasks, [this, actions, observations, rewards, dones, numEnvs](unsigned int task_index, unsigned int /* worker_index */) {
+        unsigned int first = task_index * this->envsPerTask;
+        unsigned int last = std::min(first + this->envsPerTask, numEnvs);
+
+        for (unsigned int i = first; i < last; ++i)
+        {
+            Environment& environment = this->environments[i];
+
+            bool isDone = false;
+            rewards[i] = this->StepEnvironment(environment, actions[i], isDone);
+            dones[i] = isDone ? 1 : 0;
+
+            WriteObservation(*environment.game, observations + static_cast<size_t>(i) * BREAKOUT_ENV_OBSERVATION_SIZE);
+        }
+    });
+}
+
+
+// Method to draw every environment into pixels (one picture after another)
+// -----------------------------------------------------------------------
+bool EnvBatch::Render(unsigned int width, unsigned int height, unsigned int channels, unsigned char* pixels)
+{
+    if (!this->frameEncoder.SetFormat(width, height, channels))
+        return false;
+
+    unsigned int numEnvs = this->GetCount();
+    unsigned int numTasks = (numEnvs + this->envsPerTask - 1) / this->envsPerTask;
+    size_t frameBytes = this->frameEncoder.GetFrameBytes();
+
+    this->workers.Run(numTasks, [this, pixels, frameBytes, numEnvs](unsigned int task_index, unsigned int /* worker_index */) {
+        unsigned int first = task_index * this->envsPerTask;
+        unsigned int last = std::min(first + this->envsPerTask, numEnvs);
+
+        for (unsigned int i = first; i < last; ++i)
+        {
+            this->frameEncoder.Encode(*this->environments[i].game, pixels + i * frameBytes);
+        }
+    });
+
+    return true;
+}
+
+
+// Method to write the observation of a game (see breakout_env.h for the layout)
+// -----------------------------------------------------------------------------
+void EnvBatch::WriteObservation(const Game& game, float* observation)
+{
+    // Velocities are divided by this speed (pixels per second), so they fall roughly within [-1, 1]
+    const float SPEED_SCALE = 1.0f / 500.0f;
+
+    float invWidth = 1.0f / game.windowWidth;
+    float invHeight = 1.0f / game.windowHeight;
+
+    unsigned int numBricks = game.activeLevel.bricks.Size();
+
+    observation[0] = (game.player.Position.x + 0.5f * game.player.Size.x) * invWidth;
+    observation[1] = (numBricks > 0) ? static_cast<float>(game.activeLevel.liveBricks) / numBricks : 0.0f;
+    observation[2] = (game.ballInPlayTimer >= 240) ? 1.0f : 0.0f;
+
+    // Read the ball columns directly (one pass over each packed array)
+    const std::vector<Transform>& transforms = game.ballObjects.Column<Transform>();
+    const std::vector<Velocity>& velocities = game.ballObjects.Column<Velocity>();
+    const std::vector<BallState>& ballStates = game.ballObjects.Column<BallState>();
+
+    unsigned int numBalls = std::min(game.ballObjects.Size(), static_cast<unsigned int>(BREAKOUT_ENV_MAX_BALLS));
+    float* ballRow = observation + 3;
+
+    for (unsigned int i = 0; i < numBalls; ++i, ballRow += 6)
+    {
+        glm::vec2 center = transforms[i].position + 0.5f * transforms[i].size;
+
+        ballRow[0] = center.x * invWidth;
+        ballRow[1] = center.y * invHeight;
+        ballRow[2] = velocities[i].velocity.x * SPEED_SCALE;
+        ballRow[3] = velocities[i].velocity.y * SPEED_SCALE;
+        ballRow[4] = (ballStates[i].isInPlay && !ballStates[i].isDestroyed) ? 1.0f : 0.0f;
+        ballRow[5] = ballStates[i].isHeld ? 1.0f : 0.0f;
+    }
+
+    // Rows for missing balls are zero
+    std::fill(ballRow, observation + BREAKOUT_ENV_OBSERVATION_SIZE, 0.0f);
+}
+
+
+// Method to start a new episode in one environment
+// ------------------------------------------------
+void EnvBatch::ResetEnvironment(Environment& environment)
+{
+    Game& game = *environment.game;
+
+    this->startSnapshot.Restore(game);
+
+    // Put the paddle (and the balls waiting on it) somewhere random along the bottom
+    std::uniform_real_distribution<float> paddleX(0.0f, game.windowWidth - game.player.Size.x);
+    game.player.Position.x = paddleX(environment.random);
+
+    for (BallObject ball_object : game.ballObjects)
+    {
+        ball_object.InitBall(game.windowWidth, game.windowHeight, game.player);
+    }
+
+    environment.episodeSteps = 0;
+}
+
+
+// Method to step one environment and return its reward (sets is_done when the episode ended)
+// ------------------------------------------------------------------------------------------
+float EnvBatch::StepEnvironment(Environment& environment, int action, bool& is_done)
+{
+    Game& game = *environment.game;
+
+    game.keys[KEY_A] = (action == BREAKOUT_ACTION_LEFT || action == BREAKOUT_ACTION_LEFT_FIRE);
+    game.keys[KEY_D] = (action == BREAKOUT_ACTION_RIGHT || action == BREAKOUT_ACTION_RIGHT_FIRE);
+    game.keys[KEY_SPACE] = (action == BREAKOUT_ACTION_FIRE || action == BREAKOUT_ACTION_LEFT_FIRE || action == BREAKOUT_ACTION_RIGHT_FIRE);
+
+    unsigned int scoreBefore = game.score;
+    unsigned int resetsBefore = game.levelResets;
+
+    game.ProcessInput(ENV_FRAME_DT);
+    game.UpdateGame(ENV_FRAME_DT);
+
+    environment.episodeSteps += 1;
+
+    // The episode ends when every ball is lost (the game starts the level again and zeroes the score)
+    bool isGameOver = (game.levelResets != resetsBefore);
+    float reward = (!isGameOver && game.score > scoreBefore) ? static_cast<float>(game.score - scoreBefore) : 0.0f;
+
+    is_done = isGameOver || (this->maxEpisodeSteps > 0 && environment.episodeSteps >= this->maxEpisodeSteps);
+
+    if (is_done)
+        this->ResetEnvironment(environment);
+
+    return reward;
+}
+
+
+/////////////////////////
+//
+// C API (breakout_env.h)
+//
+/////////////////////////
+
+struct BreakoutEnv
+{
+    EnvBatch batch;
+
+    BreakoutEnv(unsigned int num_envs, unsigned int num_threads, unsigned int max_episode_steps)
+        : batch(num_envs, num_threads, max_episode_steps)
+    {
+    }
+};
+
+
+BreakoutEnv* breakout_env_create(unsigned int num_envs, unsigned int num_threads, unsigned int max_episode_steps)
+{
+    if (num_envs == 0)
+    {
+        std::cout << "Error: breakout_env_create needs at least one environment" << std::endl;
+        return nullptr;
+    }
+
+    // No exception may cross the C API, so running out of memory (or threads) is reported as NULL
+    BreakoutEnv* env = nullptr;
+
+    try
+    {
+        env = new BreakoutEnv(num_envs, num_threads, max_episode_steps);
+    }
+    catch (const std::exception& exception)
+    {
+        std::cout << "Error: breakout_env_create could not create the environments (" << exception.what() << ")" << std::endl;
+        return nullptr;
+    }
+
+    // Without a level to play (e.g. the level files are missing), every episode would have nothing to hit
+    if (!env->batch.HasLiveBricks())
+    {
+        std::cout << "Error: breakout_env_create could not load a level with bricks to break" << std::endl;
+        delete env;
+        return nullptr;
+    }
+
+    return env;
+}
+
+void breakout_env_destroy(BreakoutEnv* env)
+{
+    delete env;
+}
+
+unsigned int breakout_env_count(const BreakoutEnv* env)
+{
+    return env->batch.GetCount();
+}
+
+void breakout_env_reset(BreakoutEnv* env, uint64_t seed, float* observations)
+{
+    env->batch.Reset(seed, observations);
+}
+
+void breakout_env_step(BreakoutEnv* env, const int* actions, float* observations, float* rewards, unsigned char* dones)
+{
+    env->batch.Step(actions, observations, rewards, dones);
+}
+
+int breakout_env_render(BreakoutEnv* env, unsigned int width, unsigned int height, unsigned int channels, unsigned char* pixels)
+{
+    return env->batch.Render(width, height, channels, pixels) ? 0 : -1;
+}
@@ -0,0 +1,99 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//  BREAKOUT REMIX
+//  --------------
+//  by slate2b
+//
+//  The EnvBatch class holds a batch of game environments for training
+//  agents, and implements the C API in breakout_env.h.
+//
+//  Each environment is a headless Game.  Stepping the batch splits the
+//  environments into chunks which the worker threads step in parallel;
+//  every environment writes only its own rows of the caller's buffers,
+//  so the threads never share data.
+//
+//  Every episode starts by restoring one snapshot of the freshly
+//  initialized game (so no level file is read), then moving the paddle
+//  to a random place drawn from the environment's random engine.
+//
+//  The EnvBatch class is responsible for the following:
+//
+//     * Creating the environments and the worker threads
+//     * Resetting and stepping every environment in parallel
+//     * Writing the observations, rewards and episode ends
+//     * Drawing the pixel observations of every environment
+//
+///////////////////////////////////////////////////////////////////////////
+
+#ifndef ENVBATCH_H
+#define ENVBATCH_H
+
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "breakout_env.h"
+#include "frame_encoder.h"
+#include "game.h"
+#include "game_snapshot.h"
+#include "worker_pool.h"
+
+class EnvBatch
+{
+
+public:
+
+	// Constructor (creates num_envs environments, stepped by num_threads threads, 0 = one per core)
+	EnvBatch(unsigned int num_envs, unsigned int num_threads, unsigned int max_episode_steps);
+
+	// Method to return the number of environments
+	unsigned int GetCount() const;
+
+	// Method to return whether every environment has bricks to break (false if no level could be loaded)
+	bool HasLiveBricks() const;
+
+	// Method to start a new episode in every environment and write the first observations
+	void Reset(uint64_t seed, float* observations);
+
+	// Method to step every environment with its action and write the observations, rewards and dones
+	void Step(const int* actions, float* observations, float* rewards, unsigned char* dones);
+
+	// Method to draw every environment into pixels (one picture after another), returns false if the format is not valid
+	bool Render(unsigned int width, unsigned int height, unsigned int channels, unsigned char* pixels);
+
+	// Method to write the observation of a game (BREAKOUT_ENV_OBSERVATION_SIZE floats)
+	static void WriteObservation(const Game& game, float* observation);
+
+private:
+
+	// Struct to hold one environment
+	struct Environment
+	{
+		std::unique_ptr<Game> game;
+		std::mt19937_64 random;
+		unsigned int episodeSteps;
+	};
+
+	std::vector<Environment> environments;
+
+	// State of a freshly initialized game (every episode starts from it)
+	GameSnapshot startSnapshot;
+
+	// Worker threads, and the number of environments stepped by each task
+	WorkerPool workers;
+	unsigned int envsPerTask;
+
+	// Steps after which an episode ends (0 = no limit)
+	unsigned int maxEpisodeSteps;
+
+	// Encoder for pixel observations
+	FrameEncoder frameEncoder;
+
+	// Method to start a new episode in one environment
+	void ResetEnvironment(Environment& environment);
+
+	// Method to step one environment and return its reward (sets is_done when the episode ended)
+	float StepEnvironment(Environment& environment, int action, bool& is_done);
+};
+
+#endif
@@ -0,0 +1,176 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//  BREAKOUT REMIX
+//  --------------
+//  by slate2b
+//
+//  Fixed point numbers used by the deterministic physics mode.
+//
+//  A Fixed holds a Q16.16 number: a 32-bit integer counting 1/65536ths,
+//  which gives 16 integer bits (-32768 to 32767) and 16 fraction bits.
+//  Every operation is integer math, so the results are exactly the same
+//  for any compiler, compiler flags and CPU, unlike float math (where
+//  e.g. fused multiply-add or a different square root can change the last
+//  bit, and the difference grows from frame to frame).
+//
+//  Products and quotients are calculated with 64-bit intermediates, and
+//  squared lengths are returned as 64-bit Q32.32 values so squared
+//  distances across the whole window cannot overflow.
+//
+//  Floats are only used to convert to and from the rest of the game
+//  (e.g. for drawing), never inside the fixed point calculations.
+//
+///////////////////////////////////////////////////////////////////////////
+
+#ifndef FIXEDPOINT_H
+#define FIXEDPOINT_H
+
+#include <cmath>
+#include <cstdint>
+
+#include <glm/glm.hpp>
+
+// Q16.16 fixed point number
+struct Fixed
+{
+	// Number of fraction bits, and the raw value of 1.0
+	static const int FRACTION_BITS = 16;
+	static const int32_t ONE = 1 << FRACTION_BITS;
+
+	int32_t raw = 0;
+
+	// Methods to create a fixed point number from a raw value, an integer or a float (rounded to the nearest 1/65536th)
+	static Fixed FromRaw(int32_t raw_value) { Fixed f; f.raw = raw_value; return f; }
+	static Fixed FromInt(int value) { return FromRaw(static_cast<int32_t>(value * ONE)); }
+	static Fixed FromFloat(float value) { return FromRaw(static_cast<int32_t>(std::lround(value * static_cast<float>(ONE)))); }
+
+	// Method to convert the fixed point number to a float (only used outside the fixed point calculations)
+	float ToFloat() const { return static_cast<float>(raw) / static_cast<float>(ONE); }
+
+	Fixed operator-() const { return FromRaw(-raw); }
+	Fixed operator+(Fixed other) const { return FromRaw(raw + other.raw); }
+	Fixed operator-(Fixed other) const { return FromRaw(raw - other.raw); }
+
+	// NOTE: Rounds toward negative infinity (arithmetic shift)
+	Fixed operator*(Fixed other) const { return FromRaw(static_cast<int32_t>((static_cast<int64_t>(raw) * other.raw) >> FRACTION_BITS)); }
+
+	// NOTE: Rounds toward zero
+	Fixed operator/(Fixed other) const { return FromRaw(static_cast<int32_t>((static_cast<int64_t>(raw) * ONE) / other.raw)); }
+
+	Fixed& operator+=(Fixed other) { raw += other.raw; return *this; }
+	Fixed& operator-=(Fixed other) { raw -= other.raw; return *this; }
+
+	bool operator==(Fixed other) const { return raw == other.raw; }
+	bool operator!=(Fixed other) const { return raw != other.raw; }
+	bool operator<(Fixed other) const { return raw < other.raw; }
+	bool operator<=(Fixed other) const { return raw <= other.raw; }
+	bool operator>(Fixed other) const { return raw > other.raw; }
+	bool operator>=(Fixed other) const { return raw >= other.raw; }
+};
+
+// Two component vector of fixed point numbers
+struct FixedVec2
+{
+	Fixed x;
+	Fixed y;
+
+	FixedVec2() {}
+	FixedVec2(Fixed x_value, Fixed y_value) : x(x_value), y(y_value) {}
+
+	// Methods to convert to and from a glm::vec2
+	static FixedVec2 FromVec2(const glm::vec2& v) { return FixedVec2(Fixed::FromFloat(v.x), Fixed::FromFloat(v.y)); }
+	glm::vec2 ToVec2() const { return glm::vec2(x.ToFloat(), y.ToFloat()); }
+
+	FixedVec2 operator+(const FixedVec2& other) const { return FixedVec2(x + other.x, y + other.y); }
+	FixedVec2 operator-(const FixedVec2& other) const { return FixedVec2(x - other.x, y - other.y); }
+	FixedVec2 operator*(Fixed scale) const { return FixedVec2(x * scale, y * scale); }
+
+	FixedVec2& operator+=(const FixedVec2& other) { x += other.x; y += other.y; return *this; }
+	FixedVec2& operator-=(const FixedVec2& other) { x -= other.x; y -= other.y; return *this; }
+};
+
+
+// Method to return the absolute value of a fixed point number
+inline Fixed FixedAbs(Fixed value)
+{
+	return (value.raw < 0) ? -value : value;
+}
+
+// Method to clamp a fixed point number between min_value and max_value
+inline Fixed FixedClamp(Fixed value, Fixed min_value, Fixed max_value)
+{
+	return (value < min_value) ? min_value : ((value > max_value) ? max_value : value);
+}
+
+// Method to return the dot product of two vectors
+inline Fixed FixedDot(const FixedVec2& a, const FixedVec2& b)
+{
+	return a.x * b.x + a.y * b.y;
+}
+
+// Method to return the squared length of a vector as a raw Q32.32 value (cannot overflow)
+inline uint64_t FixedLengthSquared(const FixedVec2& v)
+{
+	int64_t x = v.x.raw;
+	int64_t y = v.y.raw;
+	return static_cast<uint64_t>(x * x) + static_cast<uint64_t>(y * y);
+}
+
+// Method to return the squared value of a fixed point number as a raw Q32.32 value (compare with FixedLengthSquared)
+inline uint64_t FixedSquared(Fixed value)
+{
+	int64_t v = value.raw;
+	return static_cast<uint64_t>(v * v);
+}
+
+// Method to return the integer square root (rounded down) of a 64-bit value
+// NOTE: Bit by bit, so no float square root is needed
+inline uint64_t IntegerSqrt(uint64_t value)
+{
+	uint64_t result = 0;
+	uint64_t bit = static_cast<uint64_t>(1) << 62;
+
+	// Start with the highest power of four which is not above the value
+	while (bit > value)
+		bit >>= 2;
+
+	while (bit != 0)
+	{
+		if (value >= result + bit)
+		{
+			value -= result + bit;
+			result = (result >> 1) + bit;
+		}
+		else
+		{
+			result >>= 1;
+		}
+
+		bit >>= 2;
+	}
+
+	return result;
+}
+
+// Method to return the length of a vector
+// NOTE: The square root of a Q32.32 squared length is the Q16.16 length
+inline Fixed FixedLength(const FixedVec2& v)
+{
+	return Fixed::FromRaw(static_cast<int32_t>(IntegerSqrt(FixedLengthSquared(v))));
+}
+
+// Method to scale a vector so its length becomes new_length (a zero vector is returned unchanged)
+// NOTE: Multiplies before dividing in 64 bits, so no precision is lost to a normalized intermediate
+inline FixedVec2 FixedScaleToLength(const FixedVec2& v, Fixed new_length)
+{
+	Fixed length = FixedLength(v);
+
+	if (length.raw == 0)
+		return v;
+
+	return FixedVec2(
+		Fixed::FromRaw(static_cast<int32_t>((static_cast<int64_t>(v.x.raw) * new_length.raw) / length.raw)),
+		Fixed::FromRaw(static_cast<int32_t>((static_cast<int64_t>(v.y.raw) * new_length.raw) / length.raw)));
+}
+
+#endif
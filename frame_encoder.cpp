@@ -0,0 +1,179 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//  BREAKOUT REMIX
+//  --------------
+//  by slate2b
+//
+//  The FrameEncoder class draws a small picture of the game on the CPU,
+//  for agents which learn from pixels.
+//
+//  The FrameEncoder class is responsible for the following:
+//
+//     * Checking the picture format (width, height and channels)
+//     * Drawing the bricks, paddle and balls into a pixel buffer
+//
+///////////////////////////////////////////////////////////////////////////
+
+#include "frame_encoder.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+
+// Method to turn a color channel in [0, 1] into a byte
+// ----------------------------------------------------
+static unsigned char ColorByte(float value)
+{
+    return static_cast<unsigned char>(std::min(std::max(value, 0.0f), 1.0f) * 255.0f + 0.5f);
+}
+
+// Method to turn a scaled rectangle edge into the nearest pixel edge in [0, limit]
+// NOTE: Clamped before rounding, so adding a half and truncating rounds to nearest
+// --------------------------------------------------------------------------------
+static int PixelEdge(float edge, int limit)
+{
+    return static_cast<int>(std::min(std::max(edge, 0.0f), static_cast<float>(limit)) + 0.5f);
+}
+
+
+FrameEncoder::FrameEncoder()
+{
+    this->width = 84;
+    this->height = 84;
+    this->channels = 1;
+}
+
+
+// Method to set the picture size and the channels per pixel (1 = grayscale, 3 = RGB)
+// ----------------------------------------------------------------------------------
+bool FrameEncoder::SetFormat(unsigned int width, unsigned int height, unsigned int channels)
+{
+    // Largest picture side (keeps the pixel math well within an int)
+    const unsigned int MAX_SIDE = 4096;
+
+    if (width == 0 || height == 0 || width > MAX_SIDE || height > MAX_SIDE)
+    {
+        std::cout << "Error: Frame size must be between 1 and " << MAX_SIDE << " pixels" << std::endl;
+        return false;
+    }
+
+    if (channels != 1 && channels != 3)
+    {
+        std::cout << "Error: Frames must have 1 (grayscale) or 3 (RGB) channels" << std::endl;
+        return false;
+    }
+
+    this->width = width;
+    this->height = height;
+    this->channels = channels;
+
+    return true;
+}
+
+
+// Method to return the number of bytes in one picture
+// ---------------------------------------------------
+size_t FrameEncoder::GetFrameBytes() const
+{
+    return static_cast<size_t>(this->width) * this->height * this->channels;
+}
+
+
+// Method to draw the game into pixels
+// -----------------------------------
+void FrameEncoder::Encode(const Game& game, unsigned char* pixels) const
+{
+    glm::vec2 scale(static_cast<float>(this->width) / game.windowWidth, static_cast<float>(this->height) / game.windowHeight);
+
+    // Clear to black
+    std::memset(pixels, 0, this->GetFrameBytes());
+
+    // Draw the bricks which are NOT destroyed (straight from the packed columns)
+    const BrickArchetype& bricks = game.activeLevel.bricks;
+    const std::vector<Transform>& brickTransforms = bricks.Column<Transform>();
+    const std::vector<Renderable>& brickRenderables = bricks.Column<Renderable>();
+    const std::vector<Breakable>& brickStates = bricks.Column<Breakable>();
+
+    for (unsigned int i = 0; i < bricks.Size(); ++i)
+    {
+        if (!brickStates[i].isDestroyed)
+            this->FillRect(pixels, brickTransforms[i].position, brickTransforms[i].size, brickRenderables[i].color, scale);
+    }
+
+    // Draw the player
+    this->FillRect(pixels, game.player.Position, game.player.Size, game.player.Color, scale);
+
+    // Draw the balls which are in play and NOT destroyed
+    const std::vector<Transform>& ballTransforms = game.ballObjects.Column<Transform>();
+    const std::vector<Renderable>& ballRenderables = game.ballObjects.Column<Renderable>();
+    const std::vector<BallState>& ballStates = game.ballObjects.Column<BallState>();
+
+    for (unsigned int i = 0; i < game.ballObjects.Size(); ++i)
+    {
+        if (ballStates[i].isInPlay && !ballStates[i].isDestroyed)
+            this->FillRect(pixels, ballTransforms[i].position, ballTransforms[i].size, ballRenderables[i].color, scale);
+    }
+}
+
+
+// Method to fill a rectangle given in game coordinates
+// NOTE: Both edges are rounded to the nearest pixel, so neighbouring bricks meet without gaps or overlaps
+// -------------------------------------------------------------------------------------------------------
+void FrameEncoder::FillRect(unsigned char* pixels, const glm::vec2& position, const glm::vec2& size, const glm::vec3& color, const glm::vec2& scale) const
+{
+    int pictureWidth = static_cast<int>(this->width);
+    int pictureHeight = static_cast<int>(this->height);
+
+    int left = PixelEdge(position.x * scale.x, pictureWidth);
+    int right = PixelEdge((position.x + size.x) * scale.x, pictureWidth);
+    int top = PixelEdge(position.y * scale.y, pictureHeight);
+    int bottom = PixelEdge((position.y + size.y) * scale.y, pictureHeight);
+
+    // Keep every shape at least one pixel across (unless it is off the picture)
+    if (right <= left)
+    {
+        if (left >= pictureWidth || position.x + size.x < 0.0f)
+            return;
+        right = left + 1;
+    }
+
+    if (bottom <= top)
+    {
+        if (top >= pictureHeight || position.y + size.y < 0.0f)
+            return;
+        bottom = top + 1;
+    }
+
+    size_t rowBytes = static_cast<size_t>(this->width) * this->channels;
+    size_t spanBytes = static_cast<size_t>(right - left) * this->channels;
+    unsigned char* firstRow = pixels + top * rowBytes + left * this->channels;
+
+    unsigned char red = ColorByte(color.x);
+    unsigned char green = ColorByte(color.y);
+    unsigned char blue = ColorByte(color.z);
+
+    // Fill the first row of the span...
+    if (this->channels == 1)
+    {
+        // Integer luma (BT.601 weights scaled to 256)
+        unsigned char gray = static_cast<unsigned char>((77 * red + 150 * green + 29 * blue) >> 8);
+        std::memset(firstRow, gray, spanBytes);
+    }
+    else
+    {
+        for (int x = left; x < right; ++x)
+        {
+            unsigned char* pixel = firstRow + (x - left) * 3;
+            pixel[0] = red;
+            pixel[1] = green;
+            pixel[2] = blue;
+        }
+    }
+
+    // ...then copy it to the other rows
+    for (int y = top + 1; y < bottom; ++y)
+    {
+        std::memcpy(firstRow + (y - top) * rowBytes, firstRow, spanBytes);
+    }
+}
@@ -0,0 +1,69 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//  BREAKOUT REMIX
+//  --------------
+//  by slate2b
+//
+//  The FrameEncoder class draws a small picture of the game (e.g. 84x84
+//  pixels, grayscale or RGB) on the CPU, for agents which learn from
+//  pixels.  No OpenGL context or readback is needed.
+//
+//  Every shape in the game is an axis-aligned rectangle, so the picture
+//  is drawn in the same order as the render list (live bricks, the
+//  paddle, then the balls in play) by scaling each rectangle to whole
+//  pixels and filling its rows.  Every shape covers at least one pixel,
+//  so small balls do not vanish.
+//
+//  The pixels are written straight into a buffer owned by the caller,
+//  row by row from the top, one byte per channel:
+//
+//     FrameEncoder encoder;
+//     encoder.SetFormat(84, 84, 1);
+//     std::vector<unsigned char> pixels(encoder.GetFrameBytes());
+//     encoder.Encode(game, pixels.data());
+//
+//  The FrameEncoder class is responsible for the following:
+//
+//     * Checking the picture format (width, height and channels)
+//     * Drawing the bricks, paddle and balls into a pixel buffer
+//
+///////////////////////////////////////////////////////////////////////////
+
+#ifndef FRAMEENCODER_H
+#define FRAMEENCODER_H
+
+#include <cstddef>
+
+#include <glm/glm.hpp>
+
+#include "game.h"
+
+class FrameEncoder
+{
+
+public:
+
+	// Constructor (84x84 grayscale until SetFormat is called)
+	FrameEncoder();
+
+	// Method to set the picture size and the channels per pixel (1 = grayscale, 3 = RGB), returns false if not valid
+	bool SetFormat(unsigned int width, unsigned int height, unsigned int channels);
+
+	// Method to return the number of bytes in one picture
+	size_t GetFrameBytes() const;
+
+	// Method to draw the game into pixels (GetFrameBytes bytes)
+	void Encode(const Game& game, unsigned char* pixels) const;
+
+private:
+
+	// Picture format
+	unsigned int width;
+	unsigned int height;
+	unsigned int channels;
+
+	// Method to fill a rectangle given in game coordinates (scale turns them into pixels)
+	void FillRect(unsigned char* pixels, const glm::vec2& position, const glm::vec2& size, const glm::vec3& color, const glm::vec2& scale) const;
+};
+
+#endif
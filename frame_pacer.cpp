@@ -0,0 +1,227 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//  BREAKOUT REMIX
+//  --------------
+//  by slate2b
+//
+//  The FramePacer class decides when each frame starts, and measures how
+//  evenly the frames are spaced.
+//
+//  The FramePacer class is responsible for the following:
+//
+//     * Choosing the swap interval for the pacing mode
+//     * Waiting for the start of each frame (fixed mode)
+//	   * Measuring the frame time average and variance
+//
+///////////////////////////////////////////////////////////////////////////
+
+#include "frame_pacer.h"
+
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <thread>
+
+typedef std::chrono::steady_clock PacerClock;
+typedef std::chrono::duration<double> Seconds;
+
+FramePacer::FramePacer()
+{
+    spinTime = 0.002;
+    mode = PACING_VSYNC;
+    targetFrameTime = 1.0 / 60.0;
+    hasStarted = false;
+
+    frameCount = 0;
+    frameTimeMean = 0.0;
+    frameTimeSquares = 0.0;
+    minFrameTime = 0.0;
+    maxFrameTime = 0.0;
+    lateFrames = 0;
+}
+
+
+// Method to set the pacing mode (target_fps is only used in fixed mode)
+// ---------------------------------------------------------------------
+void FramePacer::SetMode(PacingMode mode, float target_fps)
+{
+    this->mode = mode;
+
+    if (target_fps > 0.0f)
+        this->targetFrameTime = 1.0 / target_fps;
+
+    // Start the frame schedule over
+    this->hasStarted = false;
+}
+
+
+// Method to set the pacing mode from its name (returns false if the name is not recognized)
+// -----------------------------------------------------------------------------------------
+bool FramePacer::SetMode(const char* mode_name, float target_fps)
+{
+    if (std::strcmp(mode_name, "uncapped") == 0)
+        this->SetMode(PACING_UNCAPPED, target_fps);
+    else if (std::strcmp(mode_name, "vsync") == 0)
+        this->SetMode(PACING_VSYNC, target_fps);
+    else if (std::strcmp(mode_name, "adaptive") == 0)
+        this->SetMode(PACING_ADAPTIVE, target_fps);
+    else if (std::strcmp(mode_name, "fixed") == 0)
+        this->SetMode(PACING_FIXED, target_fps);
+    else
+    {
+        std::cout << "Error: Unknown Pacing Mode " << mode_name << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+
+// Method to return the pacing mode
+// --------------------------------
+PacingMode FramePacer::GetMode() const
+{
+    return this->mode;
+}
+
+
+// Method to return the name of the pacing mode
+// --------------------------------------------
+const char* FramePacer::GetModeName() const
+{
+    switch (this->mode)
+    {
+    case PACING_UNCAPPED:
+        return "uncapped";
+    case PACING_ADAPTIVE:
+        return "adaptive";
+    case PACING_FIXED:
+        return "fixed";
+    default:
+        return "vsync";
+    }
+}
+
+
+// Method to return the swap interval for the pacing mode (0 = no vsync, 1 = vsync, -1 = adaptive vsync)
+// -----------------------------------------------------------------------------------------------------
+int FramePacer::GetSwapInterval() const
+{
+    switch (this->mode)
+    {
+    case PACING_VSYNC:
+        return 1;
+    case PACING_ADAPTIVE:
+        return -1;
+    default:
+        return 0;
+    }
+}
+
+
+// Method to wait until the next frame is due (fixed mode only) and record the time since the last frame started
+// -------------------------------------------------------------------------------------------------------------
+void FramePacer::BeginFrame()
+{
+    if (this->mode == PACING_FIXED && this->hasStarted)
+    {
+        // A frame which finished after it was due is late
+        if (PacerClock::now() > this->nextFrameDue)
+            this->lateFrames += 1;
+
+        this->WaitUntil(this->nextFrameDue);
+    }
+
+    PacerClock::time_point frameStart = PacerClock::now();
+
+    if (this->hasStarted)
+    {
+        double frameTime = Seconds(frameStart - this->lastFrameStart).count();
+
+        if (this->frameCount == 0 || frameTime < this->minFrameTime)
+            this->minFrameTime = frameTime;
+
+        if (this->frameCount == 0 || frameTime > this->maxFrameTime)
+            this->maxFrameTime = frameTime;
+
+        // Update the running mean and sum of squared differences
+        this->frameCount += 1;
+        double difference = frameTime - this->frameTimeMean;
+        this->frameTimeMean += difference / this->frameCount;
+        this->frameTimeSquares += difference * (frameTime - this->frameTimeMean);
+    }
+
+    // Schedule the next frame one frame time after this one was due, so the rate does not drift,
+    // unless this frame started more than a whole frame late (then start the schedule over)
+    PacerClock::duration frameDuration = std::chrono::duration_cast<PacerClock::duration>(Seconds(this->targetFrameTime));
+
+    if (!this->hasStarted || frameStart - this->nextFrameDue > frameDuration)
+        this->nextFrameDue = frameStart + frameDuration;
+    else
+        this->nextFrameDue += frameDuration;
+
+    this->lastFrameStart = frameStart;
+    this->hasStarted = true;
+}
+
+
+// Method to return the number of frame times measured
+// ---------------------------------------------------
+unsigned int FramePacer::GetFrameCount() const
+{
+    return this->frameCount;
+}
+
+
+// Methods to return the frame time statistics, in seconds
+// -------------------------------------------------------
+double FramePacer::GetAverageFrameTime() const
+{
+    return this->frameTimeMean;
+}
+
+double FramePacer::GetFrameTimeVariance() const
+{
+    if (this->frameCount < 2)
+        return 0.0;
+
+    return this->frameTimeSquares / (this->frameCount - 1);
+}
+
+
+// Method to print the frame time statistics
+// -----------------------------------------
+void FramePacer::PrintReport() const
+{
+    std::cout << "Frame pacing (" << this->GetModeName() << "): " << this->frameCount << " frames" << std::endl;
+
+    if (this->frameCount == 0)
+        return;
+
+    std::cout << "  frame time (ms):  avg " << this->frameTimeMean * 1000.0
+        << "  std dev " << std::sqrt(this->GetFrameTimeVariance()) * 1000.0
+        << "  min " << this->minFrameTime * 1000.0
+        << "  max " << this->maxFrameTime * 1000.0 << std::endl;
+
+    if (this->mode == PACING_FIXED)
+        std::cout << "  late frames:      " << this->lateFrames << " (target " << this->targetFrameTime * 1000.0 << " ms)" << std::endl;
+}
+
+
+// Method to wait until the given time, sleeping first and spinning at the end
+// ---------------------------------------------------------------------------
+void FramePacer::WaitUntil(PacerClock::time_point due_time) const
+{
+    PacerClock::duration spinDuration = std::chrono::duration_cast<PacerClock::duration>(Seconds(this->spinTime));
+
+    // Sleep until the spin time before the frame is due
+    PacerClock::time_point now = PacerClock::now();
+
+    if (due_time - now > spinDuration)
+        std::this_thread::sleep_for(due_time - spinDuration - now);
+
+    // Spin for the rest
+    while (PacerClock::now() < due_time)
+    {
+    }
+}
@@ -0,0 +1,105 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//  BREAKOUT REMIX
+//  --------------
+//  by slate2b
+//
+//  The FramePacer class decides when each frame starts, and measures how
+//  evenly the frames are spaced.
+//
+//  Pacing modes:
+//
+//     * uncapped:  Run frames as fast as possible (swap interval 0)
+//     * vsync:     Wait for the display refresh on every swap (swap interval 1)
+//     * adaptive:  Wait for the refresh, but swap right away when a frame is late
+//                  (swap interval -1, falls back to vsync without driver support)
+//     * fixed:     Start frames at a fixed rate (e.g. --fps 60) without vsync
+//
+//  The fixed mode waits for the start of each frame by sleeping until
+//  shortly before it is due, then spinning for the rest.  Sleeping saves
+//  CPU time, and spinning avoids oversleeping (the operating system may
+//  wake a sleeping thread late).
+//
+//  The FramePacer class is responsible for the following:
+//
+//     * Choosing the swap interval for the pacing mode
+//     * Waiting for the start of each frame (fixed mode)
+//	   * Measuring the frame time average and variance
+//
+///////////////////////////////////////////////////////////////////////////
+
+#ifndef FRAMEPACER_H
+#define FRAMEPACER_H
+
+#include <chrono>
+
+// Frame pacing modes
+enum PacingMode {
+	PACING_UNCAPPED,
+	PACING_VSYNC,
+	PACING_ADAPTIVE,
+	PACING_FIXED
+};
+
+class FramePacer
+{
+
+public:
+
+	// Time to spin (instead of sleep) before a frame is due in fixed mode, in seconds
+	double spinTime;
+
+	// Constructor (vsync by default)
+	FramePacer();
+
+	// Method to set the pacing mode (target_fps is only used in fixed mode)
+	void SetMode(PacingMode mode, float target_fps);
+
+	// Method to set the pacing mode from its name (returns false if the name is not recognized)
+	bool SetMode(const char* mode_name, float target_fps);
+
+	// Method to return the pacing mode
+	PacingMode GetMode() const;
+
+	// Method to return the name of the pacing mode
+	const char* GetModeName() const;
+
+	// Method to return the swap interval for the pacing mode (0 = no vsync, 1 = vsync, -1 = adaptive vsync)
+	int GetSwapInterval() const;
+
+	// Method to wait until the next frame is due (fixed mode only) and record the time since the last frame started
+	void BeginFrame();
+
+	// Method to return the number of frame times measured
+	unsigned int GetFrameCount() const;
+
+	// Methods to return the frame time statistics, in seconds
+	double GetAverageFrameTime() const;
+	double GetFrameTimeVariance() const;
+
+	// Method to print the frame time statistics
+	void PrintReport() const;
+
+private:
+
+	PacingMode mode;
+	double targetFrameTime;
+
+	// Start time of the last frame, and the time the next frame is due (fixed mode)
+	std::chrono::steady_clock::time_point lastFrameStart;
+	std::chrono::steady_clock::time_point nextFrameDue;
+	bool hasStarted;
+
+	// Running frame time statistics (Welford's method, so no frame times are stored)
+	unsigned int frameCount;
+	double frameTimeMean;
+	double frameTimeSquares;
+	double minFrameTime;
+	double maxFrameTime;
+	unsigned int lateFrames;
+
+	// Method to wait until the given time, sleeping first and spinning at the end
+	void WaitUntil(std::chrono::steady_clock::time_point due_time) const;
+};
+
+#endif
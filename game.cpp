@@ -10,25 +10,16 @@
 //     * Processes user input (keyboard)
 //	   * Processes collisions between game elements
 //     * Manages the updates for all game elements
-//     * Manages rendering for all game elements
 //     * Resets the game when the ball falls below the bottom of the screen
 //
 ///////////////////////////////////////////////////////////////////////////
 
 #include "game.h"
 
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 
-////////////////////////////////////////
-// 
-// Pointers for fundamental game objects
-//
-////////////////////////////////////////
-
-Shader* shader;
-ShapeRenderer* shapeRenderer;
-Player* player;
-
 ///////////////
 //
 // Constructors
@@ -36,16 +27,41 @@ Player* player;
 ///////////////
 
 Game::Game(unsigned int window_width, unsigned int window_height)
+	: player(window_width, window_height)
 {
 	this->windowWidth = window_width;
 	this->windowHeight = window_height;
+
+	// Start with no score and no game time
+	this->score = 0;
+	this->gameTime = 0.0f;
+
+	// Start with no ball pair or paddle tests counted
+	this->ballPairTests = 0;
+	this->ballPairCollisions = 0;
+	this->paddleTestsRun = 0;
+	this->paddleTestsSkipped = 0;
+
+	// Use the float physics until SetFixedPoint is called
+	this->isFixedPoint = false;
+
+	// Start playing the first level
+	this->currentLevel = 0;
+	this->levelState = LEVEL_PLAYING;
+	this->levelClearedTimer = 0;
+	this->levelsCleared = 0;
+	this->levelResets = 0;
+
+	// Start with every key released
+	for (bool& key : this->keys)
+		key = false;
+
+	// Detect collisions on a single thread until SetCollisionThreads is called
+	this->SetCollisionThreads(1);
 }
 
 Game::~Game()
 {
-	delete shader;
-	delete shapeRenderer;
-	delete player;
 }
 
 /////////////////////
@@ -54,32 +70,17 @@ Game::~Game()
 //
 /////////////////////
 
-// Method to initialize the elements which make up the game
-// --------------------------------------------------------
-void Game::InitGame()
+// Method to initialize the player, ball objects and levels without touching OpenGL
+// NOTE: Called by InitGame, and used on its own by headless tools such as the benchmarks
+// --------------------------------------------------------------------------------
+void Game::InitSimulation()
 {
     // Initialize ball in play timer
     // NOTE: Used to manage ball object release events
     ballInPlayTimer = 0;
 
-	// Calling the Shader constructor for the game's shader pointer (declared at top of game.cpp file)
-	shader = new Shader();
-
-	// Tell the GPU to use this shader
-	shader->Use();
-
-	// Initialze a mat4 for the game's projection matrix
-	glm::mat4 projection = glm::ortho(0.0f, static_cast<float>(this->windowWidth),
-		static_cast<float>(this->windowHeight), 0.0f, -1.0f, 1.0f);
-
-	// Send the projection matrix to the vertex shader using the projection uniform
-	glUniformMatrix4fv(glGetUniformLocation(shader->shaderId, "projection"), 1, false, glm::value_ptr(projection));
-
-	// Calling the ShapeRenderer constructor for the game's shapeRenderer pointer (declared at top of game.cpp file)
-	shapeRenderer = new ShapeRenderer(*shader);
-
-	// Calling the Player constructor for the game's player pointer (declared at top of game.cpp file)
-	player = new Player(windowWidth, windowHeight);
+	// Put the player paddle in its starting place
+	this->player.InitPlayer(windowWidth, windowHeight);
 
     // Number of ball objects available per game
     // NOTE: When all ball object have gone below the bottom of the screen, the game resets
@@ -88,47 +89,140 @@ void Game::InitGame()
     // Create the number of BallObjects indicated in the numBallObjects variable
     for (unsigned int i = 0; i < numBallObjects; ++i)
     {
-        // Create a ball object
-        BallObject b;
+        // Add a ball object to the ballObjects archetype
+        BallObject b = this->ballObjects.Add();
         // Call the InitBall method for the new ball object
-        b.InitBall(windowWidth, windowHeight, *player);
-        // Add the ball object to the ballObjects std::vector container
-        this->ballObjects.push_back(b);
+        b.InitBall(windowWidth, windowHeight, this->player);
     }
 
-	// Creating a GameLevel object
-	GameLevel levelOne; 
-
-	// Calling the GameLevel Load method to load level data from file
-	// NOTE: Sending (windowHeight / 2) so that the bricks fill the top third of the window
-	levelOne.Load("level_one.lvl", windowWidth, windowHeight / 3);
-	
-	// Add the loaded level to the Game's levels std::vector container
-	this->levels.push_back(levelOne);
-	
-	// Setting the initial level for the game
-	this->currentLevel = 0;
+	// Calling the LevelPack LoadManifest method to load the list of level files
+	// NOTE: Sending (windowHeight / 3) so that the bricks fill the top third of the window
+	if (!this->levelPack.LoadManifest("levels.pack", windowWidth, windowHeight / 3))
+	{
+		// Fall back to the original single level if the manifest is missing
+		this->levelPack.AddLevelFile("level_one.lvl");
+	}
+
+	// Load the initial level for the game (also starts building the level after it)
+	this->LoadLevel(0);
+}
+
+
+// Method to set the number of threads used to detect ball and brick collisions
+// NOTE: The results are the same for any number of threads
+// ----------------------------------------------------------------------------
+void Game::SetCollisionThreads(unsigned int num_threads)
+{
+    this->collisionWorkers.SetThreadCount(num_threads);
+
+    // One buffer of brick hits per thread
+    this->workerBrickHits.resize(this->collisionWorkers.GetThreadCount());
 }
 
 
 // Method to process user input
 // ----------------------------
 void Game::ProcessInput(float dt)
+{
+	// Move the player paddle for the whole frame with the keys currently held
+	this->MovePlayer(dt);
+
+	// If the user presses the Space key...
+	if (this->keys[KEY_SPACE])
+	{
+		// Hold or release a ball object
+		this->ProcessSpace();
+	}
+}
+
+
+// Method to process the key events queued for a frame, moving the player paddle at the time of each event
+// NOTE: step_end is the time (from the same clock as the event times) at which the frame sampled the keys
+// -------------------------------------------------------------------------------------------------------
+void Game::ProcessInputEvents(InputQueue& input_queue, double step_end, float dt)
+{
+	double stepStart = step_end - dt;
+	double lastTime = stepStart;
+
+	// Track Space presses separately, so a press and release within one frame still counts
+	bool isSpacePressed = false;
+
+	InputEvent inputEvent;
+
+	// Take the events which happened up to the end of this frame, in order
+	while (input_queue.Peek(inputEvent) && inputEvent.time <= step_end)
+	{
+		input_queue.Pop();
+
+		// Events from before this frame started (e.g. while the game was loading) apply at its start
+		double eventTime = std::max(inputEvent.time, stepStart);
+
+		// Move the player paddle up to the event with the keys held until then
+		if (eventTime > lastTime)
+		{
+			this->MovePlayer(static_cast<float>(eventTime - lastTime));
+			lastTime = eventTime;
+		}
+
+		// Apply the event
+		if (inputEvent.key >= 0 && inputEvent.key < 1024)
+		{
+			this->keys[inputEvent.key] = inputEvent.isPressed;
+
+			if (inputEvent.key == KEY_SPACE && inputEvent.isPressed)
+				isSpacePressed = true;
+		}
+	}
+
+	// Move the player paddle for the rest of the frame
+	if (step_end > lastTime)
+	{
+		this->MovePlayer(static_cast<float>(step_end - lastTime));
+	}
+
+	// If the user pressed (or is holding) the Space key...
+	if (this->keys[KEY_SPACE] || isSpacePressed)
+	{
+		// Hold or release a ball object
+		this->ProcessSpace();
+	}
+}
+
+
+// Method to apply the key events queued for a frame to the keys array without moving the player paddle
+// ---------------------------------------------------------------------------------------------------
+void Game::ApplyInputEvents(InputQueue& input_queue, double step_end)
+{
+	InputEvent inputEvent;
+
+	while (input_queue.Peek(inputEvent) && inputEvent.time <= step_end)
+	{
+		input_queue.Pop();
+
+		if (inputEvent.key >= 0 && inputEvent.key < 1024)
+			this->keys[inputEvent.key] = inputEvent.isPressed;
+	}
+}
+
+
+// Method to move the player paddle (and any ball it is holding) with the keys currently held
+// -----------------------------------------------------------------------------------------
+void Game::MovePlayer(float dt)
 {
 	// Setting variable for playerVelocity
 	float playerVelocity = 500.0f * dt;
 
 	// If the user presses the A key...
-	if (this->keys[GLFW_KEY_A])
+	if (this->keys[KEY_A])
 	{
 		// As long as the player isn't already up against the left side of the screen...
-		if (player->Position.x >= 0.0f)
+		if (this->player.Position.x >= 0.0f)
 		{
 			// Move the player to the left
-			player->Position.x -= playerVelocity;
+			this->player.Position.x -= playerVelocity;
 
             // Loop through the all the ball_objects 
-            for (BallObject& ball_object : this->ballObjects)
+            for (BallObject ball_object : this->ballObjects)
             {
                 // If ball object is NOT destroyed...
                 if (!ball_object.isDestroyed)
@@ -145,16 +239,16 @@ void Game::ProcessInput(float dt)
 	}
 
 	// If the user presses the D key...
-	if (this->keys[GLFW_KEY_D])
+	if (this->keys[KEY_D])
 	{
 		// As long as the player isn't already up against the right side of the screen...
-		if (player->Position.x <= this->windowWidth - player->Size.x)
+		if (this->player.Position.x <= this->windowWidth - this->player.Size.x)
 		{
 			// Move the player to the right
-			player->Position.x += playerVelocity;
+			this->player.Position.x += playerVelocity;
 
             // Loop through all the ball objects
-            for (BallObject& ball_object : this->ballObjects)
+            for (BallObject ball_object : this->ballObjects)
             {
                 // If ball object is NOT destroyed...
                 if (!ball_object.isDestroyed)
@@ -169,75 +263,76 @@ void Game::ProcessInput(float dt)
             }
     	}
 	}
+}
+
 
-    // If the user presses the Space key...
-    if (this->keys[GLFW_KEY_SPACE])
+// Method to hold or release a ball object when the Space key is pressed
+// ---------------------------------------------------------------------
+void Game::ProcessSpace()
+{
+    // Check the ball in play timer to help manage ball release events
+    if (ballInPlayTimer >= 240)
     {
+        // Variable to track whether paddle is holding a ball object
+        bool isHolding = false;
+
+        // ----------------------
+        // Release a ball object?
+        // ----------------------
         
-        // Check the ball in play timer to help manage ball release events
-        if (ballInPlayTimer >= 240)
+        // Loop through all the ball objects
+        for (BallObject ball_object : this->ballObjects)
         {
-            // Variable to track whether paddle is holding a ball object
-            bool isHolding = false;
-
-            // ----------------------
-            // Release a ball object?
-            // ----------------------
-            
-            // Loop through all the ball objects
-            for (BallObject& ball_object : this->ballObjects)
+            // If ball object is NOT destroyed...
+            if (!ball_object.isDestroyed)
             {
-                // If ball object is NOT destroyed...
-                if (!ball_object.isDestroyed)
+                // If ball object is held...
+                if (ball_object.isHeld)
                 {
-                    // If ball object is held...
-                    if (ball_object.isHeld)
-                    {
-                        // Update isHeld to false to release the ball object
-                        ball_object.isHeld = false;
+                    // Update isHeld to false to release the ball object
+                    ball_object.isHeld = false;
 
-                        // Update the ball object's position so it releases from the proper location on the screen
-                        glm::vec2 ballPos = player->Position + glm::vec2((player->Size.x / 2.0f) - (ball_object.Size.x / 2.0f), -ball_object.Size.y);
-                        ball_object.Position = ballPos;
+                    // Update the ball object's position so it releases from the proper location on the screen
+                    glm::vec2 ballPos = this->player.Position + glm::vec2((this->player.Size.x / 2.0f) - (ball_object.Size.x / 2.0f), -ball_object.Size.y);
+                    ball_object.Position = ballPos;
 
-                        // Reset ballInPlayTimer
-                        ballInPlayTimer = 0;
+                    // Reset ballInPlayTimer
+                    ballInPlayTimer = 0;
 
-                        // Stop processing input for this frame
-                        return;
-                    }
+                    // Stop processing input for this frame
+                    return;
                 }
             }
+        }
 
-            // -------------------------------------------------------------------
-            // Prepare a ball object to be released (put the ball object in play)?
-            // -------------------------------------------------------------------
-            
-            // If paddle is not already holding a ball object...
-            if (!isHolding)
+        // -------------------------------------------------------------------
+        // Prepare a ball object to be released (put the ball object in play)?
+        // -------------------------------------------------------------------
+        
+        // If paddle is not already holding a ball object...
+        if (!isHolding)
+        {
+            // Loop through all the ball objects
+            for (BallObject ball_object : this->ballObjects)
             {
-                // Loop through all the ball objects
-                for (BallObject& ball_object : this->ballObjects)
+                // If ball object is not in play and not destroyed
+                if (!ball_object.isInPlay && !ball_object.isDestroyed)
                 {
-                    // If ball object is not in play and not destroyed
-                    if (!ball_object.isInPlay && !ball_object.isDestroyed)
-                    {
-                        // Place ball object in play
-                        ball_object.isInPlay = true;
+                    // Place ball object in play
+                    ball_object.isInPlay = true;
 
-                        // Update the ball object to isHeld
-                        ball_object.isHeld = true;
+                    // Update the ball object to isHeld
+                    ball_object.isHeld = true;
 
-                        // Update the position of the ball object so it appears correctly on the player paddle
-                        glm::vec2 ballPos = player->Position + glm::vec2((player->Size.x / 2.0f) - (ball_object.Size.x / 2.0f), -ball_object.Size.y);
-                        ball_object.Position = ballPos;
+                    // Update the position of the ball object so it appears correctly on the player paddle
+                    glm::vec2 ballPos = this->player.Position + glm::vec2((this->player.Size.x / 2.0f) - (ball_object.Size.x / 2.0f), -ball_object.Size.y);
+                    ball_object.Position = ballPos;
 
-                        // Reset ballInPlayTimer
-                        ballInPlayTimer = 0;
+                    // Reset ballInPlayTimer
+                    ballInPlayTimer = 0;
 
-                        // Stop processing input for this frame
-                        return;
-                    }
+                    // Stop processing input for this frame
+                    return;
                 }
             }
         }
@@ -249,6 +344,30 @@ void Game::ProcessInput(float dt)
 // ---------------------------------------------
 void Game::UpdateGame(float dt)
 {
+    // Patch in any level files saved since the last step (only while watching them, see WatchLevelFiles)
+    if (this->levelWatcher.IsWatching())
+        this->ApplyLevelEdits();
+
+    // Advance the game time (used to timestamp brick changes)
+    gameTime += dt;
+
+    // Number of frames to show the cleared level before moving on to the next level
+    const unsigned int LEVEL_CLEARED_FRAMES = 60;
+
+    // If the level has been cleared, pause the balls until it is time to move on
+    if (this->levelState == LEVEL_CLEARED)
+    {
+        this->levelClearedTimer += 1;
+
+        if (this->levelClearedTimer >= LEVEL_CLEARED_FRAMES)
+            this->AdvanceLevel();
+
+        return;
+    }
+
+    // Live bricks before the balls move (a level only counts as cleared if this step broke its last brick)
+    unsigned int liveBricksBefore = this->activeLevel.liveBricks;
+
     // Increment the ball in play timer
     ballInPlayTimer += 1;
 
@@ -258,22 +377,40 @@ void Game::UpdateGame(float dt)
         ballInPlayTimer = 240;
     }
 
-    // Loop through all the ball objects
-    for (BallObject& ball_object : this->ballObjects)
+    // The deterministic physics mode moves and collides the balls with fixed point math
+    if (this->isFixedPoint)
+    {
+        this->UpdateBallsFixed(dt);
+    }
+    else
     {
-        // If the ball object is in play, is NOT held, and is NOT destroyed...
-        if (ball_object.isInPlay && !ball_object.isHeld && !ball_object.isDestroyed)
+        // Loop through all the ball objects
+        for (BallObject ball_object : this->ballObjects)
         {
-            // Move the ball
-            ball_object.MoveBall(dt, this->windowWidth);
+            // If the ball object is in play, is NOT held, and is NOT destroyed...
+            if (ball_object.isInPlay && !ball_object.isHeld && !ball_object.isDestroyed)
+            {
+                // Move the ball
+                ball_object.MoveBall(dt, this->windowWidth);
+            }
         }
+
+        // Check for collisions
+        this->ProcessCollisions();
     }
 
-    // Check for collisions
-    this->ProcessCollisions();
+    // If the last brick was just destroyed, the level has been cleared
+    // NOTE: Uses the live brick count, so no bricks are scanned.  A level without bricks to break is never cleared
+    //       (otherwise it would be cleared straight away, over and over)
+    if (liveBricksBefore > 0 && this->IsLevelComplete())
+    {
+        this->levelState = LEVEL_CLEARED;
+        this->levelClearedTimer = 0;
+        return;
+    }
 
     // Loop through all the ball objects
-    for (BallObject& ball_object : this->ballObjects)
+    for (BallObject ball_object : this->ballObjects)
     {
         // If the ball object has passed below the bottom of the screen...
         if (ball_object.Position.y >= this->windowHeight)
@@ -288,7 +425,7 @@ void Game::UpdateGame(float dt)
     unsigned int numBallObjectsDestroyed = 0;
 
     // Loop through all the ball objects
-    for (BallObject& ball_object : this->ballObjects)
+    for (BallObject ball_object : this->ballObjects)
     {
         // If a ball object has been destroyed...
         if (ball_object.isDestroyed) {
@@ -298,9 +435,12 @@ void Game::UpdateGame(float dt)
         }
     }
 
-    // If all five ball objects have been destroyed...
-    if (numBallObjectsDestroyed >= 5)
+    // If all the ball objects have been destroyed...
+    if (numBallObjectsDestroyed >= this->ballObjects.Size())
     {
+        // Count the game over (the level starts again)
+        this->levelResets += 1;
+
         // Call the ResetLevel method to reset the level
         this->ResetLevel();
         // Call the ResetPlayer method to reset the player paddle and ball
@@ -309,60 +449,158 @@ void Game::UpdateGame(float dt)
 }
 
 
-// Method to render the game
-// -------------------------
-void Game::RenderGame()
+// Method to copy everything needed to draw the current frame into a render state
+// -------------------------------------------------------------------------------
+void Game::CaptureRenderState(RenderState& render_state) const
 {
-    // Draw (the bricks for) the current level
-    this->levels[this->currentLevel].DrawLevel(*shapeRenderer, *shader);
+    render_state.Capture(this->activeLevel.bricks, this->ballObjects, this->player);
+}
 
-    // Draw the player
-    player->DrawPlayer(*shapeRenderer, *shader);
 
-    // Loop through all the ball objects
-    for (BallObject& ball_object : this->ballObjects)
+// Method to reset the current level
+// ---------------------------------
+void Game::ResetLevel()
+{
+    // Reload the current level (the level pack still holds the built level, so no file access is needed)
+    this->LoadLevel(this->currentLevel);
+
+    // The game starts over, so the score does too
+    this->score = 0;
+    this->levelState = LEVEL_PLAYING;
+
+    // Replace the ball objects with a fresh set
+    this->RefillBalls();
+}
+
+
+// Method to move on to the next level once the current level has been cleared (wraps around after the last level)
+// ---------------------------------------------------------------------------------------------------------------
+void Game::AdvanceLevel()
+{
+    // Time the whole transition (the level pack has normally built the next level already)
+    ProfileScope transitionScope(this->profiler, "Level transition");
+
+    unsigned int levelCount = this->levelPack.GetLevelCount();
+    unsigned int nextLevel = this->currentLevel;
+
+    // Skip levels without bricks to break, but go round the pack at most once
+    for (unsigned int attempt = 0; attempt < levelCount; ++attempt)
     {
-        // If the ball object is in play and is NOT destroyed
-        if (ball_object.isInPlay && !ball_object.isDestroyed)
+        nextLevel = (nextLevel + 1 < levelCount) ? nextLevel + 1 : 0;
+
+        // Time getting the next level from the level pack on its own (only long if the loader thread fell behind)
         {
-            // Draw the ball object
-            ball_object.DrawBall(*shapeRenderer, *shader);
+            ProfileScope acquireScope(this->profiler, "Level acquire");
+            this->LoadLevel(nextLevel);
         }
+
+        if (!this->activeLevel.IsCompleted())
+            break;
+
+        std::cout << "Error: Level " << nextLevel << " has no bricks to break" << std::endl;
     }
+
+    this->levelsCleared += 1;
+    this->levelState = LEVEL_PLAYING;
+
+    // Start the new level with a fresh set of balls and the paddle back in the middle
+    this->RefillBalls();
+    this->ResetPlayer();
 }
 
 
-// Method to reset the current level
-// NOTE: Current implementation is a single level, but could be expanded to include additional levels
-// --------------------------------------------------------------------------------------------------
-void Game::ResetLevel()
+// Method to replace the ball objects with a fresh set
+// ---------------------------------------------------
+void Game::RefillBalls()
+{
+    // Clear the ballObjects archetype
+    this->ballObjects.Clear();
+
+    // Create new ball objects and refill the ballObjects archetype
+    // ------------------------------------------------------------------------
+    // Number of ball objects available per game
+    // NOTE: When all ball object have gone below the bottom of the screen, the game resets
+    unsigned int numBallObjects = 5;
+
+    // Create the number of BallObjects indicated in the numBallObjects variable
+    for (unsigned int i = 0; i < numBallObjects; ++i)
+    {
+        // Add a ball object to the ballObjects archetype
+        BallObject b = this->ballObjects.Add();
+        // Call the InitBall method for the new ball object
+        b.InitBall(windowWidth, windowHeight, this->player);
+    }
+}
+
+
+// Method to load a level from the level pack and prefetch the level after it
+// --------------------------------------------------------------------------
+void Game::LoadLevel(unsigned int level_index)
+{
+    // Copy the built level into the active level
+    // NOTE: Only waits if the loader thread has not finished building the level yet
+    if (this->levelPack.AcquireLevel(level_index, this->activeLevel))
+    {
+        this->currentLevel = level_index;
+    }
+
+    // Start building the next level in the background while this one is played (the first level follows the last)
+    unsigned int levelCount = this->levelPack.GetLevelCount();
+
+    if (levelCount > 0)
+        this->levelPack.PrefetchLevel((this->currentLevel + 1) % levelCount);
+}
+
+
+// Method to start watching the level files, so edits are patched into the game while it runs
+// NOTE: The files are read on the watcher thread, and the edits are patched in at the start of UpdateGame
+// -------------------------------------------------------------------------------------------------------
+bool Game::WatchLevelFiles()
 {
-	// If the currentLevel is the first level in the levels std::vector
-    if (this->currentLevel == 0)
+    return this->levelWatcher.Start(this->levelPack.GetLevelFiles());
+}
+
+
+// Method to patch the edits read by the level watcher into the levels
+// NOTE: Only the bricks whose tile changed are touched, unless the size of the grid changed
+// -----------------------------------------------------------------------------------------
+unsigned int Game::ApplyLevelEdits()
+{
+    unsigned int numTaken = 0;
+
+    // Never waits: if the watcher thread is queuing an edit right now, the edits are taken next step
+    // NOTE: New edits are only taken once the level pack has taken the previous ones
+    if (this->levelEdits.empty() && this->levelWatcher.TakeEdits(this->levelEdits))
+        numTaken = static_cast<unsigned int>(this->levelEdits.size());
+
+    for (unsigned int i = 0; i < numTaken; ++i)
     {
-        // Call the Load method to load the first level (Resets the level)
-        this->levels[0].Load("level_one.lvl", windowWidth, windowHeight / 3);
+        const LevelEdit& edit = this->levelEdits[i];
 
-        // Clear the ballObjects std::vector container
-        this->ballObjects.clear();
+        if (edit.levelIndex != this->currentLevel)
+            continue;
 
-        // Create new ball objects and refill the ballObjects std::vector container
-        // ------------------------------------------------------------------------
-        // Number of ball objects available per game
-        // NOTE: When all ball object have gone below the bottom of the screen, the game resets
-        unsigned int numBallObjects = 5;
+        unsigned int changedBricks = 0;
 
-        // Create the number of BallObjects indicated in the numBallObjects variable
-        for (unsigned int i = 0; i < numBallObjects; ++i)
+        if (this->activeLevel.PatchTiles(edit.tileData, changedBricks))
+        {
+            std::cout << "Reloaded level " << edit.levelIndex << ": " << changedBricks << " bricks changed" << std::endl;
+        }
+        else
         {
-            // Create a ball object
-            BallObject b;
-            // Call the InitBall method for the new ball object
-            b.InitBall(windowWidth, windowHeight, *player);
-            // Add the ball object to the ballObjects std::vector container
-            this->ballObjects.push_back(b);
+            // Every brick moves when the size of the grid changes, so the level is built again
+            // NOTE: Sending (windowHeight / 3) so that the bricks fill the top third of the window (as InitSimulation does)
+            this->activeLevel.LoadTileData(edit.tileData, this->windowWidth, this->windowHeight / 3);
+            std::cout << "Reloaded level " << edit.levelIndex << ": grid size changed, level rebuilt" << std::endl;
         }
     }
+
+    // Patch the level pack's built copies too, so restarting a level keeps the edit
+    // NOTE: Never waits for the loader thread: the edits the level pack was too busy to take stay queued for the next step
+    this->levelEdits.erase(std::remove_if(this->levelEdits.begin(), this->levelEdits.end(),
+        [this](const LevelEdit& edit) { return this->levelPack.PatchLevel(edit.levelIndex, edit.tileData); }), this->levelEdits.end());
+
+    return numTaken;
 }
 
 
@@ -371,13 +609,13 @@ void Game::ResetLevel()
 void Game::ResetPlayer()
 {
 	// Reset the player to its initial state
-	player->InitPlayer(windowWidth, windowHeight);
+	this->player.InitPlayer(windowWidth, windowHeight);
 
     // Loop through all the ball objects
-    for (BallObject& ball_object : this->ballObjects)
+    for (BallObject ball_object : this->ballObjects)
     {
         // Call the InitBall method to reset ball object to its original state
-        ball_object.InitBall(windowWidth, windowHeight, *player);
+        ball_object.InitBall(windowWidth, windowHeight, this->player);
     }
 }
 
@@ -389,120 +627,101 @@ void Game::ResetPlayer()
 /////////////////////////////////////
 
 
-// Variables for collisions
-bool DetectBoxCollision(GameObject& one, GameObject& two);
-Collision DetectCircleCollision(BallObject& one, GameObject& two);
-Direction VectorDirection(glm::vec2 closest);
-
-
 // Primary method used to detect and manage collisions
 // ---------------------------------------------------
 void Game::ProcessCollisions()
 {
+    // Start a new list of brick changes for this frame
+    this->brickChanges.clear();
+
     // Check collisions between ball and bricks
     // ----------------------------------------
 
-    // Check each ball object
-    for (BallObject& ball_object : this->ballObjects)
+    // Number of ball objects handled by one task when the collision checks are spread across threads
+    const unsigned int BALLS_PER_TASK = 32;
+
+    unsigned int numBalls = this->ballObjects.Size();
+
+    // With a single thread (or only a few balls), resolve the balls one after another
+    if (this->collisionWorkers.GetThreadCount() == 1 || numBalls <= BALLS_PER_TASK)
     {
-        // If the current ball is in play and is not destroyed...
-        if (ball_object.isInPlay && !ball_object.isDestroyed)
+        std::vector<unsigned int>& brickHits = this->workerBrickHits[0];
+
+        // Check each ball object
+        for (unsigned int i = 0; i < numBalls; ++i)
         {
-            // Check each brick object
-            for (BrickObject& brick_object : this->levels[this->currentLevel].bricks)
+            BallObject ball_object = this->ballObjects[i];
+
+            // If the current ball is in play and is not destroyed...
+            if (ball_object.isInPlay && !ball_object.isDestroyed)
             {
-                // If the current brick is not destroyed...
-                if (!brick_object.isDestroyed)
-                {
-                    // Create a Collision variable to hold the collision information
-                    // Then calling the CheckCollision method which returns a Collision object
-                    Collision collision = DetectCircleCollision(ball_object, brick_object);
+                // Bounce the ball off the bricks it hits, then destroy those bricks
+                brickHits.clear();
+                this->CollideBallWithBricks(ball_object.Position, ball_object.Velocity, this->ballObjects.Get<CircleCollider>(i), brickHits);
 
-                    // If the ball collided with the current brick...
-                    if (std::get<0>(collision))
-                    {
-                        // Destroy the brick
-                        brick_object.isDestroyed = true;
-
-                        // Calculate the new position and velocity for the ball
-                        // ----------------------------------------------------
-
-                        // Creating a Direction variable to hold the collision direction
-                        Direction direction = std::get<1>(collision);
-
-                        // Creating a vec2 variable to hold difference vector for the collision
-                        glm::vec2 diff_vector = std::get<2>(collision);
-
-                        // If a horizontal collision...
-                        if (direction == LEFT || direction == RIGHT)
-                        {
-                            // Reverse the horizontal velocity
-                            ball_object.Velocity.x = -ball_object.Velocity.x;
-
-                            // Creating a variable to track how far into the brick the ball penetrated
-                            float penetration = (ball_object.Radius) - std::abs(diff_vector.x);
-
-                            // If the ball was traveling left...
-                            if (direction == LEFT)
-                            {
-                                // Shift the ball to where the right edge of the brick was
-                                ball_object.Position.x += penetration;
-                            }
-                            // If the ball was traveling right...
-                            else
-                            {
-                                // Shift the ball to where the left edge of the brick was
-                                ball_object.Position.x -= penetration;
-                            }
-                        }
-                        // If a vertical collision...
-                        else
-                        {
-                            // Reverse the vertical velocity
-                            ball_object.Velocity.y = -ball_object.Velocity.y;
-
-                            // Creating a variable to track how far into the brick the ball penetrated
-                            float penetration = (ball_object.Radius) - std::abs(diff_vector.y);
-
-                            // If the ball was traveling up...
-                            if (direction == UP)
-                            {
-                                // Shift the ball to where the bottom edge of the brick was
-                                ball_object.Position.y += penetration;
-                            }
-                            // If the ball was traveling down...
-                            else
-                            {
-                                // Shift the ball to where the top edge of the brick was
-                                ball_object.Position.y -= penetration;
-                            }
-                        }
-                    }
+                for (unsigned int brickIndex : brickHits)
+                {
+                    this->DestroyBrick(brickIndex, i);
                 }
             }
         }
     }
+    // Otherwise detect the hits on every thread, then resolve them in ball order
+    else
+    {
+        this->ProcessBrickCollisionsParallel(BALLS_PER_TASK);
+    }
+
+    // Check collisions between balls
+    // ------------------------------
+    this->ProcessBallCollisions();
 
     // Check collisions between ball and player paddle
     // NOTE: Only checks collisions for ball objects that are not held
     // ---------------------------------------------------------------
 
+    // Only a ball whose top to bottom extent overlaps the paddle's row can touch the paddle, so the
+    // narrow phase test is skipped for every other ball (e.g. the balls up among the bricks)
+    // NOTE: The margin makes the row slightly taller than the paddle so rounding can never skip a real hit
+    const float PADDLE_ROW_MARGIN = 1.0f;
+    float paddleRowTop = this->player.Position.y - PADDLE_ROW_MARGIN;
+    float paddleRowBottom = this->player.Position.y + this->player.Size.y + PADDLE_ROW_MARGIN;
+
+    // The row test only needs each ball's Transform, CircleCollider and BallState components
+    const std::vector<Transform>& ballTransforms = this->ballObjects.Column<Transform>();
+    const std::vector<CircleCollider>& ballColliders = this->ballObjects.Column<CircleCollider>();
+    const std::vector<BallState>& ballStates = this->ballObjects.Column<BallState>();
+
     // Check each ball object
-    for (BallObject& ball_object : this->ballObjects)
+    for (unsigned int i = 0; i < numBalls; ++i)
     {
         // If the current ball is in play and is not destroyed...
-        if (ball_object.isInPlay && !ball_object.isDestroyed)
+        if (ballStates[i].isInPlay && !ballStates[i].isDestroyed)
         {
+            // Skip the ball if it is entirely above or below the paddle's row
+            float ballTop = ballTransforms[i].position.y;
+            float ballBottom = ballTop + 2.0f * ballColliders[i].radius;
+
+            if (ballBottom < paddleRowTop || ballTop > paddleRowBottom)
+            {
+                this->paddleTestsSkipped += 1;
+                continue;
+            }
+
+            this->paddleTestsRun += 1;
+
+            BallObject ball_object = this->ballObjects[i];
+
             // Collision variable to hold the result of the collision
-            Collision result = DetectCircleCollision(ball_object, *player);
+            Collision result = DetectCircleCollision(ball_object, this->player);
             
             // If the player paddle is not holding the ball and collision is true
             if (!ball_object.isHeld && std::get<0>(result))
             {
                 // Variables used to determine difference between point of impact and the center of the paddle
-                float paddleCenter = player->Position.x + player->Size.x / 2.0f;
+                float paddleCenter = this->player.Position.x + this->player.Size.x / 2.0f;
                 float diffDistance = (ball_object.Position.x + ball_object.Radius) - paddleCenter;
-                float diffPercentage = diffDistance / (player->Size.x / 2.0f);
+                float diffPercentage = diffDistance / (this->player.Size.x / 2.0f);
 
                 // Variables used to determine amount of change in velocity
                 float initialBallVelocityX = 100.0f;
@@ -516,93 +735,322 @@ void Game::ProcessCollisions()
                 ball_object.Velocity = glm::normalize(ball_object.Velocity) * glm::length(oldVelocity);
 
                 // Adjust vertical velocity to compensate for sticky paddle effect
-                ball_object.Velocity.y = -1.0f * abs(ball_object.Velocity.y);
+                ball_object.Velocity.y = -1.0f * std::abs(ball_object.Velocity.y);
             }
         }
     }
 }
 
 
-// Method to perform collision detection when a ball collides with a box: Returns Collosion object
-// aka: AABB - Circle collision
-// -----------------------------------------------------------------------------------------------
-Collision DetectCircleCollision(BallObject& one, GameObject& two) 
+// Method to bounce moving balls off each other (sweep and prune along x, then circle tests)
+// NOTE: Only balls which are in play, NOT held and NOT destroyed take part
+// ----------------------------------------------------------------------------------------
+void Game::ProcessBallCollisions()
 {
-    // Variable to hold the center point of the circle shape (BallObject)
-    glm::vec2 center(one.Position + one.Radius);
-
-    // Calculate values for the box shape (GameObject: Brick or Player Paddle)
-    glm::vec2 aabb_half_extents(two.Size.x / 2.0f, two.Size.y / 2.0f);
-    glm::vec2 aabb_center(two.Position.x + aabb_half_extents.x, two.Position.y + aabb_half_extents.y);
-
-    // ----------------------------------------------------------------------------------------
-    // Using the point of impact on the surface of the box-shaped object in order to 
-    // determine the new movement vector and direction the BallObject will travel after impact.
-    // The goal is to determine which surface of the box-shaped GameObject should exert the 
-    // influence over the ball's change in direction after impact.
-    // ----------------------------------------------------------------------------------------
-
-    // Calculate the vector between center of BallObject and the center of the box-shaped GameObject
-    //    This represents which part of the box-shaped game object the ball collided with
-    glm::vec2 impactPoint = center - aabb_center;
-    // Clamp the impact point vector
-    glm::vec2 clamped = glm::clamp(impactPoint, -aabb_half_extents, aabb_half_extents);
-    // Calculate the point of the box-shaped GameObject closest to the BallObject by adding the clamped impact point vector to the center
-    glm::vec2 closest = aabb_center + clamped;
-    // Calculate the final point of impact by calculating the difference between
-    //    the center of the BallObject and the closest point on the box-shaped GameObject
-    impactPoint = closest - center;
-
-    // If the length of the impact vector is less than the radius of the BallObject...
-    if (glm::length(impactPoint) < one.Radius)
+    unsigned int numBalls = this->ballObjects.Size();
+
+    std::vector<Transform>& ballTransforms = this->ballObjects.Column<Transform>();
+    std::vector<Velocity>& ballVelocities = this->ballObjects.Column<Velocity>();
+    const std::vector<CircleCollider>& ballColliders = this->ballObjects.Column<CircleCollider>();
+    const std::vector<BallState>& ballStates = this->ballObjects.Column<BallState>();
+
+    // If balls were added or removed, start the order over in ball index order
+    if (this->sweepOrder.size() != numBalls)
     {
-        // Return collision true, call the VectorDirection method to calculate Direction then return it, and also return the difference vector
-        return std::make_tuple(true, VectorDirection(impactPoint), impactPoint);
+        this->sweepOrder.resize(numBalls);
+
+        for (unsigned int i = 0; i < numBalls; ++i)
+            this->sweepOrder[i].ballIndex = i;
     }
-    // If the length of the difference vector is equal to or more than the radius of the BallObject...
-    else
-        // Return collision false, Direction UP, and difference vector of zero
-        return std::make_tuple(false, UP, glm::vec2(0.0f, 0.0f));
+
+    // Update each ball's left edge
+    for (SweepEntry& entry : this->sweepOrder)
+    {
+        entry.minX = ballTransforms[entry.ballIndex].position.x;
+    }
+
+    // Insertion sort by left edge
+    // NOTE: The balls only move a little each frame, so the order from the last frame is nearly sorted
+    //       already and this takes close to a single pass (the sort is stable, so ties keep their order)
+    for (unsigned int i = 1; i < numBalls; ++i)
+    {
+        SweepEntry entry = this->sweepOrder[i];
+        unsigned int j = i;
+
+        while (j > 0 && this->sweepOrder[j - 1].minX > entry.minX)
+        {
+            this->sweepOrder[j] = this->sweepOrder[j - 1];
+            --j;
+        }
+
+        this->sweepOrder[j] = entry;
+    }
+
+    // Sweep from left to right: only the balls which start before this ball's right edge can overlap it
+    for (unsigned int i = 0; i < numBalls; ++i)
+    {
+        unsigned int one = this->sweepOrder[i].ballIndex;
+        const BallState& oneState = ballStates[one];
+
+        if (!oneState.isInPlay || oneState.isHeld || oneState.isDestroyed)
+            continue;
+
+        float maxX = this->sweepOrder[i].minX + 2.0f * ballColliders[one].radius;
+
+        for (unsigned int j = i + 1; j < numBalls && this->sweepOrder[j].minX <= maxX; ++j)
+        {
+            unsigned int two = this->sweepOrder[j].ballIndex;
+            const BallState& twoState = ballStates[two];
+
+            if (!twoState.isInPlay || twoState.isHeld || twoState.isDestroyed)
+                continue;
+
+            this->ballPairTests += 1;
+
+            glm::vec2 difference;
+
+            if (!DetectBallCollision(ballTransforms[one].position, ballColliders[one], ballTransforms[two].position, ballColliders[two], difference))
+                continue;
+
+            this->ballPairCollisions += 1;
+
+            // Direction from ball one to ball two, and how far the balls overlap
+            float distance = glm::length(difference);
+            glm::vec2 normal = difference / distance;
+            float overlap = ballColliders[one].radius + ballColliders[two].radius - distance;
+
+            // Push the balls apart (half each) so they do not stick together
+            ballTransforms[one].position -= normal * (overlap * 0.5f);
+            ballTransforms[two].position += normal * (overlap * 0.5f);
+
+            // If the balls are moving toward each other, swap their speeds along the normal
+            // (an elastic collision between two balls of the same mass)
+            float approachSpeed = glm::dot(ballVelocities[two].velocity - ballVelocities[one].velocity, normal);
+
+            if (approachSpeed < 0.0f)
+            {
+                ballVelocities[one].velocity += normal * approachSpeed;
+                ballVelocities[two].velocity -= normal * approachSpeed;
+            }
+        }
+    }
+}
+
+
+// Method to destroy a brick hit by a ball, log the change and add to the score
+// ----------------------------------------------------------------------------
+void Game::DestroyBrick(unsigned int brick_index, unsigned int ball_index)
+{
+    // Points scored for each brick destroyed
+    const unsigned int BRICK_POINTS = 10;
+
+    // Only a brick which was still standing counts
+    if (!this->activeLevel.DestroyBrick(brick_index))
+        return;
+
+    BrickChange change;
+    change.brickIndex = brick_index;
+    change.ballIndex = ball_index;
+    change.time = this->gameTime;
+
+    this->brickChanges.push_back(change);
+    this->score += BRICK_POINTS;
 }
 
 
-// Method to calculate a compass direction based on the point of impact
-//    The goal is to determine which surface of the box-shaped GameObject should exert the primary
-//    influence over the ball's change in direction after impact
+// Method to check whether every brick in the active level has been destroyed
+// NOTE: Uses the level's live brick count, so no bricks are scanned
+// --------------------------------------------------------------------------
+bool Game::IsLevelComplete() const
+{
+    return this->activeLevel.IsCompleted();
+}
+
+
+// Method to run one ball's collision pass against the bricks in the active level
+// NOTE: Updates the position and velocity passed in, and records the index of each brick hit
+//       (in the order the ball hits them) instead of destroying the brick. Only reads the bricks,
+//       so several threads can run it at the same time.
 // -----------------------------------------------------------------------------------------------
-Direction VectorDirection(glm::vec2 impact_point)
+void Game::CollideBallWithBricks(glm::vec2& position, glm::vec2& velocity, const CircleCollider& collider, std::vector<unsigned int>& brick_hits) const
 {
-    // Creating vec2s for the four compass directions
-    glm::vec2 compass[] = {
-        glm::vec2(0.0f, 1.0f),	// Up
-        glm::vec2(1.0f, 0.0f),	// Right
-        glm::vec2(0.0f, -1.0f),	// Down
-        glm::vec2(-1.0f, 0.0f)	// Left
-    };
-
-    // Variables used in calculations below to identify the compass direction which most closely matches the impact point vector
-    // -------------------------------------------------------------------------------------------------------------------------
-    // Variable to store the highest dot product so far. Initializing to zero.
-    float highestValue = 0.0f;
-    // Variable to store the compass direction which most closely matches the impact point. Initializing to -1.
-    unsigned int bestMatch = -1;
-
-    // Loop through the four compass directions
-    for (unsigned int i = 0; i < 4; i++)
-    {
-        // Normalize the impact point vector argument, then calculate the dot product between the normalized vector and the compass direction
-        float dotProduct = glm::dot(glm::normalize(impact_point), compass[i]);
+    // The checks only need each brick's collider and Breakable flag, so loop through just those packed arrays
+    const BoxCollider* brickColliders = this->activeLevel.bricks.Column<BoxCollider>().data();
+    const Breakable* brickStates = this->activeLevel.bricks.Column<Breakable>().data();
+    unsigned int numBricks = this->activeLevel.bricks.Size();
 
-        // If the dot product is greater than the highest value calculated so far...
-        if (dotProduct > highestValue)
+    // Check each brick
+    for (unsigned int i = 0; i < numBricks; ++i)
+    {
+        // If the current brick is not destroyed...
+        if (!brickStates[i].isDestroyed)
         {
-            // Assign the value of highestValue with the dot product calculated through this iteration of the loop
-            highestValue = dotProduct;
-            // Assign the value of bestMatch with the compass direction from this iteration of the loop
-            bestMatch = i;
+            // Create a Collision variable to hold the collision information
+            // Then calling the CheckCollision method which returns a Collision object
+            Collision collision = DetectCircleCollision(position, collider, brickColliders[i]);
+
+            // If the ball collided with the current brick...
+            if (std::get<0>(collision))
+            {
+                // Record the hit (the ball never checks the same brick twice in one pass)
+                unsigned int brickIndex = i;
+                brick_hits.push_back(brickIndex);
+
+                // Calculate the new position and velocity for the ball
+                // ----------------------------------------------------
+
+                // Creating a Direction variable to hold the collision direction
+                Direction direction = std::get<1>(collision);
+
+                // Creating a vec2 variable to hold difference vector for the collision
+                glm::vec2 diff_vector = std::get<2>(collision);
+
+                // If a horizontal collision...
+                if (direction == LEFT || direction == RIGHT)
+                {
+                    // Reverse the horizontal velocity
+                    velocity.x = -velocity.x;
+
+                    // Creating a variable to track how far into the brick the ball penetrated
+                    float penetration = collider.radius - std::abs(diff_vector.x);
+
+                    // If the ball was traveling left...
+                    if (direction == LEFT)
+                    {
+                        // Shift the ball to where the right edge of the brick was
+                        position.x += penetration;
+                    }
+                    // If the ball was traveling right...
+                    else
+                    {
+                        // Shift the ball to where the left edge of the brick was
+                        position.x -= penetration;
+                    }
+                }
+                // If a vertical collision...
+                else
+                {
+                    // Reverse the vertical velocity
+                    velocity.y = -velocity.y;
+
+                    // Creating a variable to track how far into the brick the ball penetrated
+                    float penetration = collider.radius - std::abs(diff_vector.y);
+
+                    // If the ball was traveling up...
+                    if (direction == UP)
+                    {
+                        // Shift the ball to where the bottom edge of the brick was
+                        position.y += penetration;
+                    }
+                    // If the ball was traveling down...
+                    else
+                    {
+                        // Shift the ball to where the top edge of the brick was
+                        position.y -= penetration;
+                    }
+                }
+            }
         }
     }
+}
+
+
+// Method to detect ball and brick collisions on every collision thread, then resolve them in ball order
+// NOTE: Gives exactly the same result as resolving the balls one after another
+// ----------------------------------------------------------------------------------------------------
+void Game::ProcessBrickCollisionsParallel(unsigned int balls_per_task)
+{
+    unsigned int numBalls = this->ballObjects.Size();
+    unsigned int numTasks = (numBalls + balls_per_task - 1) / balls_per_task;
+
+    std::vector<Transform>& ballTransforms = this->ballObjects.Column<Transform>();
+    std::vector<::Velocity>& ballVelocities = this->ballObjects.Column<::Velocity>();
+    std::vector<CircleCollider>& ballColliders = this->ballObjects.Column<CircleCollider>();
+    std::vector<BallState>& ballStates = this->ballObjects.Column<BallState>();
+    std::vector<Breakable>& brickStates = this->activeLevel.bricks.Column<Breakable>();
+
+    this->ballCollisionResults.resize(numBalls);
+
+    for (std::vector<unsigned int>& brickHits : this->workerBrickHits)
+    {
+        brickHits.clear();
+    }
+
+    // Detect pass
+    // -----------
+    // Every ball runs its pass against the bricks as they were at the start of the frame, on a copy of
+    // its position and velocity. The hits go into the buffer of the worker running the task, so the
+    // workers never write to shared data.
+    this->collisionWorkers.Run(numTasks, [&](unsigned int task_index, unsigned int worker_index)
+    {
+        std::vector<unsigned int>& brickHits = this->workerBrickHits[worker_index];
+        unsigned int lastBall = std::min(numBalls, (task_index + 1) * balls_per_task);
+
+        for (unsigned int i = task_index * balls_per_task; i < lastBall; ++i)
+        {
+            BallCollisionResult& result = this->ballCollisionResults[i];
+            result.position = ballTransforms[i].position;
+            result.velocity = ballVelocities[i].velocity;
+            result.workerIndex = worker_index;
+            result.firstHit = static_cast<unsigned int>(brickHits.size());
+
+            // If the current ball is in play and is not destroyed...
+            if (ballStates[i].isInPlay && !ballStates[i].isDestroyed)
+            {
+                this->CollideBallWithBricks(result.position, result.velocity, ballColliders[i], brickHits);
+            }
+
+            result.numHits = static_cast<unsigned int>(brickHits.size()) - result.firstHit;
+        }
+    });
+
+    // Resolve pass
+    // ------------
+    // Go through the balls in index order (the order the single threaded pass uses). Each ball's hits are
+    // already in the order the ball reached them, so the first ball to reach a brick gets credit for it.
+    for (unsigned int i = 0; i < numBalls; ++i)
+    {
+        const BallCollisionResult& result = this->ballCollisionResults[i];
+
+        // A ball which hit nothing keeps its position and velocity
+        if (result.numHits == 0)
+            continue;
+
+        const unsigned int* brickHits = &this->workerBrickHits[result.workerIndex][result.firstHit];
 
-    // After comparing all the compass directions to the impact point vector, return the closest compass direction
-    return (Direction)bestMatch;
-}
\ No newline at end of file
+        // Check whether an earlier ball already destroyed one of the bricks this ball hit
+        bool isConflict = false;
+
+        for (unsigned int j = 0; j < result.numHits; ++j)
+        {
+            if (brickStates[brickHits[j]].isDestroyed)
+            {
+                isConflict = true;
+                break;
+            }
+        }
+
+        // No conflict: the ball's pass is exactly what the single threaded pass would have done
+        if (!isConflict)
+        {
+            for (unsigned int j = 0; j < result.numHits; ++j)
+            {
+                this->DestroyBrick(brickHits[j], i);
+            }
+
+            ballTransforms[i].position = result.position;
+            ballVelocities[i].velocity = result.velocity;
+        }
+        // Conflict: the ball would have bounced differently, so redo its pass against the bricks left now
+        else
+        {
+            this->redoBrickHits.clear();
+            this->CollideBallWithBricks(ballTransforms[i].position, ballVelocities[i].velocity, ballColliders[i], this->redoBrickHits);
+
+            for (unsigned int brickIndex : this->redoBrickHits)
+            {
+                this->DestroyBrick(brickIndex, i);
+            }
+        }
+    }
+}
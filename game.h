@@ -18,38 +18,37 @@
 #ifndef GAME_H
 #define GAME_H
 
-#include "shader.h"
-#include "shape_renderer.h"
 #include "player.h"
 #include "brick_object.h"
 #include "ball_object.h"
 #include "game_level.h"
+#include "collision.h"
+#include "level_pack.h"
+#include "level_watcher.h"
+#include "worker_pool.h"
+#include "render_list.h"
+#include "input_queue.h"
+#include "profiler.h"
+#include "fixed_point.h"
 
 #include <vector>
-#include <tuple>
 
-#include <glad/glad.h>
-#include <GLFW/glfw3.h>
 #include <glm/glm.hpp>
-#include <glm/ext.hpp>
-#include <glm/gtc/matrix_transform.hpp>
 
+// Key codes used by the game (same values as the GLFW_KEY_* constants)
+enum GameKey {
+	KEY_SPACE = 32,
+	KEY_A = 65,
+	KEY_D = 68
+};
 
-// enum used for directions in collision detection
-enum Direction {
-	UP,
-	RIGHT,
-	DOWN,
-	LEFT
+// States of the level progression
+//    PLAYING -> CLEARED (every brick destroyed) -> next level loaded -> PLAYING
+enum LevelState {
+	LEVEL_PLAYING,
+	LEVEL_CLEARED
 };
 
-// typedef used to hold collision information
-// ------------------------------------------
-//   bool: whether or not a collision
-//   Direction: collision direction
-//   vec2: difference between the center and closest point of impact
-//   ---------------------------------------------------------------
-typedef std::tuple<bool, Direction, glm::vec2> Collision; // <collision?, what direction?, difference vector center - closest point>
 
 class Game
 {
@@ -57,6 +56,7 @@ class Game
 public:
 
 	// Fundamental variables used for the game
+	// NOTE: keys holds the keys currently held (updated from the input events, or set directly by replays)
 	bool keys[1024];
 	unsigned int windowWidth;
 	unsigned int windowHeight;
@@ -65,9 +65,97 @@ public:
 	// Timer to manage ball object release events
 	unsigned int ballInPlayTimer;
 
-	// Containers for game levels and ball objects
-	std::vector<GameLevel> levels;
-	std::vector<BallObject> ballObjects;
+	// Player score, and the game time simulated so far (seconds)
+	unsigned int score;
+	float gameTime;
+
+	// Level progression variables
+	// NOTE: levelResets counts the game overs (every ball lost, so the level started again)
+	LevelState levelState;
+	unsigned int levelClearedTimer;
+	unsigned int levelsCleared;
+	unsigned int levelResets;
+
+	// Timings for rare events such as level transitions
+	Profiler profiler;
+
+	// Struct to hold one change to the bricks (which brick was destroyed, by which ball, and when)
+	struct BrickChange
+	{
+		unsigned int brickIndex;
+		unsigned int ballIndex;
+		float time;
+	};
+
+	// Bricks destroyed by the latest ProcessCollisions call, in the order they were destroyed
+	// NOTE: Lets anything caching the bricks (e.g. a brick layer) update only what changed
+	std::vector<BrickChange> brickChanges;
+
+	// The player paddle
+	Player player;
+
+	// Level pack which builds levels in the background
+	LevelPack levelPack;
+
+	// The level currently being played (a copy of the built level from the level pack)
+	GameLevel activeLevel;
+
+	// Watcher which reads level files edited while the game runs (see WatchLevelFiles), and the edits taken from it
+	// NOTE: levelEdits holds the edits the level pack has not taken yet (they are tried again each step)
+	LevelWatcher levelWatcher;
+	std::vector<LevelEdit> levelEdits;
+
+	// Archetype holding the ball objects (one packed array per component)
+	BallArchetype ballObjects;
+
+	// Struct to hold the result of one ball's collision pass against the bricks (see ProcessBrickCollisionsParallel)
+	struct BallCollisionResult
+	{
+		glm::vec2 position;
+		glm::vec2 velocity;
+		unsigned int workerIndex;
+		unsigned int firstHit;
+		unsigned int numHits;
+	};
+
+	// Worker threads used to detect ball and brick collisions
+	WorkerPool collisionWorkers;
+
+	// Struct to hold one ball's place in the sweep and prune order (balls sorted by their left edge)
+	struct SweepEntry
+	{
+		float minX;
+		unsigned int ballIndex;
+	};
+
+	// Balls sorted by their left edge, kept from frame to frame so sorting only has to fix small changes
+	std::vector<SweepEntry> sweepOrder;
+
+	// Number of ball pairs given the narrow phase test, and the number which collided
+	unsigned long long ballPairTests;
+	unsigned long long ballPairCollisions;
+
+	// Struct to hold one ball's place in the fixed point sweep and prune order (see ProcessBallCollisionsFixed)
+	struct FixedSweepEntry
+	{
+		Fixed minX;
+		unsigned int ballIndex;
+	};
+
+	// Balls sorted by their fixed point left edge, used instead of sweepOrder by the deterministic physics mode
+	std::vector<FixedSweepEntry> fixedSweepOrder;
+
+	// Whether the balls are moved and collided with fixed point (integer only) math, see SetFixedPoint
+	bool isFixedPoint;
+
+	// Number of ball and paddle narrow phase tests run, and skipped because the ball was outside the paddle's row
+	unsigned long long paddleTestsRun;
+	unsigned long long paddleTestsSkipped;
+
+	// Buffers used by the collision passes (reused every frame)
+	std::vector<BallCollisionResult> ballCollisionResults;
+	std::vector<std::vector<unsigned int>> workerBrickHits;
+	std::vector<unsigned int> redoBrickHits;
 
 	// Constructor
 	Game(unsigned int window_width, unsigned int window_height);
@@ -76,27 +164,92 @@ public:
 	~Game();
 
 	// Method to initialize the elements which make up the game
+	// NOTE: Defined in game_render.cpp (renderer library) because it sets up OpenGL
 	void InitGame();
 
+	// Method to initialize the player, ball objects and levels without touching OpenGL
+	void InitSimulation();
+
+	// Method to free the shader and shape renderer (call before the OpenGL context is destroyed)
+	// NOTE: Defined in game_render.cpp (renderer library)
+	void ReleaseRenderer();
+
 	// Game Loop Methods
 	// -----------------
 	// Method to process user input
 	void ProcessInput(float dt);
+	// Method to process the key events queued for a frame, moving the player paddle at the time of each event
+	void ProcessInputEvents(InputQueue& input_queue, double step_end, float dt);
+	// Method to apply the key events queued for a frame to the keys array without moving the player paddle
+	void ApplyInputEvents(InputQueue& input_queue, double step_end);
+	// Method to move the player paddle (and any ball it is holding) with the keys currently held
+	void MovePlayer(float dt);
+	// Method to hold or release a ball object when the Space key is pressed
+	void ProcessSpace();
 	// Method to update the game
 	void UpdateGame(float dt);
-	// Method to the game
+	// Method to render the game
+	// NOTE: Defined in game_render.cpp (renderer library)
 	void RenderGame();
 
+	// Method to copy everything needed to draw the current frame into a render state
+	// NOTE: The render state can then be turned into a render list on another thread while the next frame is simulated
+	void CaptureRenderState(RenderState& render_state) const;
+	// Method to draw a render list built from a render state
+	// NOTE: Defined in game_render.cpp (renderer library), must run on the thread which owns the OpenGL context
+	void DrawRenderList(const RenderList& render_list);
+
 	// Method to check and manage collisions
 	void ProcessCollisions();
+	// Method to destroy a brick hit by a ball, log the change and add to the score
+	void DestroyBrick(unsigned int brick_index, unsigned int ball_index);
+	// Method to check whether every brick in the active level has been destroyed
+	bool IsLevelComplete() const;
+	// Method to set the number of threads used to detect ball and brick collisions
+	void SetCollisionThreads(unsigned int num_threads);
+	// Method to run one ball's collision pass against the bricks (records the bricks hit instead of destroying them)
+	void CollideBallWithBricks(glm::vec2& position, glm::vec2& velocity, const CircleCollider& collider, std::vector<unsigned int>& brick_hits) const;
+	// Method to detect ball and brick collisions on every collision thread, then resolve them in ball order
+	void ProcessBrickCollisionsParallel(unsigned int balls_per_task);
+	// Method to bounce moving balls off each other (sweep and prune along x, then circle tests)
+	void ProcessBallCollisions();
+
+	// Deterministic physics methods
+	// NOTE: Defined in game_fixed.cpp
+	// ------------------------------
+	// Method to turn the fixed point physics mode on or off (the float physics are used when off)
+	void SetFixedPoint(bool is_fixed_point);
+	// Method to move the balls and process every collision with fixed point math (replaces MoveBall and ProcessCollisions)
+	void UpdateBallsFixed(float dt);
+	// Method to run one ball's fixed point collision pass against the bricks (records the bricks hit instead of destroying them)
+	void CollideBallWithBricksFixed(FixedBody& body, std::vector<unsigned int>& brick_hits) const;
+	// Method to bounce moving balls off each other with fixed point math
+	void ProcessBallCollisionsFixed();
+	// Method to bounce balls off the player paddle with fixed point math
+	void ProcessPaddleCollisionsFixed();
+	// Method to return a 64-bit hash of the game state (compare the hashes of two runs after each step)
+	uint64_t ComputeStateHash() const;
 
 	// Reset methods
 	// -------------
 	// Method to reset the level
 	void ResetLevel();
+	// Method to move on to the next level once the current level has been cleared (wraps around after the last level)
+	void AdvanceLevel();
+	// Method to replace the ball objects with a fresh set
+	void RefillBalls();
+	// Method to load a level from the level pack and prefetch the level after it
+	void LoadLevel(unsigned int level_index);
 	// Method to reset the player
 	void ResetPlayer();
 
+	// Level hot reload
+	// ----------------
+	// Method to start watching the level files, so edits are patched into the game while it runs
+	bool WatchLevelFiles();
+	// Method to patch the edits read by the level watcher into the levels (returns the number of new edits taken)
+	unsigned int ApplyLevelEdits();
+
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,415 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//  BREAKOUT REMIX
+//  --------------
+//  by slate2b
+//
+//  Deterministic physics for the game.
+//
+//  The float physics (MoveBall and ProcessCollisions) can give slightly
+//  different results with different compilers, compiler flags and CPUs,
+//  e.g. from fused multiply-adds or glm::normalize.  Replays and a
+//  lockstep mode need two machines to stay exactly in step, so this file
+//  holds a second version of the ball physics which only uses fixed point
+//  (integer) math, see fixed_point.h.
+//
+//  Each ball keeps its fixed point position and velocity in its FixedBody
+//  component, and each brick has a fixed point copy of its box in its
+//  FixedBoxCollider component.  The Transform and Velocity components are
+//  updated from the FixedBody after every step so the rest of the game
+//  (drawing, input, the bottom of the screen check) works unchanged.
+//  Balls which are not moving (e.g. held by the paddle) follow the
+//  paddle, so they are picked up from their Transform again every step.
+//
+//  The deterministic physics methods are responsible for the following:
+//
+//     * Moving the balls and bouncing them off the window edges
+//     * Ball - brick, ball - ball and ball - paddle collisions
+//	   * Paddle deflection without float normalize or length
+//	   * A hash of the game state to compare two runs step by step
+//
+///////////////////////////////////////////////////////////////////////////
+
+#include "game.h"
+#include "state_hash.h"
+
+#include <cstring>
+
+
+// Method to turn the fixed point physics mode on or off (the float physics are used when off)
+// NOTE: The balls are picked up from their Transform and Velocity on the next step, and
+//       the float components are always up to date, so the mode can change between any two steps
+// ----------------------------------------------------------------------------------------------
+void Game::SetFixedPoint(bool is_fixed_point)
+{
+    this->isFixedPoint = is_fixed_point;
+
+    for (FixedBody& body : this->ballObjects.Column<FixedBody>())
+    {
+        body.isMoving = false;
+    }
+}
+
+
+// Method to move the balls and process every collision with fixed point math
+// NOTE: Does the same as the MoveBall loop and ProcessCollisions, in the same order
+// ---------------------------------------------------------------------------------
+void Game::UpdateBallsFixed(float dt)
+{
+    // Start a new list of brick changes for this frame
+    this->brickChanges.clear();
+
+    // The time step is the only float coming in (converted once, the same way on every machine)
+    Fixed fixedDt = Fixed::FromFloat(dt);
+    Fixed windowRight = Fixed::FromInt(static_cast<int>(this->windowWidth));
+
+    unsigned int numBalls = this->ballObjects.Size();
+
+    std::vector<Transform>& ballTransforms = this->ballObjects.Column<Transform>();
+    std::vector<Velocity>& ballVelocities = this->ballObjects.Column<Velocity>();
+    const std::vector<CircleCollider>& ballColliders = this->ballObjects.Column<CircleCollider>();
+    const std::vector<BallState>& ballStates = this->ballObjects.Column<BallState>();
+    std::vector<FixedBody>& ballBodies = this->ballObjects.Column<FixedBody>();
+
+    // Move the balls
+    // --------------
+    for (unsigned int i = 0; i < numBalls; ++i)
+    {
+        const BallState& state = ballStates[i];
+        FixedBody& body = ballBodies[i];
+        bool isMoving = state.isInPlay && !state.isHeld && !state.isDestroyed;
+
+        // Pick up balls which were not moving on the last step (held, just released or just reset) from their float components
+        if (!isMoving || !body.isMoving)
+        {
+            body.position = FixedVec2::FromVec2(ballTransforms[i].position);
+            body.velocity = FixedVec2::FromVec2(ballVelocities[i].velocity);
+            body.radius = Fixed::FromFloat(ballColliders[i].radius);
+        }
+
+        body.isMoving = isMoving;
+
+        if (!isMoving)
+            continue;
+
+        // Move the ball based on the ball's current xy velocity
+        body.position += body.velocity * fixedDt;
+
+        // The ball is twice its radius wide
+        Fixed ballWidth = body.radius + body.radius;
+
+        // If past the left or right side of the screen, reverse the x velocity and place the ball in bounds
+        if (body.position.x <= Fixed())
+        {
+            body.velocity.x = -body.velocity.x;
+            body.position.x = Fixed();
+        }
+        else if (body.position.x + ballWidth >= windowRight)
+        {
+            body.velocity.x = -body.velocity.x;
+            body.position.x = windowRight - ballWidth;
+        }
+
+        // If past the top of the screen, reverse the y velocity and place the ball in bounds
+        if (body.position.y <= Fixed())
+        {
+            body.velocity.y = -body.velocity.y;
+            body.position.y = Fixed();
+        }
+    }
+
+    // Check collisions between ball and bricks
+    // ----------------------------------------
+    std::vector<unsigned int>& brickHits = this->workerBrickHits[0];
+
+    for (unsigned int i = 0; i < numBalls; ++i)
+    {
+        // If the current ball is in play and is not destroyed...
+        if (ballStates[i].isInPlay && !ballStates[i].isDestroyed)
+        {
+            // Bounce the ball off the bricks it hits, then destroy those bricks
+            brickHits.clear();
+            this->CollideBallWithBricksFixed(ballBodies[i], brickHits);
+
+            for (unsigned int brickIndex : brickHits)
+            {
+                this->DestroyBrick(brickIndex, i);
+            }
+        }
+    }
+
+    // Check collisions between balls, then between ball and player paddle
+    // -------------------------------------------------------------------
+    this->ProcessBallCollisionsFixed();
+    this->ProcessPaddleCollisionsFixed();
+
+    // Copy the results to the float components used by the rest of the game
+    for (unsigned int i = 0; i < numBalls; ++i)
+    {
+        ballTransforms[i].position = ballBodies[i].position.ToVec2();
+        ballVelocities[i].velocity = ballBodies[i].velocity.ToVec2();
+    }
+}
+
+
+// Method to run one ball's fixed point collision pass against the bricks in the active level
+// NOTE: The same response as CollideBallWithBricks, with the fixed point box of each brick
+// ------------------------------------------------------------------------------------------
+void Game::CollideBallWithBricksFixed(FixedBody& body, std::vector<unsigned int>& brick_hits) const
+{
+    const FixedBoxCollider* brickColliders = this->activeLevel.bricks.Column<FixedBoxCollider>().data();
+    const Breakable* brickStates = this->activeLevel.bricks.Column<Breakable>().data();
+    unsigned int numBricks = this->activeLevel.bricks.Size();
+
+    // Check each brick
+    for (unsigned int i = 0; i < numBricks; ++i)
+    {
+        // Skip the bricks which have been destroyed
+        if (brickStates[i].isDestroyed)
+            continue;
+
+        FixedCollision collision = DetectFixedCircleCollision(body.position, body.radius, brickColliders[i]);
+
+        // If the ball collided with the current brick...
+        if (!std::get<0>(collision))
+            continue;
+
+        // Record the hit (the ball never checks the same brick twice in one pass)
+        brick_hits.push_back(i);
+
+        Direction direction = std::get<1>(collision);
+        FixedVec2 diffVector = std::get<2>(collision);
+
+        // If a horizontal collision, reverse the horizontal velocity and shift the ball out of the brick
+        if (direction == LEFT || direction == RIGHT)
+        {
+            body.velocity.x = -body.velocity.x;
+            Fixed penetration = body.radius - FixedAbs(diffVector.x);
+
+            if (direction == LEFT)
+                body.position.x += penetration;
+            else
+                body.position.x -= penetration;
+        }
+        // If a vertical collision, reverse the vertical velocity and shift the ball out of the brick
+        else
+        {
+            body.velocity.y = -body.velocity.y;
+            Fixed penetration = body.radius - FixedAbs(diffVector.y);
+
+            if (direction == UP)
+                body.position.y += penetration;
+            else
+                body.position.y -= penetration;
+        }
+    }
+}
+
+
+// Method to bounce moving balls off each other with fixed point math
+// NOTE: The same sweep and prune as ProcessBallCollisions, sorted by the fixed point left edges
+// ---------------------------------------------------------------------------------------------
+void Game::ProcessBallCollisionsFixed()
+{
+    unsigned int numBalls = this->ballObjects.Size();
+
+    const std::vector<BallState>& ballStates = this->ballObjects.Column<BallState>();
+    std::vector<FixedBody>& ballBodies = this->ballObjects.Column<FixedBody>();
+
+    // If balls were added or removed, start the order over in ball index order
+    if (this->fixedSweepOrder.size() != numBalls)
+    {
+        this->fixedSweepOrder.resize(numBalls);
+
+        for (unsigned int i = 0; i < numBalls; ++i)
+            this->fixedSweepOrder[i].ballIndex = i;
+    }
+
+    // Update each ball's left edge
+    for (FixedSweepEntry& entry : this->fixedSweepOrder)
+    {
+        entry.minX = ballBodies[entry.ballIndex].position.x;
+    }
+
+    // Insertion sort by left edge (nearly sorted from the last frame, and stable)
+    for (unsigned int i = 1; i < numBalls; ++i)
+    {
+        FixedSweepEntry entry = this->fixedSweepOrder[i];
+        unsigned int j = i;
+
+        while (j > 0 && this->fixedSweepOrder[j - 1].minX > entry.minX)
+        {
+            this->fixedSweepOrder[j] = this->fixedSweepOrder[j - 1];
+            --j;
+        }
+
+        this->fixedSweepOrder[j] = entry;
+    }
+
+    // Sweep from left to right: only the balls which start before this ball's right edge can overlap it
+    for (unsigned int i = 0; i < numBalls; ++i)
+    {
+        unsigned int one = this->fixedSweepOrder[i].ballIndex;
+        const BallState& oneState = ballStates[one];
+
+        if (!oneState.isInPlay || oneState.isHeld || oneState.isDestroyed)
+            continue;
+
+        FixedBody& oneBody = ballBodies[one];
+        Fixed maxX = this->fixedSweepOrder[i].minX + oneBody.radius + oneBody.radius;
+
+        for (unsigned int j = i + 1; j < numBalls && this->fixedSweepOrder[j].minX <= maxX; ++j)
+        {
+            unsigned int two = this->fixedSweepOrder[j].ballIndex;
+            const BallState& twoState = ballStates[two];
+
+            if (!twoState.isInPlay || twoState.isHeld || twoState.isDestroyed)
+                continue;
+
+            this->ballPairTests += 1;
+
+            FixedBody& twoBody = ballBodies[two];
+            FixedVec2 difference;
+
+            if (!DetectFixedBallCollision(oneBody.position, oneBody.radius, twoBody.position, twoBody.radius, difference))
+                continue;
+
+            this->ballPairCollisions += 1;
+
+            // Direction from ball one to ball two, and how far the balls overlap
+            // NOTE: The distance is at least 1/65536, because balls with the same center never collide
+            Fixed distance = FixedLength(difference);
+            FixedVec2 normal(difference.x / distance, difference.y / distance);
+            Fixed overlap = oneBody.radius + twoBody.radius - distance;
+
+            // Push the balls apart (half each) so they do not stick together
+            FixedVec2 push = normal * Fixed::FromRaw(overlap.raw / 2);
+            oneBody.position -= push;
+            twoBody.position += push;
+
+            // If the balls are moving toward each other, swap their speeds along the normal
+            Fixed approachSpeed = FixedDot(twoBody.velocity - oneBody.velocity, normal);
+
+            if (approachSpeed < Fixed())
+            {
+                oneBody.velocity += normal * approachSpeed;
+                twoBody.velocity -= normal * approachSpeed;
+            }
+        }
+    }
+}
+
+
+// Method to bounce balls off the player paddle with fixed point math
+// NOTE: The deflection keeps the ball's speed by scaling the new velocity to the old length,
+//       using the integer square root, instead of glm::normalize and glm::length
+// ------------------------------------------------------------------------------------------
+void Game::ProcessPaddleCollisionsFixed()
+{
+    // Fixed point box of the paddle (the paddle itself is moved by the input methods)
+    FixedVec2 paddlePosition = FixedVec2::FromVec2(this->player.Position);
+    FixedVec2 paddleSize = FixedVec2::FromVec2(this->player.Size);
+
+    FixedBoxCollider paddleBox;
+    paddleBox.halfExtents = FixedVec2(Fixed::FromRaw(paddleSize.x.raw / 2), Fixed::FromRaw(paddleSize.y.raw / 2));
+    paddleBox.center = paddlePosition + paddleBox.halfExtents;
+
+    // No margin is needed around the paddle's row, because the fixed point math has no rounding surprises
+    Fixed paddleRowTop = paddlePosition.y;
+    Fixed paddleRowBottom = paddlePosition.y + paddleSize.y;
+
+    unsigned int numBalls = this->ballObjects.Size();
+
+    const std::vector<BallState>& ballStates = this->ballObjects.Column<BallState>();
+    std::vector<FixedBody>& ballBodies = this->ballObjects.Column<FixedBody>();
+
+    for (unsigned int i = 0; i < numBalls; ++i)
+    {
+        // If the current ball is in play and is not destroyed...
+        if (!ballStates[i].isInPlay || ballStates[i].isDestroyed)
+            continue;
+
+        FixedBody& body = ballBodies[i];
+
+        // Skip the ball if it is entirely above or below the paddle's row
+        Fixed ballTop = body.position.y;
+        Fixed ballBottom = ballTop + body.radius + body.radius;
+
+        if (ballBottom < paddleRowTop || ballTop > paddleRowBottom)
+        {
+            this->paddleTestsSkipped += 1;
+            continue;
+        }
+
+        this->paddleTestsRun += 1;
+
+        FixedCollision result = DetectFixedCircleCollision(body.position, body.radius, paddleBox);
+
+        // If the player paddle is not holding the ball and collision is true
+        if (!ballStates[i].isHeld && std::get<0>(result))
+        {
+            // Variables used to determine difference between point of impact and the center of the paddle
+            Fixed diffDistance = (body.position.x + body.radius) - paddleBox.center.x;
+            Fixed diffPercentage = diffDistance / paddleBox.halfExtents.x;
+
+            // Variables used to determine amount of change in velocity
+            Fixed initialBallVelocityX = Fixed::FromInt(100);
+            Fixed strength = Fixed::FromInt(2);
+            Fixed oldSpeed = FixedLength(body.velocity);
+
+            // Update the ball's velocity based on the point of impact on the paddle, keeping the old speed
+            body.velocity.x = initialBallVelocityX * diffPercentage * strength;
+            body.velocity = FixedScaleToLength(body.velocity, oldSpeed);
+
+            // Adjust vertical velocity to compensate for sticky paddle effect
+            body.velocity.y = -FixedAbs(body.velocity.y);
+        }
+    }
+}
+
+
+// Method to return a 64-bit hash of the game state (compare the hashes of two runs after each step)
+// NOTE: Covers the level progress, timers, score, paddle, every ball (and its fixed point body in the
+//       fixed point mode) and the live brick bits.  Each piece is hashed straight from its packed
+//       array, so the cost is a few hundred bytes of hashing for a normal level.
+// ----------------------------------------------------------------------------------------------------
+uint64_t Game::ComputeStateHash() const
+{
+    StateHasher hasher;
+
+    // The level progress, timers, score and paddle, as 32-bit words (floats by their bit patterns)
+    uint32_t words[10];
+    words[0] = this->currentLevel;
+    words[1] = static_cast<uint32_t>(this->levelState);
+    words[2] = this->levelClearedTimer;
+    words[3] = this->ballInPlayTimer;
+    words[4] = this->score;
+    words[5] = this->activeLevel.liveBricks;
+    words[6] = this->ballObjects.Size();
+    std::memcpy(&words[7], &this->gameTime, sizeof(float));
+    std::memcpy(&words[8], &this->player.Position.x, sizeof(float));
+    std::memcpy(&words[9], &this->player.Position.y, sizeof(float));
+    hasher.Update(words, sizeof(words));
+
+    // The balls (the Transform, Velocity and BallState components have no padding, so each array is hashed in one go)
+    unsigned int numBalls = this->ballObjects.Size();
+    hasher.Update(this->ballObjects.Column<Transform>().data(), numBalls * sizeof(Transform));
+    hasher.Update(this->ballObjects.Column<Velocity>().data(), numBalls * sizeof(Velocity));
+    hasher.Update(this->ballObjects.Column<BallState>().data(), numBalls * sizeof(BallState));
+
+    // The fixed point position and velocity of each ball (the rest of the FixedBody has padding)
+    if (this->isFixedPoint)
+    {
+        for (const FixedBody& body : this->ballObjects.Column<FixedBody>())
+        {
+            hasher.Update(&body.position, sizeof(FixedVec2));
+            hasher.Update(&body.velocity, sizeof(FixedVec2));
+        }
+    }
+
+    // The bricks which are still standing (one bit per brick)
+    const std::vector<uint64_t>& liveBrickBits = this->activeLevel.liveBrickBits;
+    hasher.Update(liveBrickBits.data(), liveBrickBits.size() * sizeof(uint64_t));
+
+    return hasher.Digest();
+}
@@ -13,6 +13,7 @@
 // 
 //     * Loading the level from file
 //     * Storing data for the bricks in the current level
+//     * Patching the bricks when the level file changes
 //	   * Drawing the level (the bricks)
 //
 ///////////////////////////////////////////////////////////////////////////
@@ -21,6 +22,28 @@
 
 #include <fstream>
 #include <sstream>
+#include <utility>
+
+
+// Method to return the color of a brick of a tile type (white for unknown types)
+// ------------------------------------------------------------------------------
+static glm::vec3 TileColor(unsigned int tile_type)
+{
+    if (tile_type == 1)
+        return glm::vec3(0.7f, 0.3f, 0.2f);
+    else if (tile_type == 2)
+        return glm::vec3(0.8f, 0.4f, 0.2f);
+    else if (tile_type == 3)
+        return glm::vec3(0.7f, 0.5f, 0.2f);
+    else if (tile_type == 4)
+        return glm::vec3(0.7f, 0.7f, 0.2f);
+    else if (tile_type == 5)
+        return glm::vec3(0.2f, 0.7f, 0.2f);
+    else if (tile_type == 6)
+        return glm::vec3(0.2f, 0.3f, 0.7f);
+
+    return glm::vec3(1.0f);
+}
 
 
 // Method to load level data from file based on tilemap concept
@@ -39,76 +62,91 @@ void GameLevel::Load(const char* file, unsigned int level_width, unsigned int le
     // ---------------------------------
 
 	// Clear any pre-existing level data
-	this->bricks.clear();
+	this->bricks.Clear();
+	this->liveBricks = 0;
+	this->liveBrickBits.clear();
+	this->tiles.clear();
+	this->tileColumns = 0;
+
+    // Read the tile data from the file
+    std::vector<std::vector<unsigned int>> tileData;
+
+    // As long as the file could be read and the tileData 2D vector is not empty,
+    // call the InitLevel method based on the loaded tileData
+    if (ReadTileData(file, tileData) && tileData.size() > 0)
+        this->InitLevel(tileData, level_width, level_height);
+
+}
 
+// Method to read the tile data of a level file (returns false if the file could not be opened)
+// NOTE: Every line of the file becomes one row of tile_data_out
+bool GameLevel::ReadTileData(const char* file, std::vector<std::vector<unsigned int>>& tile_data_out)
+{
     // Variables used to load level data
     // ---------------------------------
     // Creating variable to hold the code which differentiates the different tiles
     unsigned int tileType;
-    // Creating a GameLevel object
-    GameLevel level;
     // Creating a string to hold a single line of data
     std::string line;
     // Creating a ifstream to read data from file
     std::ifstream fstream(file);
-    // Creating a 2D std::vector to hold the data from the file
-    std::vector<std::vector<unsigned int>> tileData;
 
-    // Load data from file
-    if (fstream)
-    {
-        // While there are still lines to read in the file
-        while (std::getline(fstream, line))
-        {
-            // Creating a istringstream to read data from the current line of the file
-            std::istringstream sstream(line);
-            // Creating a std::vector to hold a single row of tile data
-            std::vector<unsigned int> row;
+    tile_data_out.clear();
 
-            // While there is still tile data to read in the current line
-            while (sstream >> tileType)
-            {
-                // Add the tileType to the current row vector
-                row.push_back(tileType);
-            }
+    if (!fstream)
+        return false;
+
+    // While there are still lines to read in the file
+    while (std::getline(fstream, line))
+    {
+        // Creating a istringstream to read data from the current line of the file
+        std::istringstream sstream(line);
+        // Creating a std::vector to hold a single row of tile data
+        std::vector<unsigned int> row;
 
-            // Add the data for the row we just read to the tileData 2D vector 
-            tileData.push_back(row);
+        // While there is still tile data to read in the current line
+        while (sstream >> tileType)
+        {
+            // Add the tileType to the current row vector
+            row.push_back(tileType);
         }
 
-        // Once finished, as long as the tileData 2D vector is not empty, 
-        // call the InitLevel method based on the loaded tileData
-        if (tileData.size() > 0)
-            this->InitLevel(tileData, level_width, level_height);
+        // Add the data for the row we just read to the tileData 2D vector
+        tile_data_out.push_back(row);
     }
 
+    return true;
 }
 
-// Method to render the bricks in the level
-void GameLevel::DrawLevel(ShapeRenderer& shape_renderer, Shader& shader)
+// Method to build the level from tile data already held in memory (e.g. from the LevelGenerator)
+// NOTE: level_width and level_height refer to the width and height of the collection of bricks to be broken
+void GameLevel::LoadTileData(const std::vector<std::vector<unsigned int>>& tile_data, unsigned int level_width, unsigned int level_height)
 {
-    // Loop through all the bricks (tiles) in the bricks std::vector container
-    for (BrickObject& tile : this->bricks)
-    {
-        // If the brick is NOT destroyed
-        if (!tile.isDestroyed)
-        {
-            // Draw it
-            tile.DrawBrick(shape_renderer, shader);
-        }
-    }
+    // Clear any pre-existing level data
+    this->bricks.Clear();
+    this->liveBricks = 0;
+    this->liveBrickBits.clear();
+    this->tiles.clear();
+    this->tileColumns = 0;
+
+    // As long as the tile data is not empty, call the InitLevel method based on the tile data
+    if (tile_data.size() > 0)
+        this->InitLevel(tile_data, level_width, level_height);
 }
 
-// Method to initialize the level by populating the bricks std::vector container which holds all bricks data for the level
+// Method to initialize the level by populating the bricks archetype which holds all bricks data for the level
 // NOTE: level_width and level_height refer to the width and height of the collection of bricks to be broken
-void GameLevel::InitLevel(std::vector<std::vector<unsigned int>> tile_data, unsigned int level_width, unsigned int level_height) 
+void GameLevel::InitLevel(const std::vector<std::vector<unsigned int>>& tile_data, unsigned int level_width, unsigned int level_height) 
 {
     // Variables for initializing the level
     unsigned int height = tile_data.size();    // Number of rows from the tile data 2D vector
     unsigned int width = tile_data[0].size();  // Number of columns from the tile data 2D vector
-    float tile_height = level_height / height; // Tile height is determined by level_height and the number of rows
+    float tile_height = level_height / static_cast<float>(height); // Tile height is determined by level_height and the number of rows
     float tile_width = level_width / static_cast<float>(width); // tile width is determined by level_width and the number of columns
 
+    // Reserve space for every tile up front so large levels do not repeatedly reallocate the container
+    this->bricks.Reserve(this->bricks.Size() + height * width);
+
 
     // Loop through each row		
     for (unsigned int y = 0; y < height; ++y)
@@ -120,7 +158,6 @@ void GameLevel::InitLevel(std::vector<std::vector<unsigned int>> tile_data, unsi
             glm::vec3 color = glm::vec3(1.0f);   // Initializing to white, but changing below
             glm::vec2 pos(tile_width * x, tile_height * y); // Assigning the position per tile data
             glm::vec2 size(tile_width, tile_height); // Assigning the size based on calculated tile dimensions
-            glm::vec2 velocity(0.0f, 0.0f);  // Assigning zero velocity. No moving bricks in the current implementation
             bool is_destroyed = false;  // Initializing to false, but changing below for tile type zero
             
             // Check the tile type for the current cell
@@ -134,9 +171,8 @@ void GameLevel::InitLevel(std::vector<std::vector<unsigned int>> tile_data, unsi
                 //   making it essentially an empty space
                 is_destroyed = true; 
 
-                // Calling the BrickObject constructor with isDestroyed set to true,
-                //   then adding the brick to the bricks std::vector container
-                this->bricks.push_back(BrickObject(pos, size, color, velocity, is_destroyed));
+                // Adding the brick to the bricks archetype with isDestroyed set to true
+                BrickObject::Create(this->bricks, pos, size, color, is_destroyed);
             }
             // For all other bricks, the only differentiator is the color
             else
@@ -146,23 +182,127 @@ void GameLevel::InitLevel(std::vector<std::vector<unsigned int>> tile_data, unsi
 
                 // Assign the brick's color based on the tile type
                 // -----------------------------------------------
-                if (tile_data[y][x] == 1)
-                    color = glm::vec3(0.7f, 0.3f, 0.2f);
-                else if (tile_data[y][x] == 2)
-                    color = glm::vec3(0.8f, 0.4f, 0.2f);
-                else if (tile_data[y][x] == 3)
-                    color = glm::vec3(0.7f, 0.5f, 0.2f);
-                else if (tile_data[y][x] == 4)
-                    color = glm::vec3(0.7f, 0.7f, 0.2f);
-                else if (tile_data[y][x] == 5)
-                    color = glm::vec3(0.2f, 0.7f, 0.2f);
-                else if (tile_data[y][x] == 6)
-                    color = glm::vec3(0.2f, 0.3f, 0.7f);
-
-                // Calling the BrickObject constructor with isDestroyed set to false,
-                //   then adding the brick to the bricks std::vector container
-                this->bricks.push_back(BrickObject(pos, size, color, velocity, is_destroyed));
+                color = TileColor(tile_data[y][x]);
+
+                // Adding the brick to the bricks archetype with isDestroyed set to false
+                BrickObject::Create(this->bricks, pos, size, color, is_destroyed);
+                this->liveBricks += 1;
+            }
+        }
+    }
+
+    // Keep the tile types the bricks were built from, so the level can be patched when its file changes
+    this->tileColumns = width;
+    this->tiles.reserve(this->tiles.size() + height * width);
+
+    for (unsigned int y = 0; y < height; ++y)
+        this->tiles.insert(this->tiles.end(), tile_data[y].begin(), tile_data[y].begin() + width);
+
+    // Set the live brick bit of every brick which was not added as an empty space
+    const std::vector<Breakable>& brickStates = this->bricks.Column<Breakable>();
+    unsigned int numBricks = this->bricks.Size();
+    this->liveBrickBits.assign((numBricks + 63) / 64, 0);
+
+    for (unsigned int i = 0; i < numBricks; ++i)
+    {
+        if (!brickStates[i].isDestroyed)
+            this->liveBrickBits[i / 64] |= static_cast<uint64_t>(1) << (i % 64);
+    }
+}
+
+
+// Method to destroy a brick (returns false if it was already destroyed)
+// ---------------------------------------------------------------------
+bool GameLevel::DestroyBrick(unsigned int brick_index)
+{
+    Breakable& brickState = this->bricks.Get<Breakable>(brick_index);
+
+    if (brickState.isDestroyed)
+        return false;
+
+    brickState.isDestroyed = true;
+    this->liveBricks -= 1;
+    this->liveBrickBits[brick_index / 64] &= ~(static_cast<uint64_t>(1) << (brick_index % 64));
+
+    return true;
+}
+
+
+// Method to patch the level to new tile data of the same size, changing only the bricks whose tile type changed
+// NOTE: A changed brick comes back as a fresh brick of its new type (even if it was destroyed during play), while
+//       unchanged bricks keep their state.  Bricks never move, so only the color, Breakable flag and live brick
+//       bit of a changed brick are touched.  Returns false (changing nothing) if the size of the grid changed.
+// ----------------------------------------------------------------------------------------------------------------
+bool GameLevel::PatchTiles(const std::vector<std::vector<unsigned int>>& tile_data, unsigned int& changed_out)
+{
+    changed_out = 0;
+
+    unsigned int height = static_cast<unsigned int>(tile_data.size());
+
+    if (this->tileColumns == 0 || height * this->tileColumns != this->tiles.size())
+        return false;
+
+    for (const std::vector<unsigned int>& row : tile_data)
+    {
+        if (row.size() != this->tileColumns)
+            return false;
+    }
+
+    for (unsigned int y = 0; y < height; ++y)
+    {
+        for (unsigned int x = 0; x < this->tileColumns; ++x)
+        {
+            // Bricks were added row by row, one per tile
+            unsigned int brickIndex = y * this->tileColumns + x;
+            unsigned int tileType = tile_data[y][x];
+
+            if (tileType == this->tiles[brickIndex])
+                continue;
+
+            this->tiles[brickIndex] = tileType;
+            changed_out += 1;
+
+            // Empty spaces are destroyed bricks (white, as InitLevel adds them)
+            if (tileType == 0)
+            {
+                this->bricks.Get<Renderable>(brickIndex).color = glm::vec3(1.0f);
+                this->DestroyBrick(brickIndex);
+                continue;
+            }
+
+            this->bricks.Get<Renderable>(brickIndex).color = TileColor(tileType);
+
+            // Bring the brick back if it was an empty space or was destroyed during play
+            Breakable& brickState = this->bricks.Get<Breakable>(brickIndex);
+
+            if (brickState.isDestroyed)
+            {
+                brickState.isDestroyed = false;
+                this->liveBricks += 1;
+                this->liveBrickBits[brickIndex / 64] |= static_cast<uint64_t>(1) << (brickIndex % 64);
             }
         }
     }
-}
\ No newline at end of file
+
+    return true;
+}
+
+
+// Method to check whether every brick in the level has been destroyed
+// -------------------------------------------------------------------
+bool GameLevel::IsCompleted() const
+{
+    return this->liveBricks == 0;
+}
+
+
+// Method to swap the bricks (and live brick count, bits and tiles) of two levels without copying them
+// --------------------------------------------------------------------------------------------------
+void GameLevel::Swap(GameLevel& other)
+{
+    this->bricks.Swap(other.bricks);
+    std::swap(this->liveBricks, other.liveBricks);
+    this->liveBrickBits.swap(other.liveBrickBits);
+    this->tiles.swap(other.tiles);
+    std::swap(this->tileColumns, other.tileColumns);
+}
@@ -13,6 +13,7 @@
 // 
 //     * Loading the level from file
 //     * Storing data for the bricks in the current level
+//     * Patching the bricks when the level file changes
 //	   * Drawing the level (the bricks)
 //
 ///////////////////////////////////////////////////////////////////////////
@@ -20,13 +21,12 @@
 #ifndef GAMELEVEL_H
 #define GAMELEVEL_H
 
+#include <cstdint>
 #include <vector>
 
-#include <glad/glad.h>
 #include <glm/glm.hpp>
 
 #include "brick_object.h"
-#include "shape_renderer.h"
 
 
 class GameLevel
@@ -34,24 +34,57 @@ class GameLevel
 
 public:
 
-	// vector<BrickObject> container to store brick data for the level
-	std::vector<BrickObject> bricks;
+	// Archetype to store brick data for the level (one packed array per component)
+	BrickArchetype bricks;
 
-	// Default Constructor (not used)
-	GameLevel() {};
+	// Number of bricks which have not been destroyed (kept up to date by DestroyBrick, so it never needs a scan)
+	unsigned int liveBricks;
+
+	// One bit per brick, set while the brick has not been destroyed (bit i % 64 of word i / 64)
+	// NOTE: A packed copy of the Breakable flags, small enough to hash every step (see Game::ComputeStateHash)
+	std::vector<uint64_t> liveBrickBits;
+
+	// Tile types the bricks were built from, row by row with tileColumns tiles per row (brick i was built from tiles[i])
+	// NOTE: Kept so the level can be patched when its file changes, see PatchTiles
+	std::vector<unsigned int> tiles;
+	unsigned int tileColumns;
+
+	// Default Constructor (an empty level)
+	GameLevel() : liveBricks(0), tileColumns(0) {};
 
 	// Method to load level data from file based on tilemap concept
 	// NOTE: level_width and level_height refer to the width and height of the collection of bricks to be broken
 	void Load(const char* file, unsigned int level_width, unsigned int level_height);
 
 	// Method to render the level
+	// NOTE: Defined in game_render.cpp (renderer library)
 	void DrawLevel(ShapeRenderer& shape_renderer, Shader& shader);
 
+	// Method to build the level from tile data already held in memory (e.g. from the LevelGenerator)
+	// NOTE: level_width and level_height refer to the width and height of the collection of bricks to be broken
+	void LoadTileData(const std::vector<std::vector<unsigned int>>& tile_data, unsigned int level_width, unsigned int level_height);
+
+	// Method to read the tile data of a level file (returns false if the file could not be opened)
+	static bool ReadTileData(const char* file, std::vector<std::vector<unsigned int>>& tile_data_out);
+
+	// Method to patch the level to new tile data, changing only the bricks whose tile type changed
+	// NOTE: Returns false (changing nothing) if the size of the grid changed, so the level must be built again
+	bool PatchTiles(const std::vector<std::vector<unsigned int>>& tile_data, unsigned int& changed_out);
+
+	// Method to destroy a brick (returns false if it was already destroyed)
+	bool DestroyBrick(unsigned int brick_index);
+
+	// Method to check whether every brick in the level has been destroyed
+	bool IsCompleted() const;
+
+	// Method to swap the bricks (and live brick count, bits and tiles) of two levels without copying them
+	void Swap(GameLevel& other);
+
 private:
 
 	// Method to initialize the level
 	// NOTE: level_width and level_height refer to the width and height of the collection of bricks to be broken
-	void InitLevel(std::vector<std::vector<unsigned int>> tile_data, unsigned int level_width, unsigned int level_height);
+	void InitLevel(const std::vector<std::vector<unsigned int>>& tile_data, unsigned int level_width, unsigned int level_height);
 };
 
 #endif
\ No newline at end of file
@@ -4,12 +4,11 @@
 //  --------------
 //  by slate2b
 //
-//  The GameObject class is the base class for the interactable objects in
-//  the game: 
-// 
-//		* The player paddle
-//		* The ball
-//		* The bricks
+//  The GameObject class is the base class for the player paddle.
+//
+//  NOTE: The balls and bricks are not GameObjects.  They are stored as
+//        components in archetypes (see archetype.h), and the BallObject
+//        and BrickObject classes are thin views of those components.
 //
 ///////////////////////////////////////////////////////////////////////////
 
@@ -26,8 +25,6 @@ GameObject::GameObject()
 	Color.z = 1.0f;
 	Velocity.x = 0.0f;
 	Velocity.y = 0.0f;
-	isBreakable = true;
-	isDestroyed = false;
 }
 
 GameObject::GameObject(glm::vec2 pos, glm::vec2 size, glm::vec3 color, glm::vec2 velocity)
@@ -36,27 +33,4 @@ GameObject::GameObject(glm::vec2 pos, glm::vec2 size, glm::vec3 color, glm::vec2
 	Size = size;
 	Color = color;
 	Velocity = velocity;
-	isBreakable = true;
-	isDestroyed = false;
-}
-
-GameObject::GameObject(glm::vec2 pos, glm::vec2 size, glm::vec3 color, glm::vec2 velocity, bool is_destroyed)
-{
-	Position = pos;
-	Size = size;
-	Color = color;
-	Velocity = velocity;
-	isBreakable = true;
-	isDestroyed = is_destroyed;
 }
-
-GameObject::~GameObject()
-{
-
-}
-
-// Method to draw a game object (virtual)
-void GameObject::DrawObject(ShapeRenderer& shape_renderer, Shader& shader)
-{
-	shape_renderer.DrawShape(this->Position, this->Size, this->Color, shader);
-}
\ No newline at end of file
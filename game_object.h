@@ -4,22 +4,24 @@
 //  --------------
 //  by slate2b
 //
-//  The GameObject class is the base class for the interactable objects in
-//  the game: 
-// 
-//		* The player paddle
-//		* The ball
-//		* The bricks
+//  The GameObject class is the base class for the player paddle.
+//
+//  NOTE: The balls and bricks are not GameObjects.  They are stored as
+//        components in archetypes (see archetype.h), and the BallObject
+//        and BrickObject classes are thin views of those components.
 //
 ///////////////////////////////////////////////////////////////////////////
 
 #ifndef GAMEOBJECT_H
 #define GAMEOBJECT_H
 
-#include <glad/glad.h>
+#include <type_traits>
+
 #include <glm/glm.hpp>
 
-#include "shape_renderer.h"
+// Forward declarations for the renderer classes (only needed by the draw methods)
+class ShapeRenderer;
+class Shader;
 
 class GameObject
 {
@@ -30,8 +32,6 @@ public:
 	glm::vec2 Size;
 	glm::vec2 Velocity;
 	glm::vec3 Color;
-	bool isBreakable;
-	bool isDestroyed;
 
 	// Default Constructor
 	GameObject();
@@ -39,17 +39,17 @@ public:
 	// Constructor # 2 
 	GameObject(glm::vec2 pos, glm::vec2 size, glm::vec3 color, glm::vec2 velocity);
 
-	// Constructor # 3 (for bricks)
-	GameObject(glm::vec2 pos, glm::vec2 size, glm::vec3 color, glm::vec2 velocity, bool is_destroyed);
-
-	// Destructor
-	~GameObject();
-
-	// Method to draw a game object (virtual)
-	virtual void DrawObject(ShapeRenderer& shape_renderer, Shader& shader);
+	// Method to draw a game object
+	// NOTE: Defined in game_render.cpp (renderer library)
+	void DrawObject(ShapeRenderer& shape_renderer, Shader& shader);
 
 };
 
+// Game objects are plain data: every draw and update call is resolved at compile time, so
+// objects carry no vtable pointer and can be copied with memcpy (e.g. for game state snapshots)
+static_assert(!std::is_polymorphic<GameObject>::value, "GameObject must not have virtual methods");
+static_assert(std::is_trivially_copyable<GameObject>::value, "GameObject must stay trivially copyable");
+
 
 
 
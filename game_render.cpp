@@ -0,0 +1,170 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//  BREAKOUT REMIX 
+//  --------------
+//  by slate2b
+//
+//  Rendering for the game.
+// 
+//  This file holds every method which talks to OpenGL, so that the rest
+//  of the game (the simulation) can be built and run without a window.
+//  It is part of the breakout_gl renderer library.
+// 
+//  The rendering methods are responsible for the following:
+// 
+//     * Creating the shader and the shape renderer
+//     * Sending the projection matrix to the shader
+//	   * Drawing the game objects (player paddle, balls and bricks)
+//	   * Drawing the level (the bricks)
+//	   * Drawing prepared render lists
+//     * Freeing the shader and the shape renderer
+//
+///////////////////////////////////////////////////////////////////////////
+
+#include "game.h"
+#include "shader.h"
+#include "shape_renderer.h"
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <glm/ext.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+////////////////////////////////////////
+// 
+// Pointers for fundamental game objects
+//
+////////////////////////////////////////
+
+Shader* shader;
+ShapeRenderer* shapeRenderer;
+
+/////////////////////
+//
+// Game Rendering
+//
+/////////////////////
+
+// Method to initialize the elements which make up the game
+// --------------------------------------------------------
+void Game::InitGame()
+{
+	// Calling the Shader constructor for the game's shader pointer (declared at top of game_render.cpp file)
+	shader = new Shader();
+
+	// Tell the GPU to use this shader
+	shader->Use();
+
+	// Initialze a mat4 for the game's projection matrix
+	glm::mat4 projection = glm::ortho(0.0f, static_cast<float>(this->windowWidth),
+		static_cast<float>(this->windowHeight), 0.0f, -1.0f, 1.0f);
+
+	// Send the projection matrix to the vertex shader using the projection uniform
+	glUniformMatrix4fv(glGetUniformLocation(shader->shaderId, "projection"), 1, false, glm::value_ptr(projection));
+
+	// Calling the ShapeRenderer constructor for the game's shapeRenderer pointer (declared at top of game_render.cpp file)
+	shapeRenderer = new ShapeRenderer(*shader);
+
+	// Initialize the non-rendering elements of the game
+	this->InitSimulation();
+}
+
+
+// Method to render the game
+// -------------------------
+void Game::RenderGame()
+{
+    // Draw (the bricks for) the current level
+    this->activeLevel.DrawLevel(*shapeRenderer, *shader);
+
+    // Draw the player
+    this->player.DrawPlayer(*shapeRenderer, *shader);
+
+    // Loop through all the ball objects
+    for (BallObject ball_object : this->ballObjects)
+    {
+        // If the ball object is in play and is NOT destroyed
+        if (ball_object.isInPlay && !ball_object.isDestroyed)
+        {
+            // Draw the ball object
+            ball_object.DrawBall(*shapeRenderer, *shader);
+        }
+    }
+}
+
+
+// Method to draw a render list built from a render state
+// -------------------------------------------------------
+void Game::DrawRenderList(const RenderList& render_list)
+{
+    // The shapes are already in draw order, so only the OpenGL calls are left to make
+    for (const ShapeInstance& shape : render_list.shapes)
+    {
+        shapeRenderer->DrawShape(shape.position, shape.size, shape.color, *shader);
+    }
+}
+
+
+// Method to free the shader and shape renderer (call before the OpenGL context is destroyed)
+// ------------------------------------------------------------------------------------------
+void Game::ReleaseRenderer()
+{
+	delete shapeRenderer;
+	shapeRenderer = nullptr;
+
+	delete shader;
+	shader = nullptr;
+}
+
+
+/////////////////////
+//
+// Object Rendering
+//
+/////////////////////
+
+// Method to draw a game object
+void GameObject::DrawObject(ShapeRenderer& shape_renderer, Shader& shader)
+{
+	shape_renderer.DrawShape(this->Position, this->Size, this->Color, shader);
+}
+
+// Method to draw the ball object
+void BallObject::DrawBall(ShapeRenderer& shape_renderer, Shader& shader)
+{
+    shape_renderer.DrawShape(this->Position, this->Size, this->Color, shader);
+}
+
+// Method to draw the brick
+void BrickObject::DrawBrick(ShapeRenderer& shape_renderer, Shader& shader)
+{
+	shape_renderer.DrawShape(this->Position, this->Size, this->Color, shader);
+}
+
+// Method to draw the player
+void Player::DrawPlayer(ShapeRenderer& shape_renderer, Shader& shader)
+{
+	// Calling the GameObject class's Draw method
+	this->DrawObject(shape_renderer, shader);
+}
+
+// Method to render the bricks in the level
+void GameLevel::DrawLevel(ShapeRenderer& shape_renderer, Shader& shader)
+{
+    // Drawing only needs each brick's Transform, Renderable and Breakable components,
+    // so loop through just those packed arrays
+    const std::vector<Transform>& transforms = this->bricks.Column<Transform>();
+    const std::vector<Renderable>& renderables = this->bricks.Column<Renderable>();
+    const std::vector<Breakable>& brickStates = this->bricks.Column<Breakable>();
+
+    // Loop through all the bricks (tiles) in the bricks archetype
+    for (unsigned int i = 0; i < this->bricks.Size(); ++i)
+    {
+        // If the brick is NOT destroyed
+        if (!brickStates[i].isDestroyed)
+        {
+            // Draw it
+            shape_renderer.DrawShape(transforms[i].position, transforms[i].size, renderables[i].color, shader);
+        }
+    }
+}
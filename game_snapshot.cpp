@@ -0,0 +1,185 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//  BREAKOUT REMIX
+//  --------------
+//  by slate2b
+//
+//  The GameSnapshot class saves the whole simulation state of a Game into
+//  one flat buffer, and restores a Game to that state later.
+//
+//  The GameSnapshot class is responsible for the following:
+//
+//     * Saving the game state into a preallocated buffer
+//     * Restoring the game state from the buffer
+//
+///////////////////////////////////////////////////////////////////////////
+
+#include "game_snapshot.h"
+
+#include <cstring>
+#include <iostream>
+
+// Player paddles are saved as their GameObject part, so the Player class must not add any data
+static_assert(sizeof(Player) == sizeof(GameObject), "Player must not add data to GameObject (it is saved as a GameObject)");
+
+
+// Method to copy a vector of plain data into the buffer and return the end of the data written
+// --------------------------------------------------------------------------------------------
+template <class T>
+static unsigned char* WriteArray(unsigned char* out, const std::vector<T>& values)
+{
+    size_t bytes = values.size() * sizeof(T);
+
+    if (bytes > 0)
+        std::memcpy(out, values.data(), bytes);
+
+    return out + bytes;
+}
+
+// Method to fill a vector of plain data with count values from the buffer and return the end of the data read
+// -----------------------------------------------------------------------------------------------------------
+template <class T>
+static const unsigned char* ReadArray(const unsigned char* in, std::vector<T>& values, unsigned int count)
+{
+    size_t bytes = count * sizeof(T);
+    values.resize(count);
+
+    if (bytes > 0)
+        std::memcpy(values.data(), in, bytes);
+
+    return in + bytes;
+}
+
+
+GameSnapshot::GameSnapshot()
+{
+    this->size = 0;
+}
+
+
+// Method to size the buffer for a game with up to max_balls balls and max_bricks bricks
+// -------------------------------------------------------------------------------------
+void GameSnapshot::Reserve(unsigned int max_balls, unsigned int max_bricks)
+{
+    size_t bytes = sizeof(Header);
+    bytes += max_balls * (BallArchetype::GetEntityBytes() + sizeof(Game::SweepEntry) + sizeof(Game::FixedSweepEntry));
+    bytes += max_bricks * sizeof(Breakable) + ((max_bricks + 63) / 64) * sizeof(uint64_t);
+
+    if (this->buffer.size() < bytes)
+        this->buffer.resize(bytes);
+}
+
+
+// Method to save the state of the game
+// ------------------------------------
+void GameSnapshot::Save(const Game& game)
+{
+    const GameLevel& level = game.activeLevel;
+
+    // Fill in the header
+    Header header;
+    header.currentLevel = game.currentLevel;
+    header.ballInPlayTimer = game.ballInPlayTimer;
+    header.score = game.score;
+    header.gameTime = game.gameTime;
+    header.levelState = game.levelState;
+    header.levelClearedTimer = game.levelClearedTimer;
+    header.levelsCleared = game.levelsCleared;
+    header.levelResets = game.levelResets;
+    header.isFixedPoint = game.isFixedPoint;
+    std::memcpy(header.keys, game.keys, sizeof(header.keys));
+    header.player = game.player;
+
+    header.numBalls = game.ballObjects.Size();
+    header.numBricks = level.bricks.Size();
+    header.liveBricks = level.liveBricks;
+    header.numLiveBrickWords = static_cast<unsigned int>(level.liveBrickBits.size());
+    header.numSweepEntries = static_cast<unsigned int>(game.sweepOrder.size());
+    header.numFixedSweepEntries = static_cast<unsigned int>(game.fixedSweepOrder.size());
+
+    // Grow the buffer if Reserve was not called with enough room (only the first save of a bigger game allocates)
+    size_t bytes = sizeof(Header) + game.ballObjects.GetColumnBytes()
+        + header.numBricks * sizeof(Breakable) + header.numLiveBrickWords * sizeof(uint64_t)
+        + header.numSweepEntries * sizeof(Game::SweepEntry) + header.numFixedSweepEntries * sizeof(Game::FixedSweepEntry);
+
+    if (this->buffer.size() < bytes)
+        this->buffer.resize(bytes);
+
+    // Copy the header, then each variable size part
+    unsigned char* out = this->buffer.data();
+    std::memcpy(out, &header, sizeof(Header));
+    out += sizeof(Header);
+
+    out = game.ballObjects.SaveColumns(out);
+    out = WriteArray(out, level.bricks.Column<Breakable>());
+    out = WriteArray(out, level.liveBrickBits);
+    out = WriteArray(out, game.sweepOrder);
+    out = WriteArray(out, game.fixedSweepOrder);
+
+    this->size = bytes;
+}
+
+
+// Method to restore the game to the saved state
+// ---------------------------------------------
+bool GameSnapshot::Restore(Game& game) const
+{
+    if (this->size == 0)
+    {
+        std::cout << "Error: Restoring an empty game snapshot" << std::endl;
+        return false;
+    }
+
+    const unsigned char* in = this->buffer.data();
+
+    Header header;
+    std::memcpy(&header, in, sizeof(Header));
+    in += sizeof(Header);
+
+    // If the snapshot was taken on another level, load that level first (the level pack holds it if it retains the previous level)
+    if (header.currentLevel != game.currentLevel || header.numBricks != game.activeLevel.bricks.Size())
+        game.LoadLevel(header.currentLevel);
+
+    if (header.numBricks != game.activeLevel.bricks.Size())
+    {
+        std::cout << "Error: Game snapshot does not match level " << header.currentLevel << std::endl;
+        return false;
+    }
+
+    // Copy the header back
+    game.currentLevel = header.currentLevel;
+    game.ballInPlayTimer = header.ballInPlayTimer;
+    game.score = header.score;
+    game.gameTime = header.gameTime;
+    game.levelState = header.levelState;
+    game.levelClearedTimer = header.levelClearedTimer;
+    game.levelsCleared = header.levelsCleared;
+    game.levelResets = header.levelResets;
+    game.isFixedPoint = header.isFixedPoint;
+    std::memcpy(game.keys, header.keys, sizeof(header.keys));
+    static_cast<GameObject&>(game.player) = header.player;
+
+    // Copy each variable size part back
+    GameLevel& level = game.activeLevel;
+
+    in = game.ballObjects.RestoreColumns(in, header.numBalls);
+    in = ReadArray(in, level.bricks.Column<Breakable>(), header.numBricks);
+    in = ReadArray(in, level.liveBrickBits, header.numLiveBrickWords);
+    in = ReadArray(in, game.sweepOrder, header.numSweepEntries);
+    in = ReadArray(in, game.fixedSweepOrder, header.numFixedSweepEntries);
+
+    level.liveBricks = header.liveBricks;
+
+    // The brick changes logged since the snapshot did not happen any more
+    game.brickChanges.clear();
+
+    return true;
+}
+
+
+// Method to return the number of bytes used by the saved state
+// ------------------------------------------------------------
+size_t GameSnapshot::GetSize() const
+{
+    return this->size;
+}
@@ -0,0 +1,99 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//  BREAKOUT REMIX
+//  --------------
+//  by slate2b
+//
+//  The GameSnapshot class saves the whole simulation state of a Game into
+//  one flat buffer, and restores a Game to that state later (e.g. to roll
+//  back and resimulate frames for netplay, or to try moves in an AI
+//  search).
+//
+//  The snapshot is a header (the timers, score, keys, player paddle and
+//  level progress) followed by the packed component vectors of the balls,
+//  the Breakable flags and live brick bits of the active level, and the
+//  sweep and prune orders.  Everything is plain data, so saving and
+//  restoring are a few memcpy calls.  The buffer is kept between saves,
+//  and Reserve can size it up front so Save never allocates.
+//
+//  Only the state which changes while a level is played is saved: the
+//  bricks themselves come from the level pack, so restoring a snapshot
+//  taken on another level loads that level first.  Restoring across a
+//  level change only avoids building the level again if the level pack
+//  retains the previous level (see LevelPack::SetRetainPreviousLevel).
+//
+//     GameSnapshot snapshot;
+//     snapshot.Reserve(5, 150);
+//     snapshot.Save(game);
+//     ...
+//     snapshot.Restore(game);
+//
+//  The GameSnapshot class is responsible for the following:
+//
+//     * Saving the game state into a preallocated buffer
+//     * Restoring the game state from the buffer
+//
+///////////////////////////////////////////////////////////////////////////
+
+#ifndef GAMESNAPSHOT_H
+#define GAMESNAPSHOT_H
+
+#include <cstddef>
+#include <vector>
+
+#include "game.h"
+
+class GameSnapshot
+{
+
+public:
+
+	// Constructor (an empty snapshot, which cannot be restored)
+	GameSnapshot();
+
+	// Method to size the buffer for a game with up to max_balls balls and max_bricks bricks (so Save does not allocate)
+	void Reserve(unsigned int max_balls, unsigned int max_bricks);
+
+	// Method to save the state of the game
+	void Save(const Game& game);
+
+	// Method to restore the game to the saved state (returns false if nothing was saved or the level does not match)
+	bool Restore(Game& game) const;
+
+	// Method to return the number of bytes used by the saved state
+	size_t GetSize() const;
+
+private:
+
+	// Struct to hold the fixed size part of the state
+	struct Header
+	{
+		unsigned int currentLevel;
+		unsigned int ballInPlayTimer;
+		unsigned int score;
+		float gameTime;
+		LevelState levelState;
+		unsigned int levelClearedTimer;
+		unsigned int levelsCleared;
+		unsigned int levelResets;
+		bool isFixedPoint;
+		bool keys[1024];
+		GameObject player;
+
+		// Sizes of the variable size parts which follow the header
+		unsigned int numBalls;
+		unsigned int numBricks;
+		unsigned int liveBricks;
+		unsigned int numLiveBrickWords;
+		unsigned int numSweepEntries;
+		unsigned int numFixedSweepEntries;
+	};
+
+	// Buffer holding the header, followed by the variable size parts
+	std::vector<unsigned char> buffer;
+
+	// Number of bytes of the buffer used by the saved state (0 = nothing saved)
+	size_t size;
+};
+
+#endif
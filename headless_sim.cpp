@@ -0,0 +1,322 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//  BREAKOUT REMIX
+//  --------------
+//  by slate2b
+//
+//  Headless simulation.
+//
+//  This program runs the game without a window or OpenGL context, using
+//  only the breakout_core library.  A simple autopilot moves the paddle
+//  under the lowest falling ball and keeps releasing balls, so the run
+//  exercises the same ProcessInput / UpdateGame path as the real game.
+//
+//  Input can also come from a replay file recorded by the game (or by
+//  this program), which makes runs repeatable between builds.
+//
+//  Options:
+//
+//     --frames N          Number of frames to simulate (default 36000, 10 minutes at 60 FPS)
+//     --autopilot-seed N  Vary the autopilot's timing (default 0 = fixed timing)
+//     --ai                Use the paddle controller (predicts where every ball lands) instead of the autopilot
+//     --record FILE       Save the autopilot's input as a replay file
+//     --replay FILE       Play a replay file instead of using the autopilot
+//     --repeat N          Play the replay N times (default 1)
+//     --collision-threads N  Threads used to detect ball and brick collisions (default 1)
+//     --fixed-point       Use the deterministic (fixed point) physics
+//     --checksum          Hash the game state after every step and print the combined hash,
+//                         so two runs (e.g. on different machines) can be compared
+//     --hash-log FILE     Stream the state hash of every step to a file
+//     --compare-hash-log FILE  Compare the state hash of every step with a file saved by --hash-log
+//                         (e.g. by another build) and report the first step which differs
+//     --rollback-check    Run every step twice, restoring a snapshot taken before the step in
+//                         between, and count the steps which did not come out the same
+//
+///////////////////////////////////////////////////////////////////////////
+
+#include "game.h"
+#include "replay.h"
+#include "game_snapshot.h"
+#include "state_hash.h"
+#include "paddle_controller.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+
+// Constants for the simulated screen (matches Source.cpp)
+const unsigned int SCREEN_WIDTH = 800;
+const unsigned int SCREEN_HEIGHT = 600;
+
+// Fixed time step used for every simulated frame (60 frames per second)
+const float FRAME_DT = 1.0f / 60.0f;
+
+// Autopilot timing (varied by --autopilot-seed)
+unsigned int autopilotTapPeriod = 30;
+float autopilotDeadZone = 8.0f;
+
+// State hashing (--checksum, --hash-log and --compare-hash-log)
+bool isChecksummed = false;
+StateHasher runHasher;
+StateHashLog hashLog;
+StateHashLog compareLog;
+const char* hashLogFile = nullptr;
+const char* compareLogFile = nullptr;
+
+// Rollback checking (--rollback-check)
+bool isRollbackChecked = false;
+GameSnapshot rollbackSnapshot;
+unsigned int rollbackMismatches = 0;
+
+
+// Method to press the keys a player would press to keep the balls in play
+// -----------------------------------------------------------------------
+void UpdateAutopilot(Game& game, unsigned int frame)
+{
+    // Find the lowest ball which is falling toward the paddle
+    float targetX = -1.0f;
+    float lowestY = -1.0f;
+
+    for (BallObject ball_object : game.ballObjects)
+    {
+        if (ball_object.isInPlay && !ball_object.isHeld && !ball_object.isDestroyed && ball_object.Velocity.y > 0.0f)
+        {
+            if (ball_object.Position.y > lowestY)
+            {
+                lowestY = ball_object.Position.y;
+                targetX = ball_object.Position.x + ball_object.Radius;
+            }
+        }
+    }
+
+    // Steer toward the falling ball (the paddle follows the ball with a small dead zone)
+    float paddleCenter = game.player.Position.x + game.player.Size.x / 2.0f;
+    game.keys[KEY_A] = (targetX >= 0.0f && targetX < paddleCenter - autopilotDeadZone);
+    game.keys[KEY_D] = (targetX >= 0.0f && targetX > paddleCenter + autopilotDeadZone);
+
+    // Tap the Spacebar (twice a second by default) to place and release balls
+    game.keys[KEY_SPACE] = (frame % autopilotTapPeriod) == 0;
+}
+
+
+// Method to run one step of the game (with --rollback-check, run it again from a snapshot and compare)
+// ---------------------------------------------------------------------------------------------------
+void StepGame(Game& game, float dt)
+{
+    if (isRollbackChecked)
+    {
+        // Run the step, then roll back to the snapshot and run it again
+        rollbackSnapshot.Save(game);
+        game.ProcessInput(dt);
+        game.UpdateGame(dt);
+        uint64_t firstHash = game.ComputeStateHash();
+
+        rollbackSnapshot.Restore(game);
+
+        // The second run must come out exactly the same
+        game.ProcessInput(dt);
+        game.UpdateGame(dt);
+
+        if (game.ComputeStateHash() != firstHash)
+            rollbackMismatches += 1;
+    }
+    else
+    {
+        game.ProcessInput(dt);
+        game.UpdateGame(dt);
+    }
+}
+
+
+// Method to hash the game state after a step and pass the hash to each hashing option in use
+// -------------------------------------------------------------------------------------------
+void HashStep(const Game& game, unsigned int step)
+{
+    uint64_t hash = game.ComputeStateHash();
+
+    // Fold every step's hash into the run's hash, in order (so a difference in any step changes it)
+    if (isChecksummed)
+        runHasher.Update(&hash, sizeof(hash));
+
+    if (hashLogFile != nullptr)
+        hashLog.Write(step, hash);
+
+    if (compareLogFile != nullptr)
+        compareLog.Check(step, hash);
+}
+
+
+int main(int argc, char* argv[])
+{
+    unsigned int numFrames = 36000;
+    unsigned int autopilotSeed = 0;
+    bool isAiPlaying = false;
+    unsigned int numRepeats = 1;
+    unsigned int collisionThreads = 1;
+    const char* recordFile = nullptr;
+    const char* replayFile = nullptr;
+    bool isFixedPoint = false;
+
+    // Read the command line options
+    for (int i = 1; i < argc; ++i)
+    {
+        bool hasValue = (i + 1 < argc);
+
+        if (std::strcmp(argv[i], "--frames") == 0 && hasValue)
+            numFrames = std::strtoul(argv[++i], nullptr, 10);
+        else if (std::strcmp(argv[i], "--autopilot-seed") == 0 && hasValue)
+            autopilotSeed = std::strtoul(argv[++i], nullptr, 10);
+        else if (std::strcmp(argv[i], "--ai") == 0)
+            isAiPlaying = true;
+        else if (std::strcmp(argv[i], "--record") == 0 && hasValue)
+            recordFile = argv[++i];
+        else if (std::strcmp(argv[i], "--replay") == 0 && hasValue)
+            replayFile = argv[++i];
+        else if (std::strcmp(argv[i], "--repeat") == 0 && hasValue)
+            numRepeats = std::strtoul(argv[++i], nullptr, 10);
+        else if (std::strcmp(argv[i], "--collision-threads") == 0 && hasValue)
+            collisionThreads = std::strtoul(argv[++i], nullptr, 10);
+        else if (std::strcmp(argv[i], "--fixed-point") == 0)
+            isFixedPoint = true;
+        else if (std::strcmp(argv[i], "--checksum") == 0)
+            isChecksummed = true;
+        else if (std::strcmp(argv[i], "--hash-log") == 0 && hasValue)
+            hashLogFile = argv[++i];
+        else if (std::strcmp(argv[i], "--compare-hash-log") == 0 && hasValue)
+            compareLogFile = argv[++i];
+        else if (std::strcmp(argv[i], "--rollback-check") == 0)
+            isRollbackChecked = true;
+        else
+        {
+            std::cout << "Error: Unknown option " << argv[i] << std::endl;
+            return -1;
+        }
+    }
+
+    // Vary the autopilot timing so different seeds produce different sessions
+    if (autopilotSeed != 0)
+    {
+        std::mt19937 randomEngine(autopilotSeed);
+        autopilotTapPeriod = 20 + randomEngine() % 21;
+        autopilotDeadZone = 4.0f + (randomEngine() % 13);
+    }
+
+    // Load the replay, if one was given
+    Replay replay;
+    Replay recording;
+
+    if (replayFile != nullptr && !replay.Load(replayFile))
+        return -1;
+
+    // Create the game without a window
+    Game game(SCREEN_WIDTH, SCREEN_HEIGHT);
+    game.InitSimulation();
+    game.SetCollisionThreads(collisionThreads);
+    game.SetFixedPoint(isFixedPoint);
+
+    // Open the hash logs, if any were given
+    if (hashLogFile != nullptr && !hashLog.Open(hashLogFile))
+        return -1;
+
+    if (compareLogFile != nullptr && !compareLog.Load(compareLogFile))
+        return -1;
+
+    bool isHashingSteps = isChecksummed || hashLogFile != nullptr || compareLogFile != nullptr;
+
+    unsigned int framesSimulated = 0;
+    double gameTime = 0.0;
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    if (replayFile != nullptr)
+    {
+        // Run the game loop using the recorded input
+        for (unsigned int repeat = 0; repeat < numRepeats; ++repeat)
+        {
+            float dt = 0.0f;
+            replay.Rewind();
+
+            while (replay.PlayFrame(game, dt))
+            {
+                StepGame(game, dt);
+
+                if (isHashingSteps)
+                    HashStep(game, framesSimulated);
+
+                framesSimulated += 1;
+                gameTime += dt;
+            }
+        }
+    }
+    else
+    {
+        // Run the game loop using the autopilot (or the paddle controller)
+        PaddleController controller;
+
+        for (unsigned int frame = 0; frame < numFrames; ++frame)
+        {
+            if (isAiPlaying)
+                controller.Update(game, FRAME_DT);
+            else
+                UpdateAutopilot(game, frame);
+
+            if (recordFile != nullptr)
+                recording.RecordFrame(game, FRAME_DT);
+
+            StepGame(game, FRAME_DT);
+
+            if (isHashingSteps)
+                HashStep(game, framesSimulated);
+
+            framesSimulated += 1;
+            gameTime += FRAME_DT;
+        }
+    }
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    if (recordFile != nullptr && !recording.Save(recordFile))
+        return -1;
+
+    std::cout << "Frames simulated:     " << framesSimulated << std::endl;
+    std::cout << "Game time (s):        " << gameTime << std::endl;
+    std::cout << "Wall time (s):        " << seconds << std::endl;
+    std::cout << "Frames per second:    " << framesSimulated / seconds << std::endl;
+    std::cout << "Mean frame time (ns): " << (seconds * 1e9) / framesSimulated << std::endl;
+    std::cout << "Level:                " << game.currentLevel << std::endl;
+    std::cout << "Bricks remaining:     " << game.activeLevel.liveBricks << std::endl;
+    std::cout << "Score:                " << game.score << std::endl;
+    std::cout << "Levels cleared:       " << game.levelsCleared << std::endl;
+    std::cout << "Game overs:           " << game.levelResets << std::endl;
+    std::cout << "Ball pair tests:      " << game.ballPairTests << std::endl;
+    std::cout << "Ball pair collisions: " << game.ballPairCollisions << std::endl;
+    std::cout << "Paddle tests run:     " << game.paddleTestsRun << std::endl;
+    std::cout << "Paddle tests skipped: " << game.paddleTestsSkipped << std::endl;
+
+    if (isChecksummed)
+        std::cout << "State checksum:       " << std::hex << runHasher.Digest() << std::dec << std::endl;
+
+    if (isRollbackChecked)
+        std::cout << "Rollback mismatches:  " << rollbackMismatches << std::endl;
+
+    if (hashLogFile != nullptr && !hashLog.Close())
+        return -1;
+
+    // Report where this run split from the compared run
+    if (compareLogFile != nullptr)
+    {
+        if (compareLog.HasMismatch())
+            std::cout << "First differing step: " << compareLog.GetFirstMismatch() << std::endl;
+        else if (compareLog.GetLoadedStepCount() != framesSimulated)
+            std::cout << "Hash log has " << compareLog.GetLoadedStepCount() << " steps, this run had " << framesSimulated << std::endl;
+        else
+            std::cout << "Every step matches the hash log" << std::endl;
+    }
+
+    // Report how long the level transitions took
+    game.profiler.PrintReport();
+
+    return 0;
+}
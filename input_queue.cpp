@@ -0,0 +1,81 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//  BREAKOUT REMIX
+//  --------------
+//  by slate2b
+//
+//  The InputQueue class passes key events from the key callback to the
+//  simulation in the order they happened, each with the time it happened.
+//
+//  The InputQueue class is responsible for the following:
+//
+//     * Queueing key events without locking
+//     * Handing the key events to the simulation in order
+//	   * Counting the key events dropped because the queue was full
+//
+///////////////////////////////////////////////////////////////////////////
+
+#include "input_queue.h"
+
+InputQueue::InputQueue()
+{
+    head = 0;
+    tail = 0;
+    droppedCount = 0;
+}
+
+
+// Method to add a key event (producer only, returns false and drops the event if the queue is full)
+// -------------------------------------------------------------------------------------------------
+bool InputQueue::Push(const InputEvent& input_event)
+{
+    unsigned int currentTail = this->tail.load(std::memory_order_relaxed);
+
+    // The indices only ever count up, so the queue is full when they are CAPACITY apart
+    if (currentTail - this->head.load(std::memory_order_acquire) >= CAPACITY)
+    {
+        this->droppedCount.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    this->events[currentTail & (CAPACITY - 1)] = input_event;
+
+    // Publish the event (release, so the consumer sees it fully written)
+    this->tail.store(currentTail + 1, std::memory_order_release);
+
+    return true;
+}
+
+
+// Method to look at the oldest key event without removing it (consumer only, returns false if the queue is empty)
+// --------------------------------------------------------------------------------------------------------------
+bool InputQueue::Peek(InputEvent& event_out) const
+{
+    unsigned int currentHead = this->head.load(std::memory_order_relaxed);
+
+    if (currentHead == this->tail.load(std::memory_order_acquire))
+        return false;
+
+    event_out = this->events[currentHead & (CAPACITY - 1)];
+
+    return true;
+}
+
+
+// Method to remove the oldest key event (consumer only)
+// -----------------------------------------------------
+void InputQueue::Pop()
+{
+    unsigned int currentHead = this->head.load(std::memory_order_relaxed);
+
+    // Hand the slot back to the producer (release, so the event has been read before it is overwritten)
+    this->head.store(currentHead + 1, std::memory_order_release);
+}
+
+
+// Method to return the number of key events dropped because the queue was full
+// ----------------------------------------------------------------------------
+unsigned int InputQueue::GetDroppedCount() const
+{
+    return this->droppedCount.load(std::memory_order_relaxed);
+}
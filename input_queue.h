@@ -0,0 +1,73 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//  BREAKOUT REMIX
+//  --------------
+//  by slate2b
+//
+//  The InputQueue class passes key events from the key callback to the
+//  simulation in the order they happened, each with the time it happened.
+//
+//  It is a fixed size ring buffer for a single producer (the thread which
+//  polls the window events) and a single consumer (the thread which runs
+//  the simulation).  Neither side ever takes a lock: the producer only
+//  writes the tail index and the consumer only writes the head index.
+//
+//  The InputQueue class is responsible for the following:
+//
+//     * Queueing key events without locking
+//     * Handing the key events to the simulation in order
+//	   * Counting the key events dropped because the queue was full
+//
+///////////////////////////////////////////////////////////////////////////
+
+#ifndef INPUTQUEUE_H
+#define INPUTQUEUE_H
+
+#include <atomic>
+
+// Struct to hold one key event
+struct InputEvent
+{
+	int key;
+	bool isPressed;
+	double time;
+};
+
+
+class InputQueue
+{
+
+public:
+
+	// Maximum number of queued key events (must be a power of two)
+	static const unsigned int CAPACITY = 256;
+
+	// Constructor
+	InputQueue();
+
+	// Method to add a key event (producer only, returns false and drops the event if the queue is full)
+	bool Push(const InputEvent& input_event);
+
+	// Method to look at the oldest key event without removing it (consumer only, returns false if the queue is empty)
+	bool Peek(InputEvent& event_out) const;
+
+	// Method to remove the oldest key event (consumer only)
+	void Pop();
+
+	// Method to return the number of key events dropped because the queue was full
+	unsigned int GetDroppedCount() const;
+
+private:
+
+	// Ring buffer of key events
+	InputEvent events[CAPACITY];
+
+	// Number of events removed (written by the consumer) and added (written by the producer)
+	std::atomic<unsigned int> head;
+	std::atomic<unsigned int> tail;
+
+	// Number of events dropped (written by the producer)
+	std::atomic<unsigned int> droppedCount;
+};
+
+#endif
@@ -0,0 +1,222 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//  BREAKOUT REMIX
+//  --------------
+//  by slate2b
+//
+//  The JobSystem class runs small jobs on a set of worker threads so work
+//  from different parts of a frame can overlap.
+//
+//  The JobSystem class is responsible for the following:
+//
+//     * Starting and stopping the worker threads
+//     * Queueing jobs and balancing them across workers
+//	   * Waiting for a group of jobs to finish
+//
+///////////////////////////////////////////////////////////////////////////
+
+#include "job_system.h"
+
+// Index of the worker queue owned by the current thread (-1 for threads which are not workers)
+static thread_local int currentWorker = -1;
+
+JobSystem::JobSystem()
+{
+    nextQueue = 0;
+    queuedJobs = 0;
+    isStopping = false;
+}
+
+JobSystem::~JobSystem()
+{
+    this->Stop();
+}
+
+
+// Method to start the worker threads (0 = one per CPU core, minimum of 1)
+// -----------------------------------------------------------------------
+void JobSystem::Start(unsigned int num_workers)
+{
+    // Restart with the new worker count
+    this->Stop();
+
+    if (num_workers == 0)
+        num_workers = std::thread::hardware_concurrency();
+
+    if (num_workers == 0)
+        num_workers = 1;
+
+    this->isStopping = false;
+
+    // Create every queue before starting any thread, because workers steal from each other
+    for (unsigned int i = 0; i < num_workers; ++i)
+    {
+        this->queues.push_back(std::unique_ptr<WorkerQueue>(new WorkerQueue()));
+    }
+
+    for (unsigned int i = 0; i < num_workers; ++i)
+    {
+        this->threads.push_back(std::thread(&JobSystem::WorkerLoop, this, i));
+    }
+}
+
+
+// Method to finish the queued jobs and stop the worker threads
+// ------------------------------------------------------------
+void JobSystem::Stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(this->sleepMutex);
+        this->isStopping = true;
+    }
+
+    this->jobQueued.notify_all();
+
+    for (std::thread& thread : this->threads)
+    {
+        if (thread.joinable())
+            thread.join();
+    }
+
+    this->threads.clear();
+    this->queues.clear();
+}
+
+
+// Method to return the number of worker threads
+// ---------------------------------------------
+unsigned int JobSystem::GetWorkerCount() const
+{
+    return static_cast<unsigned int>(this->threads.size());
+}
+
+
+// Method to queue a job (counter is incremented now and decremented when the job finishes)
+// ----------------------------------------------------------------------------------------
+void JobSystem::Schedule(const Job& job, JobCounter& counter)
+{
+    counter += 1;
+
+    QueuedJob queuedJob;
+    queuedJob.job = job;
+    queuedJob.counter = &counter;
+
+    // Without worker threads, run the job right away
+    if (this->queues.empty())
+    {
+        this->RunJob(queuedJob);
+        return;
+    }
+
+    // Workers push onto their own queue, other threads spread their jobs across the queues
+    unsigned int queueIndex;
+
+    if (currentWorker >= 0)
+        queueIndex = static_cast<unsigned int>(currentWorker);
+    else
+        queueIndex = this->nextQueue++ % this->queues.size();
+
+    // Count the job before publishing it, so a worker which takes it at once never drives queuedJobs below zero
+    // NOTE: Both happen under sleepMutex, so a sleeping worker cannot wake up before the job is in its queue
+    {
+        std::lock_guard<std::mutex> sleepLock(this->sleepMutex);
+        this->queuedJobs += 1;
+
+        std::lock_guard<std::mutex> queueLock(this->queues[queueIndex]->queueMutex);
+        this->queues[queueIndex]->jobs.push_back(queuedJob);
+    }
+
+    // Wake a sleeping worker
+    this->jobQueued.notify_one();
+}
+
+
+// Method to wait until every job scheduled with the counter has finished (runs other jobs meanwhile)
+// -------------------------------------------------------------------------------------------------
+void JobSystem::Wait(JobCounter& counter)
+{
+    // Threads which are not workers start stealing from the first queue
+    unsigned int workerIndex = (currentWorker >= 0) ? static_cast<unsigned int>(currentWorker) : 0;
+
+    while (counter.load() > 0)
+    {
+        QueuedJob queuedJob;
+
+        // Help with the queued jobs instead of blocking, otherwise let the running jobs finish
+        if (!this->queues.empty() && this->TakeJob(workerIndex, queuedJob))
+            this->RunJob(queuedJob);
+        else
+            std::this_thread::yield();
+    }
+}
+
+
+// Method run by each worker thread
+// --------------------------------
+void JobSystem::WorkerLoop(unsigned int worker_index)
+{
+    currentWorker = static_cast<int>(worker_index);
+
+    while (true)
+    {
+        QueuedJob queuedJob;
+
+        if (this->TakeJob(worker_index, queuedJob))
+        {
+            this->RunJob(queuedJob);
+            continue;
+        }
+
+        // Sleep until a job is queued (or the job system stops)
+        std::unique_lock<std::mutex> lock(this->sleepMutex);
+        this->jobQueued.wait(lock, [this] { return this->isStopping || this->queuedJobs.load() > 0; });
+
+        // Finish the queued jobs before stopping
+        if (this->isStopping && this->queuedJobs.load() == 0)
+            return;
+    }
+}
+
+
+// Method to take a job, from the given worker's own queue first, then from the other queues
+// -----------------------------------------------------------------------------------------
+bool JobSystem::TakeJob(unsigned int worker_index, QueuedJob& job_out)
+{
+    unsigned int numQueues = static_cast<unsigned int>(this->queues.size());
+
+    for (unsigned int i = 0; i < numQueues; ++i)
+    {
+        WorkerQueue& queue = *this->queues[(worker_index + i) % numQueues];
+        std::lock_guard<std::mutex> lock(queue.queueMutex);
+
+        if (queue.jobs.empty())
+            continue;
+
+        // Run the newest job from the worker's own queue (its data is most likely still in cache),
+        // and steal the oldest job from other queues
+        if (i == 0)
+        {
+            job_out = queue.jobs.back();
+            queue.jobs.pop_back();
+        }
+        else
+        {
+            job_out = queue.jobs.front();
+            queue.jobs.pop_front();
+        }
+
+        this->queuedJobs -= 1;
+        return true;
+    }
+
+    return false;
+}
+
+
+// Method to run a job and report it finished
+// ------------------------------------------
+void JobSystem::RunJob(QueuedJob& queued_job)
+{
+    queued_job.job();
+    *queued_job.counter -= 1;
+}
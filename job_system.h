@@ -0,0 +1,120 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//  BREAKOUT REMIX
+//  --------------
+//  by slate2b
+//
+//  The JobSystem class runs small jobs on a set of worker threads so work
+//  from different parts of a frame can overlap (e.g. simulating the next
+//  frame while the shapes for the current frame are built).
+//
+//  Each worker thread has its own queue of jobs.  A worker runs the
+//  newest job in its own queue first, and when its queue is empty it
+//  steals the oldest job from another queue (work stealing).  Jobs
+//  scheduled from a thread which is not a worker (e.g. the main thread)
+//  are spread across the worker queues.
+//
+//  Each job is tracked by a JobCounter which the caller owns.  Wait()
+//  returns once every job scheduled with that counter has finished, and
+//  runs other jobs while it waits instead of blocking.
+//
+//     JobCounter counter(0);
+//     jobSystem.Schedule(job, counter);
+//     ...
+//     jobSystem.Wait(counter);
+//
+//  The JobSystem class is responsible for the following:
+//
+//     * Starting and stopping the worker threads
+//     * Queueing jobs and balancing them across workers
+//	   * Waiting for a group of jobs to finish
+//
+///////////////////////////////////////////////////////////////////////////
+
+#ifndef JOBSYSTEM_H
+#define JOBSYSTEM_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Counter of unfinished jobs (owned by whoever schedules the jobs)
+typedef std::atomic<unsigned int> JobCounter;
+
+class JobSystem
+{
+
+public:
+
+	// Typedef for a job
+	typedef std::function<void()> Job;
+
+	// Constructor (no worker threads until Start is called)
+	JobSystem();
+
+	// Destructor (stops the worker threads)
+	~JobSystem();
+
+	// Method to start the worker threads (0 = one per CPU core, minimum of 1)
+	void Start(unsigned int num_workers);
+
+	// Method to finish the queued jobs and stop the worker threads
+	void Stop();
+
+	// Method to return the number of worker threads
+	unsigned int GetWorkerCount() const;
+
+	// Method to queue a job (counter is incremented now and decremented when the job finishes)
+	// NOTE: Without worker threads the job runs right away on the calling thread
+	void Schedule(const Job& job, JobCounter& counter);
+
+	// Method to wait until every job scheduled with the counter has finished (runs other jobs meanwhile)
+	void Wait(JobCounter& counter);
+
+private:
+
+	// Struct to hold a queued job and the counter it reports to
+	struct QueuedJob
+	{
+		Job job;
+		JobCounter* counter;
+	};
+
+	// Struct to hold the job queue of one worker
+	struct WorkerQueue
+	{
+		std::mutex queueMutex;
+		std::deque<QueuedJob> jobs;
+	};
+
+	// One queue per worker thread
+	std::vector<std::unique_ptr<WorkerQueue>> queues;
+	std::vector<std::thread> threads;
+
+	// Queue used for the next job scheduled from a thread which is not a worker
+	std::atomic<unsigned int> nextQueue;
+
+	// Number of queued jobs which no thread has started yet
+	std::atomic<unsigned int> queuedJobs;
+
+	// Variables used to let idle workers sleep until a job is queued
+	std::mutex sleepMutex;
+	std::condition_variable jobQueued;
+	bool isStopping;
+
+	// Method run by each worker thread
+	void WorkerLoop(unsigned int worker_index);
+
+	// Method to take a job, from the given worker's own queue first, then from the other queues
+	bool TakeJob(unsigned int worker_index, QueuedJob& job_out);
+
+	// Method to run a job and report it finished
+	void RunJob(QueuedJob& queued_job);
+};
+
+#endif
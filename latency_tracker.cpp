@@ -0,0 +1,158 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//  BREAKOUT REMIX
+//  --------------
+//  by slate2b
+//
+//  The LatencyTracker class measures how long it takes for a key press
+//  or release to reach the screen (input-to-photon latency).
+//
+//  The LatencyTracker class is responsible for the following:
+//
+//     * Timestamping key events
+//     * Tagging key events with the frame which used them
+//	   * Reporting and saving the measured latencies
+//
+///////////////////////////////////////////////////////////////////////////
+
+#include "latency_tracker.h"
+
+#include <fstream>
+#include <iostream>
+
+LatencyTracker::LatencyTracker()
+{
+    firstUnswapped = 0;
+    firstUncompleted = 0;
+}
+
+
+// Method to timestamp a key event (called from the key callback)
+// --------------------------------------------------------------
+void LatencyTracker::AddKeyEvent(int key, double event_time)
+{
+    LatencySample sample;
+    sample.frame = 0;
+    sample.key = key;
+    sample.eventTime = event_time;
+    sample.sampleTime = -1.0;
+    sample.swapTime = -1.0;
+    sample.gpuDoneTime = -1.0;
+
+    this->pendingEvents.push_back(sample);
+}
+
+
+// Method to claim every key event received so far for the frame which is sampling the keys now
+// --------------------------------------------------------------------------------------------
+void LatencyTracker::SampleFrame(unsigned int frame_index, double sample_time)
+{
+    for (LatencySample& sample : this->pendingEvents)
+    {
+        sample.frame = frame_index;
+        sample.sampleTime = sample_time;
+
+        this->samples.push_back(sample);
+    }
+
+    this->pendingEvents.clear();
+}
+
+
+// Method to stamp the events claimed by the latest frame with its buffer swap time
+// --------------------------------------------------------------------------------
+void LatencyTracker::SwapFrame(double swap_time)
+{
+    for (unsigned int i = this->firstUnswapped; i < this->samples.size(); ++i)
+    {
+        this->samples[i].swapTime = swap_time;
+    }
+
+    this->firstUnswapped = static_cast<unsigned int>(this->samples.size());
+}
+
+
+// Method to stamp the events claimed by the latest swapped frame with the time the GPU finished it
+// -----------------------------------------------------------------------------------------------
+void LatencyTracker::CompleteFrame(double gpu_done_time)
+{
+    for (unsigned int i = this->firstUncompleted; i < this->firstUnswapped; ++i)
+    {
+        this->samples[i].gpuDoneTime = gpu_done_time;
+    }
+
+    this->firstUncompleted = this->firstUnswapped;
+}
+
+
+// Method to print the average, minimum and maximum latencies
+// ----------------------------------------------------------
+void LatencyTracker::PrintReport() const
+{
+    unsigned int numSwapped = 0;
+    unsigned int numCompleted = 0;
+    double totalSample = 0.0, totalSwap = 0.0, totalGpu = 0.0;
+    double minSwap = 0.0, maxSwap = 0.0;
+
+    for (const LatencySample& sample : this->samples)
+    {
+        // Skip events from a frame which never reached the screen
+        if (sample.swapTime < 0.0)
+            continue;
+
+        double swapLatency = sample.swapTime - sample.eventTime;
+
+        if (numSwapped == 0 || swapLatency < minSwap)
+            minSwap = swapLatency;
+
+        if (numSwapped == 0 || swapLatency > maxSwap)
+            maxSwap = swapLatency;
+
+        totalSample += sample.sampleTime - sample.eventTime;
+        totalSwap += swapLatency;
+        numSwapped += 1;
+
+        if (sample.gpuDoneTime >= 0.0)
+        {
+            totalGpu += sample.gpuDoneTime - sample.eventTime;
+            numCompleted += 1;
+        }
+    }
+
+    std::cout << "Input latency: " << numSwapped << " key events" << std::endl;
+
+    if (numSwapped == 0)
+        return;
+
+    std::cout << "  event to sample (ms):   avg " << totalSample / numSwapped * 1000.0 << std::endl;
+    std::cout << "  event to swap (ms):     avg " << totalSwap / numSwapped * 1000.0
+        << "  min " << minSwap * 1000.0 << "  max " << maxSwap * 1000.0 << std::endl;
+
+    if (numCompleted > 0)
+        std::cout << "  event to gpu done (ms): avg " << totalGpu / numCompleted * 1000.0 << std::endl;
+}
+
+
+// Method to save every sample to file
+// -----------------------------------
+bool LatencyTracker::Save(const char* file) const
+{
+    std::ofstream fstream(file);
+
+    if (!fstream)
+    {
+        std::cout << "Error: Writing Latency Log " << file << std::endl;
+        return false;
+    }
+
+    // Write enough digits to keep sub-millisecond detail in the timestamps
+    fstream.precision(12);
+
+    for (const LatencySample& sample : this->samples)
+    {
+        fstream << sample.frame << ' ' << sample.key << ' ' << sample.eventTime << ' ' << sample.sampleTime << ' '
+            << sample.swapTime << ' ' << sample.gpuDoneTime << '\n';
+    }
+
+    return static_cast<bool>(fstream);
+}
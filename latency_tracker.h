@@ -0,0 +1,85 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//  BREAKOUT REMIX
+//  --------------
+//  by slate2b
+//
+//  The LatencyTracker class measures how long it takes for a key press
+//  or release to reach the screen (input-to-photon latency).
+//
+//  Every key event is timestamped when it arrives.  The frame which
+//  samples the keys claims every event received before it sampled them,
+//  and the claimed events are then stamped with that frame's buffer swap
+//  time (and, when fence sync is used, the time the GPU finished the
+//  frame).  All times are in seconds, from the same clock (glfwGetTime).
+//
+//  Latency logs are plain text (one line per key event):
+//
+//     <frame> <key> <event time> <sample time> <swap time> <gpu done time>
+//
+//  The gpu done time is -1 when it was not measured.
+//
+//  The LatencyTracker class is responsible for the following:
+//
+//     * Timestamping key events
+//     * Tagging key events with the frame which used them
+//	   * Reporting and saving the measured latencies
+//
+///////////////////////////////////////////////////////////////////////////
+
+#ifndef LATENCYTRACKER_H
+#define LATENCYTRACKER_H
+
+#include <vector>
+
+class LatencyTracker
+{
+
+public:
+
+	// Struct to hold the timeline of one key event
+	struct LatencySample
+	{
+		unsigned int frame;
+		int key;
+		double eventTime;
+		double sampleTime;
+		double swapTime;
+		double gpuDoneTime;
+	};
+
+	// Key events which have been claimed by a frame
+	std::vector<LatencySample> samples;
+
+	// Constructor
+	LatencyTracker();
+
+	// Method to timestamp a key event (called from the key callback)
+	void AddKeyEvent(int key, double event_time);
+
+	// Method to claim every key event received so far for the frame which is sampling the keys now
+	void SampleFrame(unsigned int frame_index, double sample_time);
+
+	// Method to stamp the events claimed by the latest frame with its buffer swap time
+	void SwapFrame(double swap_time);
+
+	// Method to stamp the events claimed by the latest swapped frame with the time the GPU finished it
+	void CompleteFrame(double gpu_done_time);
+
+	// Method to print the average, minimum and maximum latencies
+	void PrintReport() const;
+
+	// Method to save every sample to file
+	bool Save(const char* file) const;
+
+private:
+
+	// Key events which no frame has sampled yet
+	std::vector<LatencySample> pendingEvents;
+
+	// First sample waiting for a swap time, and first sample waiting for a gpu done time
+	unsigned int firstUnswapped;
+	unsigned int firstUncompleted;
+};
+
+#endif
@@ -0,0 +1,275 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//  BREAKOUT REMIX
+//  --------------
+//  by slate2b
+//
+//  Level scaling benchmark.
+//
+//  This headless program uses the LevelGenerator to sweep the level size
+//  from 10^2 up to 10^6 tiles (by powers of ten) and records how long it
+//  takes to build each level and to run each simulated frame.
+//
+//  No window or OpenGL context is created, so DrawLevel is not timed.
+//
+//  Each frame runs the ball movement and collisions of UpdateGame, but not
+//  its level progression (which would swap in a level from the level pack
+//  and a fresh set of balls): lost balls are relaunched, and a cleared
+//  level is built again outside the timed frame.
+//
+//  Options:
+//
+//     --min-tiles N     Smallest level in the sweep (default 100)
+//     --max-tiles N     Largest level in the sweep (default 1000000)
+//     --frames N        Simulated frames per level (default 600)
+//     --balls N         Ball objects in play (default 5)
+//     --density F       Fraction of tiles holding a brick (default 0.6)
+//     --seed N          Seed for the level generator (default 1)
+//     --csv FILE        Write the time of every frame to FILE
+//     --write-levels    Also write each generated level to a .lvl file
+//     --collision-threads N  Threads used to detect ball and brick collisions (default 1)
+//
+///////////////////////////////////////////////////////////////////////////
+
+#include "game.h"
+#include "level_generator.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+// Constants for the simulated screen (matches Source.cpp)
+const unsigned int SCREEN_WIDTH = 800;
+const unsigned int SCREEN_HEIGHT = 600;
+
+// Fixed time step used for every simulated frame (60 frames per second)
+const float FRAME_DT = 1.0f / 60.0f;
+
+// Typedef for the clock used to time the benchmark
+typedef std::chrono::steady_clock BenchClock;
+
+
+// Method to return the elapsed microseconds between two time points
+// -----------------------------------------------------------------
+double ElapsedMicroseconds(BenchClock::time_point start, BenchClock::time_point end)
+{
+    return std::chrono::duration<double, std::micro>(end - start).count();
+}
+
+
+// Method to simulate one frame of the generated level (the non-fixed point path of Game::UpdateGame)
+// NOTE: Leaves out the level cleared and game over checks, so the game never leaves the generated level
+// -----------------------------------------------------------------------------------------------------
+void SimulateFrame(Game& game, float dt)
+{
+    game.gameTime += dt;
+
+    for (BallObject ball_object : game.ballObjects)
+    {
+        if (ball_object.isInPlay && !ball_object.isHeld && !ball_object.isDestroyed)
+            ball_object.MoveBall(dt, game.windowWidth);
+    }
+
+    game.ProcessCollisions();
+
+    // Balls which passed below the bottom of the screen are lost (and relaunched by the caller)
+    for (BallObject ball_object : game.ballObjects)
+    {
+        if (ball_object.Position.y >= game.windowHeight)
+            ball_object.isDestroyed = true;
+    }
+}
+
+
+// Method to launch a ball object from a random point below the bricks
+// -------------------------------------------------------------------
+void LaunchBall(BallObject ball_object, std::mt19937& random_engine)
+{
+    // Random values in the range [0, 1)
+    float randomX = (random_engine() >> 8) * (1.0f / 16777216.0f);
+    float randomY = (random_engine() >> 8) * (1.0f / 16777216.0f);
+
+    ball_object.Position = glm::vec2(randomX * (SCREEN_WIDTH - ball_object.Size.x), SCREEN_HEIGHT * (0.4f + 0.4f * randomY));
+    ball_object.Velocity = glm::vec2((randomX < 0.5f) ? -100.0f : 100.0f, -350.0f);
+    ball_object.isInPlay = true;
+    ball_object.isHeld = false;
+    ball_object.isDestroyed = false;
+}
+
+
+int main(int argc, char* argv[])
+{
+    // Benchmark settings
+    unsigned int minTiles = 100;
+    unsigned int maxTiles = 1000000;
+    unsigned int numFrames = 600;
+    unsigned int numBalls = 5;
+    float density = 0.6f;
+    unsigned int seed = 1;
+    const char* csvFile = nullptr;
+    bool writeLevels = false;
+    unsigned int collisionThreads = 1;
+
+    // Read the command line options
+    for (int i = 1; i < argc; ++i)
+    {
+        bool hasValue = (i + 1 < argc);
+
+        if (std::strcmp(argv[i], "--min-tiles") == 0 && hasValue)
+            minTiles = std::strtoul(argv[++i], nullptr, 10);
+        else if (std::strcmp(argv[i], "--max-tiles") == 0 && hasValue)
+            maxTiles = std::strtoul(argv[++i], nullptr, 10);
+        else if (std::strcmp(argv[i], "--frames") == 0 && hasValue)
+            numFrames = std::strtoul(argv[++i], nullptr, 10);
+        else if (std::strcmp(argv[i], "--balls") == 0 && hasValue)
+            numBalls = std::strtoul(argv[++i], nullptr, 10);
+        else if (std::strcmp(argv[i], "--density") == 0 && hasValue)
+            density = std::strtof(argv[++i], nullptr);
+        else if (std::strcmp(argv[i], "--seed") == 0 && hasValue)
+            seed = std::strtoul(argv[++i], nullptr, 10);
+        else if (std::strcmp(argv[i], "--csv") == 0 && hasValue)
+            csvFile = argv[++i];
+        else if (std::strcmp(argv[i], "--write-levels") == 0)
+            writeLevels = true;
+        else if (std::strcmp(argv[i], "--collision-threads") == 0 && hasValue)
+            collisionThreads = std::strtoul(argv[++i], nullptr, 10);
+        else
+        {
+            std::cout << "Error: Unknown option " << argv[i] << std::endl;
+            return -1;
+        }
+    }
+
+    if (numBalls == 0 || numFrames == 0 || minTiles == 0)
+    {
+        std::cout << "Error: --balls, --frames and --min-tiles must be greater than zero" << std::endl;
+        return -1;
+    }
+
+    // Create the game without a window
+    Game game(SCREEN_WIDTH, SCREEN_HEIGHT);
+    game.InitSimulation();
+    game.SetCollisionThreads(collisionThreads);
+
+    // Fill the ball objects archetype with the requested number of balls
+    game.ballObjects.Clear();
+
+    for (unsigned int i = 0; i < numBalls; ++i)
+    {
+        BallObject ball_object = game.ballObjects.Add();
+        ball_object.InitBall(SCREEN_WIDTH, SCREEN_HEIGHT, game.player);
+    }
+
+    // Open the per-frame output file if requested
+    std::ofstream csvStream;
+
+    if (csvFile != nullptr)
+    {
+        csvStream.open(csvFile);
+        csvStream << "tiles,frame,frame_us,live_bricks\n";
+    }
+
+    std::cout << "tiles      bricks     build_ms   mean_us    p50_us     p99_us     max_us" << std::endl;
+
+    LevelGenerator generator(seed);
+    generator.density = density;
+
+    // Sweep the level size by powers of ten
+    for (unsigned long long tiles = minTiles; tiles <= maxTiles; tiles *= 10)
+    {
+        generator.SetSeed(seed);
+        generator.SetGridForTileCount(static_cast<unsigned int>(tiles));
+
+        // Write the level to file as well, if requested
+        if (writeLevels)
+        {
+            std::string levelFile = "generated_" + std::to_string(tiles) + ".lvl";
+            generator.WriteLevelFile(levelFile.c_str());
+            generator.SetSeed(seed);
+        }
+
+        // Time generating and building the level (fills the top third of the window like the real levels)
+        BenchClock::time_point buildStart = BenchClock::now();
+        generator.BuildLevel(game.activeLevel, SCREEN_WIDTH, SCREEN_HEIGHT / 3);
+        BenchClock::time_point buildEnd = BenchClock::now();
+
+        // Count the bricks which can actually be hit
+        unsigned int liveBricks = game.activeLevel.liveBricks;
+
+        // Launch every ball from the same sequence for each level size
+        std::mt19937 launchEngine(seed);
+
+        for (BallObject ball_object : game.ballObjects)
+        {
+            LaunchBall(ball_object, launchEngine);
+        }
+
+        std::vector<double> frameTimes;
+        frameTimes.reserve(numFrames);
+
+        // Run the simulated frames
+        for (unsigned int frame = 0; frame < numFrames; ++frame)
+        {
+            BenchClock::time_point frameStart = BenchClock::now();
+            SimulateFrame(game, FRAME_DT);
+            BenchClock::time_point frameEnd = BenchClock::now();
+
+            double frameTime = ElapsedMicroseconds(frameStart, frameEnd);
+            frameTimes.push_back(frameTime);
+
+            if (csvStream)
+            {
+                csvStream << tiles << ',' << frame << ',' << frameTime << ',' << liveBricks << '\n';
+            }
+
+            // Relaunch any ball which dropped below the screen so the ball count stays constant
+            for (BallObject ball_object : game.ballObjects)
+            {
+                if (ball_object.isDestroyed)
+                    LaunchBall(ball_object, launchEngine);
+            }
+
+            // Build the level again once every brick has been destroyed, so the remaining frames still have bricks to hit
+            if (game.IsLevelComplete())
+            {
+                generator.SetSeed(seed);
+                generator.BuildLevel(game.activeLevel, SCREEN_WIDTH, SCREEN_HEIGHT / 3);
+            }
+        }
+
+        // Calculate the frame time statistics
+        double totalTime = 0.0;
+
+        for (double frameTime : frameTimes)
+        {
+            totalTime += frameTime;
+        }
+
+        std::sort(frameTimes.begin(), frameTimes.end());
+
+        double meanTime = totalTime / frameTimes.size();
+        double p50Time = frameTimes[frameTimes.size() / 2];
+        double p99Time = frameTimes[(frameTimes.size() * 99) / 100];
+        double maxTime = frameTimes.back();
+
+        std::cout.width(11); std::cout << std::left << tiles;
+        std::cout.width(11); std::cout << liveBricks;
+        std::cout.width(11); std::cout << ElapsedMicroseconds(buildStart, buildEnd) / 1000.0;
+        std::cout.width(11); std::cout << meanTime;
+        std::cout.width(11); std::cout << p50Time;
+        std::cout.width(11); std::cout << p99Time;
+        std::cout << maxTime << std::endl;
+
+        // Stop before the tile count overflows
+        if (tiles > maxTiles / 10)
+            break;
+    }
+
+    return 0;
+}
@@ -0,0 +1,169 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//  BREAKOUT REMIX
+//  --------------
+//  by slate2b
+//
+//  The LevelGenerator class creates procedural game levels from a seed.
+//  It is used to stress-test the game at grid sizes far beyond the
+//  hand-made levels (from 10^2 up to 10^6 tiles).
+//
+//  The same seed and settings always produce the same tile data, on
+//  every platform, so generated levels can be compared between builds.
+//
+//  The LevelGenerator class is responsible for the following:
+//
+//     * Generating tile data with a configurable grid size
+//     * Controlling how many tiles hold a brick (density)
+//	   * Controlling the mix of tile types (brick colors)
+//     * Writing the tile data to a .lvl file
+//	   * Building a GameLevel directly from the tile data in memory
+//
+///////////////////////////////////////////////////////////////////////////
+
+#include "level_generator.h"
+
+#include <cmath>
+#include <fstream>
+#include <iostream>
+
+LevelGenerator::LevelGenerator(unsigned int seed)
+{
+    // Default to the size and feel of the original level
+    rows = 10;
+    columns = 15;
+    density = 0.6f;
+
+    // Equal mix of all tile types
+    for (unsigned int i = 0; i < NUM_TILE_TYPES; ++i)
+    {
+        tileWeights[i] = 1.0f;
+    }
+
+    this->SetSeed(seed);
+}
+
+
+// Method to restart the random sequence from a new seed
+// -----------------------------------------------------
+void LevelGenerator::SetSeed(unsigned int seed)
+{
+    this->randomEngine.seed(seed);
+}
+
+
+// Method to choose a roughly square grid holding at least tile_count tiles
+// ------------------------------------------------------------------------
+void LevelGenerator::SetGridForTileCount(unsigned int tile_count)
+{
+    // Make sure there is at least one tile
+    if (tile_count == 0)
+        tile_count = 1;
+
+    this->columns = static_cast<unsigned int>(std::ceil(std::sqrt(static_cast<double>(tile_count))));
+    this->rows = (tile_count + this->columns - 1) / this->columns;
+}
+
+
+// Method to generate the tile data for a level
+// --------------------------------------------
+std::vector<std::vector<unsigned int>> LevelGenerator::GenerateTileData()
+{
+    // Creating a 2D std::vector to hold the tile data (0 = empty space)
+    std::vector<std::vector<unsigned int>> tileData(this->rows, std::vector<unsigned int>(this->columns, 0));
+
+    // Loop through each row
+    for (unsigned int y = 0; y < this->rows; ++y)
+    {
+        // Loop through each cell within the row
+        for (unsigned int x = 0; x < this->columns; ++x)
+        {
+            // Place a brick in this cell based on the density setting
+            if (this->RandomFloat() < this->density)
+            {
+                tileData[y][x] = this->RandomTileType();
+            }
+        }
+    }
+
+    return tileData;
+}
+
+
+// Method to generate a level and write it to a .lvl file
+// ------------------------------------------------------
+bool LevelGenerator::WriteLevelFile(const char* file)
+{
+    // Creating a ofstream to write data to file
+    std::ofstream fstream(file);
+
+    if (!fstream)
+    {
+        std::cout << "Error: Writing Level File " << file << std::endl;
+        return false;
+    }
+
+    std::vector<std::vector<unsigned int>> tileData = this->GenerateTileData();
+
+    // Write the tile data using the same layout as the hand-made level files
+    for (const std::vector<unsigned int>& row : tileData)
+    {
+        for (unsigned int tileType : row)
+        {
+            fstream << tileType << ' ';
+        }
+
+        fstream << '\n';
+    }
+
+    return static_cast<bool>(fstream);
+}
+
+
+// Method to generate a level and build it directly into a GameLevel
+// NOTE: level_width and level_height refer to the width and height of the collection of bricks to be broken
+// ---------------------------------------------------------------------------------------------------------
+void LevelGenerator::BuildLevel(GameLevel& level, unsigned int level_width, unsigned int level_height)
+{
+    level.LoadTileData(this->GenerateTileData(), level_width, level_height);
+}
+
+
+// Method to return a random float in the range [0, 1)
+// ---------------------------------------------------
+float LevelGenerator::RandomFloat()
+{
+    // Use the top 24 bits of the 32 bit output so the value is exact as a float
+    return (this->randomEngine() >> 8) * (1.0f / 16777216.0f);
+}
+
+
+// Method to pick a tile type based on the tile weights
+// ----------------------------------------------------
+unsigned int LevelGenerator::RandomTileType()
+{
+    // Add up the tile weights
+    float totalWeight = 0.0f;
+
+    for (unsigned int i = 0; i < NUM_TILE_TYPES; ++i)
+    {
+        totalWeight += this->tileWeights[i];
+    }
+
+    // Fall back to the first tile type if every weight is zero
+    if (totalWeight <= 0.0f)
+        return 1;
+
+    // Walk the weights until the random value falls inside one of them
+    float pick = this->RandomFloat() * totalWeight;
+
+    for (unsigned int i = 0; i < NUM_TILE_TYPES; ++i)
+    {
+        if (pick < this->tileWeights[i])
+            return i + 1;
+
+        pick -= this->tileWeights[i];
+    }
+
+    return NUM_TILE_TYPES;
+}
@@ -0,0 +1,82 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//  BREAKOUT REMIX
+//  --------------
+//  by slate2b
+//
+//  The LevelGenerator class creates procedural game levels from a seed.
+//  It is used to stress-test the game at grid sizes far beyond the
+//  hand-made levels (from 10^2 up to 10^6 tiles).
+//
+//  The same seed and settings always produce the same tile data, on
+//  every platform, so generated levels can be compared between builds.
+//
+//  The LevelGenerator class is responsible for the following:
+//
+//     * Generating tile data with a configurable grid size
+//     * Controlling how many tiles hold a brick (density)
+//	   * Controlling the mix of tile types (brick colors)
+//     * Writing the tile data to a .lvl file
+//	   * Building a GameLevel directly from the tile data in memory
+//
+///////////////////////////////////////////////////////////////////////////
+
+#ifndef LEVELGENERATOR_H
+#define LEVELGENERATOR_H
+
+#include <vector>
+#include <random>
+
+#include "game_level.h"
+
+class LevelGenerator
+{
+
+public:
+
+	// Number of brick tile types (tile types 1 through 6)
+	static const unsigned int NUM_TILE_TYPES = 6;
+
+	// Grid size of the generated level
+	unsigned int rows;
+	unsigned int columns;
+
+	// Fraction of tiles which hold a brick (0.0 = empty level, 1.0 = every tile is a brick)
+	float density;
+
+	// Relative weight of each tile type (index 0 is tile type 1)
+	float tileWeights[NUM_TILE_TYPES];
+
+	// Constructor
+	LevelGenerator(unsigned int seed);
+
+	// Method to restart the random sequence from a new seed
+	void SetSeed(unsigned int seed);
+
+	// Method to choose a roughly square grid holding at least tile_count tiles
+	void SetGridForTileCount(unsigned int tile_count);
+
+	// Method to generate the tile data for a level
+	std::vector<std::vector<unsigned int>> GenerateTileData();
+
+	// Method to generate a level and write it to a .lvl file
+	bool WriteLevelFile(const char* file);
+
+	// Method to generate a level and build it directly into a GameLevel
+	// NOTE: level_width and level_height refer to the width and height of the collection of bricks to be broken
+	void BuildLevel(GameLevel& level, unsigned int level_width, unsigned int level_height);
+
+private:
+
+	// Random number generator (std::mt19937 produces the same sequence on every platform)
+	std::mt19937 randomEngine;
+
+	// Method to return a random float in the range [0, 1)
+	// NOTE: Used instead of std::uniform_real_distribution, whose output differs between standard libraries
+	float RandomFloat();
+
+	// Method to pick a tile type based on the tile weights
+	unsigned int RandomTileType();
+};
+
+#endif
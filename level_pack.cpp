@@ -0,0 +1,456 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//  BREAKOUT REMIX
+//  --------------
+//  by slate2b
+//
+//  The LevelPack class manages a collection of game levels listed in a
+//  level pack manifest file.
+//
+//  The manifest is a plain text file with one level file per line.
+//  Blank lines and lines starting with '#' are ignored.  Level file
+//  paths are relative to the folder the manifest is stored in.
+//
+//  The LevelPack class is responsible for the following:
+//
+//     * Loading the list of level files from the manifest
+//     * Running a loader thread which builds levels in the background
+//	   * Prefetching the next level while the current level is played
+//     * Keeping only a bounded number of built levels in memory
+//	   * Handing a fresh copy of a built level to the game
+//     * Patching built levels when their level files change
+//
+///////////////////////////////////////////////////////////////////////////
+
+#include "level_pack.h"
+
+#include <fstream>
+#include <iostream>
+
+LevelPack::LevelPack()
+{
+    levelWidth = 0;
+    levelHeight = 0;
+    maxResidentLevels = DEFAULT_MAX_RESIDENT_LEVELS;
+    activeLevelIndex = 0;
+    isRetainingPrevious = false;
+    previousLevelIndex = -1;
+    levelInProgress = -1;
+    isProgressStale = false;
+    manifestGeneration = 0;
+    isBackgroundLoading = true;
+    isStopping = false;
+}
+
+LevelPack::~LevelPack()
+{
+    this->StopLoader();
+}
+
+
+// Method to load the list of level files from a manifest file (replacing any levels loaded before)
+// NOTE: level_width and level_height refer to the width and height of the collection of bricks to be broken
+// ---------------------------------------------------------------------------------------------------------
+bool LevelPack::LoadManifest(const char* manifest_file, unsigned int level_width, unsigned int level_height)
+{
+    // Store the level size first, so levels added with AddLevelFile are built to it even if the manifest is missing
+    {
+        std::lock_guard<std::mutex> lock(this->packMutex);
+        this->levelWidth = level_width;
+        this->levelHeight = level_height;
+    }
+
+    // Creating a ifstream to read the manifest
+    std::ifstream fstream(manifest_file);
+
+    // If the manifest could not be opened...
+    if (!fstream)
+    {
+        std::cout << "Error: Level Pack Manifest " << manifest_file << std::endl;
+        return false;
+    }
+
+    // Level file paths are relative to the folder holding the manifest
+    std::string manifestPath(manifest_file);
+    std::string::size_type lastSeparator = manifestPath.find_last_of("/\\");
+    std::string manifestFolder = (lastSeparator == std::string::npos) ? "" : manifestPath.substr(0, lastSeparator + 1);
+
+    // Collect the level files listed in the manifest before taking the lock
+    std::vector<std::string> files;
+    std::string line;
+
+    // While there are still lines to read in the manifest
+    while (std::getline(fstream, line))
+    {
+        // Trim whitespace (including a Windows line ending) from both ends of the line
+        std::string::size_type first = line.find_first_not_of(" \t\r");
+        std::string::size_type last = line.find_last_not_of(" \t\r");
+
+        // Skip blank lines
+        if (first == std::string::npos)
+            continue;
+
+        line = line.substr(first, last - first + 1);
+
+        // Skip comment lines
+        if (line[0] == '#')
+            continue;
+
+        files.push_back(manifestFolder + line);
+    }
+
+    // Replace any previously loaded pack
+    // NOTE: A level the loader thread is building from the old manifest is thrown away once it is done (see LoaderLoop)
+    std::lock_guard<std::mutex> lock(this->packMutex);
+    this->manifestGeneration += 1;
+    this->levelFiles = files;
+    this->residentLevels.clear();
+    this->loadQueue.clear();
+    this->activeLevelIndex = 0;
+    this->previousLevelIndex = -1;
+
+    return !this->levelFiles.empty();
+}
+
+
+// Method to add a single level file to the end of the pack
+// --------------------------------------------------------
+void LevelPack::AddLevelFile(const std::string& level_file)
+{
+    std::lock_guard<std::mutex> lock(this->packMutex);
+    this->levelFiles.push_back(level_file);
+}
+
+
+// Method to set how many built levels may stay in memory at once (minimum of 2)
+// NOTE: Two is the minimum so the next level can be built while the current one is played
+// ---------------------------------------------------------------------------------------
+void LevelPack::SetMaxResidentLevels(unsigned int max_resident_levels)
+{
+    std::lock_guard<std::mutex> lock(this->packMutex);
+    this->maxResidentLevels = (max_resident_levels < 2) ? 2 : max_resident_levels;
+}
+
+
+// Method to choose whether levels are built by the loader thread or by AcquireLevel on the calling thread
+// NOTE: Many games run side by side (e.g. training environments) would otherwise start a loader thread each
+// ---------------------------------------------------------------------------------------------------------
+void LevelPack::SetBackgroundLoading(bool is_background)
+{
+    std::lock_guard<std::mutex> lock(this->packMutex);
+    this->isBackgroundLoading = is_background;
+}
+
+
+// Method to also keep the level handed out before the active level in memory
+// NOTE: A rollback across a level change restores the previous level, which would otherwise have to be built again
+// ---------------------------------------------------------------------------------------------------------------
+void LevelPack::SetRetainPreviousLevel(bool is_retaining)
+{
+    std::lock_guard<std::mutex> lock(this->packMutex);
+    this->isRetainingPrevious = is_retaining;
+}
+
+
+// Method to return the number of levels in the pack
+// -------------------------------------------------
+unsigned int LevelPack::GetLevelCount()
+{
+    std::lock_guard<std::mutex> lock(this->packMutex);
+    return static_cast<unsigned int>(this->levelFiles.size());
+}
+
+
+// Method to return a copy of the level file paths, in pack order
+// ---------------------------------------------------------------
+std::vector<std::string> LevelPack::GetLevelFiles()
+{
+    std::lock_guard<std::mutex> lock(this->packMutex);
+    return this->levelFiles;
+}
+
+
+// Method to return the number of built levels currently in memory
+// ---------------------------------------------------------------
+unsigned int LevelPack::GetResidentLevelCount()
+{
+    std::lock_guard<std::mutex> lock(this->packMutex);
+    return static_cast<unsigned int>(this->residentLevels.size());
+}
+
+
+// Method to ask the loader thread to build a level in the background
+// ------------------------------------------------------------------
+void LevelPack::PrefetchLevel(unsigned int level_index)
+{
+    std::lock_guard<std::mutex> lock(this->packMutex);
+
+    // Ignore levels outside the pack and levels which are already built or on their way
+    // NOTE: Without the loader thread, levels are only built when they are acquired
+    if (!this->isBackgroundLoading || level_index >= this->levelFiles.size() || this->IsLevelPending(level_index))
+        return;
+
+    this->StartLoader();
+
+    // Add the level to the back of the queue and wake the loader thread
+    this->loadQueue.push_back(level_index);
+    this->loadRequested.notify_one();
+}
+
+
+// Method to copy a built level into level_out
+// NOTE: Waits for the loader thread if the level has not been built yet
+// ---------------------------------------------------------------------
+bool LevelPack::AcquireLevel(unsigned int level_index, GameLevel& level_out)
+{
+    std::unique_lock<std::mutex> lock(this->packMutex);
+
+    // Make sure the requested level is part of the pack
+    if (level_index >= this->levelFiles.size())
+        return false;
+
+    // The active level is never evicted, so it stays resident while we wait for it (and so does the previous one, if retained)
+    if (level_index != this->activeLevelIndex)
+        this->previousLevelIndex = static_cast<int>(this->activeLevelIndex);
+
+    this->activeLevelIndex = level_index;
+
+    // Without the loader thread, build the level here
+    if (!this->isBackgroundLoading && this->FindResidentLevel(level_index) == nullptr)
+    {
+        GameLevel level;
+        level.Load(this->levelFiles[level_index].c_str(), this->levelWidth, this->levelHeight);
+        this->StoreLevel(level_index, level);
+    }
+
+    // Wait until the level has been built
+    while (this->FindResidentLevel(level_index) == nullptr)
+    {
+        // If nobody has asked for this level yet, put it at the front of the queue
+        if (!this->IsLevelPending(level_index))
+        {
+            this->StartLoader();
+            this->loadQueue.push_front(level_index);
+            this->loadRequested.notify_one();
+        }
+
+        this->loadFinished.wait(lock);
+    }
+
+    // Hand the game its own copy so the built level can be reused when the level is reset
+    level_out = this->FindResidentLevel(level_index)->level;
+
+    return true;
+}
+
+
+// Method to patch a built level to the new tile data of its level file
+// NOTE: Only tries the lock, so the game never waits for the loader thread.  Only the changed bricks are
+//       touched; if the size of the grid changed, the level is dropped and built again by the loader thread.
+// ------------------------------------------------------------------------------------------------------------
+bool LevelPack::PatchLevel(unsigned int level_index, const std::vector<std::vector<unsigned int>>& tile_data)
+{
+    std::unique_lock<std::mutex> lock(this->packMutex, std::try_to_lock);
+
+    if (!lock.owns_lock())
+        return false;
+
+    ResidentLevel* resident = this->FindResidentLevel(level_index);
+
+    if (resident != nullptr)
+    {
+        unsigned int changed = 0;
+
+        if (!resident->level.PatchTiles(tile_data, changed))
+        {
+            // Every brick moves, so rebuild the level from its file in the background rather than on the game's thread
+            // NOTE: Without the loader thread, the level is built again when it is next acquired
+            this->residentLevels.erase(this->residentLevels.begin() + (resident - this->residentLevels.data()));
+
+            if (this->isBackgroundLoading)
+            {
+                this->StartLoader();
+                this->loadQueue.push_front(level_index);
+                this->loadRequested.notify_one();
+            }
+        }
+    }
+    else if (this->levelInProgress == static_cast<int>(level_index))
+    {
+        this->isProgressStale = true;
+    }
+
+    return true;
+}
+
+
+// Method run by the loader thread
+// -------------------------------
+void LevelPack::LoaderLoop()
+{
+    std::unique_lock<std::mutex> lock(this->packMutex);
+
+    while (true)
+    {
+        // Sleep until there is a level to build or the pack is shutting down
+        this->loadRequested.wait(lock, [this] { return this->isStopping || !this->loadQueue.empty(); });
+
+        if (this->isStopping)
+            break;
+
+        // Take the next level index from the queue
+        unsigned int levelIndex = this->loadQueue.front();
+        this->loadQueue.pop_front();
+
+        // Skip levels which were built since they were queued
+        if (this->FindResidentLevel(levelIndex) != nullptr || levelIndex >= this->levelFiles.size())
+            continue;
+
+        this->levelInProgress = static_cast<int>(levelIndex);
+        this->isProgressStale = false;
+        std::string levelFile = this->levelFiles[levelIndex];
+        unsigned int width = this->levelWidth;
+        unsigned int height = this->levelHeight;
+        unsigned int generation = this->manifestGeneration;
+
+        // Parse and build the level without holding the lock so the game never waits on file access
+        lock.unlock();
+        GameLevel level;
+        level.Load(levelFile.c_str(), width, height);
+        lock.lock();
+
+        // If another manifest was loaded meanwhile, the level belongs to the old pack (anyone waiting asks again)
+        if (generation != this->manifestGeneration)
+        {
+            this->levelInProgress = -1;
+            this->loadFinished.notify_all();
+            continue;
+        }
+
+        // If the level file changed while it was being read, read it again
+        if (this->isProgressStale)
+        {
+            this->levelInProgress = -1;
+            this->loadQueue.push_front(levelIndex);
+            continue;
+        }
+
+        this->StoreLevel(levelIndex, level);
+        this->levelInProgress = -1;
+
+        // Wake anyone waiting in AcquireLevel
+        this->loadFinished.notify_all();
+    }
+}
+
+
+// Method to start the loader thread if it is not already running
+// NOTE: packMutex must be held by the caller
+// --------------------------------------------------------------
+void LevelPack::StartLoader()
+{
+    if (!this->loaderThread.joinable())
+    {
+        this->isStopping = false;
+        this->loaderThread = std::thread(&LevelPack::LoaderLoop, this);
+    }
+}
+
+
+// Method to stop and join the loader thread
+// -----------------------------------------
+void LevelPack::StopLoader()
+{
+    {
+        std::lock_guard<std::mutex> lock(this->packMutex);
+        this->isStopping = true;
+        this->loadRequested.notify_all();
+    }
+
+    if (this->loaderThread.joinable())
+        this->loaderThread.join();
+}
+
+
+// Method to find a built level in memory (returns nullptr if not resident)
+// ------------------------------------------------------------------------
+LevelPack::ResidentLevel* LevelPack::FindResidentLevel(unsigned int level_index)
+{
+    for (ResidentLevel& resident : this->residentLevels)
+    {
+        if (resident.levelIndex == level_index)
+            return &resident;
+    }
+
+    return nullptr;
+}
+
+
+// Method to check whether a level is resident, queued, or being built
+// -------------------------------------------------------------------
+bool LevelPack::IsLevelPending(unsigned int level_index)
+{
+    if (this->FindResidentLevel(level_index) != nullptr)
+        return true;
+
+    if (this->levelInProgress == static_cast<int>(level_index))
+        return true;
+
+    for (unsigned int queued : this->loadQueue)
+    {
+        if (queued == level_index)
+            return true;
+    }
+
+    return false;
+}
+
+
+// Method to store a newly built level, evicting another level if the limit has been reached
+// -----------------------------------------------------------------------------------------
+// * Levels behind the active level are evicted first, then the level furthest ahead of it
+// ----------------------------------------------------------------------------------------
+void LevelPack::StoreLevel(unsigned int level_index, GameLevel& level)
+{
+    while (this->residentLevels.size() >= this->maxResidentLevels)
+    {
+        // Variables used to find the least useful resident level
+        int evictSlot = -1;
+        unsigned long long worstScore = 0;
+
+        for (unsigned int i = 0; i < this->residentLevels.size(); ++i)
+        {
+            unsigned int index = this->residentLevels[i].levelIndex;
+
+            // Never evict the level the game is currently using (or the one it used before, if retained)
+            if (index == this->activeLevelIndex)
+                continue;
+
+            if (this->isRetainingPrevious && static_cast<int>(index) == this->previousLevelIndex)
+                continue;
+
+            // Levels behind the active level score higher than any level ahead of it
+            unsigned long long score = (index < this->activeLevelIndex)
+                ? 0x100000000ULL + (this->activeLevelIndex - index)
+                : index - this->activeLevelIndex;
+
+            if (evictSlot < 0 || score > worstScore)
+            {
+                evictSlot = static_cast<int>(i);
+                worstScore = score;
+            }
+        }
+
+        // Only the active (and retained previous) level is resident, so there is nothing left to evict
+        if (evictSlot < 0)
+            break;
+
+        this->residentLevels.erase(this->residentLevels.begin() + evictSlot);
+    }
+
+    // Move the built bricks into the resident list instead of copying them
+    ResidentLevel resident;
+    resident.levelIndex = level_index;
+    resident.level.Swap(level);
+    this->residentLevels.push_back(std::move(resident));
+}
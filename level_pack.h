@@ -0,0 +1,161 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//  BREAKOUT REMIX
+//  --------------
+//  by slate2b
+//
+//  The LevelPack class manages a collection of game levels listed in a
+//  level pack manifest file.
+//
+//  The manifest is a plain text file with one level file per line.
+//  Blank lines and lines starting with '#' are ignored.  Level file
+//  paths are relative to the folder the manifest is stored in.
+//
+//  The LevelPack class is responsible for the following:
+//
+//     * Loading the list of level files from the manifest
+//     * Running a loader thread which builds levels in the background
+//	   * Prefetching the next level while the current level is played
+//     * Keeping only a bounded number of built levels in memory
+//	   * Handing a fresh copy of a built level to the game
+//     * Patching built levels when their level files change
+//
+///////////////////////////////////////////////////////////////////////////
+
+#ifndef LEVELPACK_H
+#define LEVELPACK_H
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include "game_level.h"
+
+class LevelPack
+{
+
+public:
+
+	// Number of built levels kept in memory by default (the current level and the next level)
+	static const unsigned int DEFAULT_MAX_RESIDENT_LEVELS = 2;
+
+	// Constructor
+	LevelPack();
+
+	// Destructor (stops the loader thread)
+	~LevelPack();
+
+	// Method to load the list of level files from a manifest file (replacing any levels loaded before)
+	// NOTE: level_width and level_height refer to the width and height of the collection of bricks to be broken.
+	//       The loader thread is only started once the first level is prefetched or acquired.
+	bool LoadManifest(const char* manifest_file, unsigned int level_width, unsigned int level_height);
+
+	// Method to add a single level file to the end of the pack
+	void AddLevelFile(const std::string& level_file);
+
+	// Method to set how many built levels may stay in memory at once (minimum of 2)
+	void SetMaxResidentLevels(unsigned int max_resident_levels);
+
+	// Method to choose whether levels are built by the loader thread (the default) or by AcquireLevel on the calling thread
+	// NOTE: Without the loader thread, PrefetchLevel does nothing.  Set before the first level is acquired.
+	void SetBackgroundLoading(bool is_background);
+
+	// Method to also keep the level handed out before the active level in memory (e.g. for rollbacks across a level change)
+	// NOTE: The previous level is never evicted either, so one more level than the limit may be in memory
+	void SetRetainPreviousLevel(bool is_retaining);
+
+	// Method to return the number of levels in the pack
+	unsigned int GetLevelCount();
+
+	// Method to return a copy of the level file paths, in pack order
+	std::vector<std::string> GetLevelFiles();
+
+	// Method to return the number of built levels currently in memory
+	unsigned int GetResidentLevelCount();
+
+	// Method to ask the loader thread to build a level in the background
+	void PrefetchLevel(unsigned int level_index);
+
+	// Method to copy a built level into level_out
+	// NOTE: Waits for the loader thread if the level has not been built yet
+	bool AcquireLevel(unsigned int level_index, GameLevel& level_out);
+
+	// Method to patch a built level to the new tile data of its level file (returns false if the pack was busy, try again later)
+	// NOTE: Never waits for the loader thread.  A level being built right now, or whose grid size changed, is built again
+	//       by the loader thread (from the saved level file)
+	bool PatchLevel(unsigned int level_index, const std::vector<std::vector<unsigned int>>& tile_data);
+
+private:
+
+	// Struct to hold a built level along with its position in the pack
+	struct ResidentLevel
+	{
+		unsigned int levelIndex;
+		GameLevel level;
+	};
+
+	// Level file paths listed in the manifest
+	std::vector<std::string> levelFiles;
+
+	// Dimensions used when building the levels
+	unsigned int levelWidth;
+	unsigned int levelHeight;
+
+	// Built levels currently held in memory
+	std::vector<ResidentLevel> residentLevels;
+	unsigned int maxResidentLevels;
+
+	// Index of the level most recently handed to the game (never evicted)
+	unsigned int activeLevelIndex;
+
+	// Index of the level handed to the game before the active level (never evicted while retaining, -1 when none)
+	bool isRetainingPrevious;
+	int previousLevelIndex;
+
+	// Queue of level indices waiting to be built by the loader thread
+	std::deque<unsigned int> loadQueue;
+
+	// Index of the level the loader thread is building right now (-1 when idle)
+	int levelInProgress;
+
+	// Set when the file of the level being built changed during the build (the level is built again)
+	bool isProgressStale;
+
+	// Counts the manifests loaded, so a level built from a replaced manifest is thrown away
+	unsigned int manifestGeneration;
+
+	// Loader thread and the variables used to communicate with it
+	// NOTE: isBackgroundLoading is false when levels are built on the calling thread instead (no loader thread is started)
+	bool isBackgroundLoading;
+	std::thread loaderThread;
+	std::mutex packMutex;
+	std::condition_variable loadRequested;
+	std::condition_variable loadFinished;
+	bool isStopping;
+
+	// Method run by the loader thread
+	void LoaderLoop();
+
+	// Method to start the loader thread if it is not already running
+	void StartLoader();
+
+	// Method to stop and join the loader thread
+	void StopLoader();
+
+	// Method to find a built level in memory (returns nullptr if not resident)
+	// NOTE: packMutex must be held by the caller
+	ResidentLevel* FindResidentLevel(unsigned int level_index);
+
+	// Method to check whether a level is resident, queued, or being built
+	// NOTE: packMutex must be held by the caller
+	bool IsLevelPending(unsigned int level_index);
+
+	// Method to store a newly built level, evicting another level if the limit has been reached
+	// NOTE: packMutex must be held by the caller
+	void StoreLevel(unsigned int level_index, GameLevel& level);
+};
+
+#endif
@@ -0,0 +1,343 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//  BREAKOUT REMIX
+//  --------------
+//  by slate2b
+//
+//  The LevelWatcher class watches the level files for edits while the
+//  game runs.
+//
+//  The LevelWatcher class is responsible for the following:
+//
+//     * Running the watcher thread
+//     * Noticing when a level file was saved
+//     * Reading and checking the new tile data
+//     * Handing the edits to the game without blocking it
+//
+///////////////////////////////////////////////////////////////////////////
+
+#include "level_watcher.h"
+#include "game_level.h"
+
+#include <chrono>
+#include <iostream>
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#else
+#include <filesystem>
+#endif
+
+
+// Method to split a file path into its folder ("." if it has none) and file name
+// ------------------------------------------------------------------------------
+static void SplitPath(const std::string& path, std::string& folder_out, std::string& name_out)
+{
+    std::string::size_type lastSeparator = path.find_last_of("/\\");
+
+    if (lastSeparator == std::string::npos)
+    {
+        folder_out = ".";
+        name_out = path;
+    }
+    else
+    {
+        folder_out = path.substr(0, lastSeparator);
+        name_out = path.substr(lastSeparator + 1);
+    }
+}
+
+
+LevelWatcher::LevelWatcher()
+{
+    this->isStopping = false;
+    this->notifyHandle = -1;
+    this->hasEdits = false;
+}
+
+LevelWatcher::~LevelWatcher()
+{
+    this->Stop();
+}
+
+
+// Method to start watching level files (level_files[i] is level i)
+// ----------------------------------------------------------------
+bool LevelWatcher::Start(const std::vector<std::string>& level_files)
+{
+    this->Stop();
+
+    if (level_files.empty())
+    {
+        std::cout << "Error: No level files to watch" << std::endl;
+        return false;
+    }
+
+    this->levelFiles = level_files;
+
+#ifdef __linux__
+    this->notifyHandle = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+
+    if (this->notifyHandle < 0)
+    {
+        std::cout << "Error: Could not start watching the level files (inotify)" << std::endl;
+        return false;
+    }
+
+    // Watch the folders rather than the files, as many editors save by writing a new file and renaming it
+    for (const std::string& levelFile : this->levelFiles)
+    {
+        std::string folder;
+        std::string name;
+        SplitPath(levelFile, folder, name);
+
+        bool isWatched = false;
+
+        for (const std::pair<int, std::string>& watched : this->watchedFolders)
+        {
+            if (watched.second == folder)
+                isWatched = true;
+        }
+
+        if (isWatched)
+            continue;
+
+        int watchDescriptor = inotify_add_watch(this->notifyHandle, folder.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+
+        if (watchDescriptor < 0)
+        {
+            std::cout << "Error: Could not watch the level folder " << folder << std::endl;
+            this->Stop();
+            return false;
+        }
+
+        this->watchedFolders.push_back(std::make_pair(watchDescriptor, folder));
+    }
+#endif
+
+    this->isStopping = false;
+    this->watchThread = std::thread(&LevelWatcher::WatchLoop, this);
+
+    return true;
+}
+
+
+// Method to stop and join the watcher thread
+// ------------------------------------------
+void LevelWatcher::Stop()
+{
+    this->isStopping = true;
+
+    if (this->watchThread.joinable())
+        this->watchThread.join();
+
+#ifdef __linux__
+    if (this->notifyHandle >= 0)
+        close(this->notifyHandle);
+#endif
+
+    this->notifyHandle = -1;
+    this->watchedFolders.clear();
+}
+
+
+// Method to return whether the watcher thread is running
+// ------------------------------------------------------
+bool LevelWatcher::IsWatching() const
+{
+    return this->watchThread.joinable();
+}
+
+
+// Method to take the edits queued since the last call
+// NOTE: Only tries the lock, so a step never waits for the watcher thread
+// -----------------------------------------------------------------------
+bool LevelWatcher::TakeEdits(std::vector<LevelEdit>& edits_out)
+{
+    if (!this->hasEdits.load(std::memory_order_acquire))
+        return false;
+
+    std::unique_lock<std::mutex> lock(this->editMutex, std::try_to_lock);
+
+    if (!lock.owns_lock())
+        return false;
+
+    edits_out.clear();
+    edits_out.swap(this->pendingEdits);
+    this->hasEdits.store(false, std::memory_order_release);
+
+    return true;
+}
+
+
+// Method run by the watcher thread
+// --------------------------------
+void LevelWatcher::WatchLoop()
+{
+    // How often the thread checks whether it should stop (and, without inotify, checks the files)
+    const int CHECK_INTERVAL_MS = 250;
+
+    // Quiet time to wait after a change before reading, so a file saved in several writes is read once
+    const int SETTLE_MS = 50;
+
+    std::vector<bool> isChanged(this->levelFiles.size(), false);
+
+#ifdef __linux__
+    alignas(struct inotify_event) char buffer[4096];
+
+    while (!this->isStopping)
+    {
+        pollfd request;
+        request.fd = this->notifyHandle;
+        request.events = POLLIN;
+        request.revents = 0;
+
+        // Wait for a change, then keep reading changes until the folder has been quiet for a moment
+        bool isAnyChanged = false;
+        int timeout = CHECK_INTERVAL_MS;
+
+        while (!this->isStopping && poll(&request, 1, timeout) > 0)
+        {
+            ssize_t length;
+
+            while ((length = read(this->notifyHandle, buffer, sizeof(buffer))) > 0)
+            {
+                for (char* next = buffer; next < buffer + length; )
+                {
+                    const inotify_event* event = reinterpret_cast<const inotify_event*>(next);
+                    next += sizeof(inotify_event) + event->len;
+
+                    if (event->len == 0)
+                        continue;
+
+                    // Match the saved file against the level files in the watched folder
+                    for (unsigned int i = 0; i < this->levelFiles.size(); ++i)
+                    {
+                        std::string folder;
+                        std::string name;
+                        SplitPath(this->levelFiles[i], folder, name);
+
+                        for (const std::pair<int, std::string>& watched : this->watchedFolders)
+                        {
+                            if (watched.first == event->wd && watched.second == folder && name == event->name)
+                            {
+                                isChanged[i] = true;
+                                isAnyChanged = true;
+                            }
+                        }
+                    }
+                }
+            }
+
+            timeout = SETTLE_MS;
+        }
+
+        if (!isAnyChanged)
+            continue;
+
+        for (unsigned int i = 0; i < isChanged.size(); ++i)
+        {
+            if (isChanged[i])
+                this->ReadLevelFile(i);
+
+            isChanged[i] = false;
+        }
+    }
+#else
+    // Without inotify, compare the modification time of every level file with the last one seen
+    std::vector<std::filesystem::file_time_type> writeTimes(this->levelFiles.size());
+
+    for (unsigned int i = 0; i < this->levelFiles.size(); ++i)
+    {
+        std::error_code error;
+        writeTimes[i] = std::filesystem::last_write_time(this->levelFiles[i], error);
+    }
+
+    while (!this->isStopping)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(CHECK_INTERVAL_MS));
+
+        bool isAnyChanged = false;
+
+        for (unsigned int i = 0; i < this->levelFiles.size(); ++i)
+        {
+            std::error_code error;
+            std::filesystem::file_time_type writeTime = std::filesystem::last_write_time(this->levelFiles[i], error);
+
+            if (!error && writeTime != writeTimes[i])
+            {
+                writeTimes[i] = writeTime;
+                isChanged[i] = true;
+                isAnyChanged = true;
+            }
+        }
+
+        if (!isAnyChanged)
+            continue;
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(SETTLE_MS));
+
+        for (unsigned int i = 0; i < isChanged.size(); ++i)
+        {
+            if (isChanged[i])
+                this->ReadLevelFile(i);
+
+            isChanged[i] = false;
+        }
+    }
+#endif
+}
+
+
+// Method to read a changed level file and queue its tile data
+// NOTE: Files which cannot be built (unreadable, empty, or with rows of different lengths) are reported and skipped
+// ----------------------------------------------------------------------------------------------------------------
+void LevelWatcher::ReadLevelFile(unsigned int level_index)
+{
+    const std::string& levelFile = this->levelFiles[level_index];
+
+    LevelEdit edit;
+    edit.levelIndex = level_index;
+
+    if (!GameLevel::ReadTileData(levelFile.c_str(), edit.tileData))
+    {
+        std::cout << "Error: Level file " << levelFile << " could not be read, so it was not reloaded" << std::endl;
+        return;
+    }
+
+    // Ignore blank lines at the end of the file
+    while (!edit.tileData.empty() && edit.tileData.back().empty())
+        edit.tileData.pop_back();
+
+    if (edit.tileData.empty() || edit.tileData[0].empty())
+    {
+        std::cout << "Error: Level file " << levelFile << " has no tiles, so it was not reloaded" << std::endl;
+        return;
+    }
+
+    for (const std::vector<unsigned int>& row : edit.tileData)
+    {
+        if (row.size() != edit.tileData[0].size())
+        {
+            std::cout << "Error: Level file " << levelFile << " has rows of different lengths, so it was not reloaded" << std::endl;
+            return;
+        }
+    }
+
+    // Queue the edit, replacing an older edit of the same level which the game has not taken yet
+    std::lock_guard<std::mutex> lock(this->editMutex);
+
+    for (LevelEdit& pending : this->pendingEdits)
+    {
+        if (pending.levelIndex == level_index)
+        {
+            pending.tileData.swap(edit.tileData);
+            return;
+        }
+    }
+
+    this->pendingEdits.push_back(std::move(edit));
+    this->hasEdits.store(true, std::memory_order_release);
+}
@@ -0,0 +1,101 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//  BREAKOUT REMIX
+//  --------------
+//  by slate2b
+//
+//  The LevelWatcher class watches the level files for edits while the
+//  game runs, so level designers see their changes without restarting.
+//
+//  A watcher thread waits for the files to change (inotify on Linux, a
+//  check of the modification times four times a second elsewhere), then
+//  reads and checks the edited file on that thread, so the game never
+//  waits on file access.  The new tile data is queued as a LevelEdit.
+//
+//  The game takes the queued edits at the start of a step without ever
+//  blocking (if the watcher thread holds the lock, the edits are taken
+//  next step), and patches only the bricks whose tile changed:
+//
+//     LevelWatcher watcher;
+//     watcher.Start(levelPack.GetLevelFiles());
+//     ...
+//     if (watcher.TakeEdits(edits))
+//         ...patch the levels in edits
+//
+//  The LevelWatcher class is responsible for the following:
+//
+//     * Running the watcher thread
+//     * Noticing when a level file was saved
+//     * Reading and checking the new tile data
+//     * Handing the edits to the game without blocking it
+//
+///////////////////////////////////////////////////////////////////////////
+
+#ifndef LEVELWATCHER_H
+#define LEVELWATCHER_H
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Struct to hold the new tile data of an edited level file
+struct LevelEdit
+{
+	unsigned int levelIndex;
+	std::vector<std::vector<unsigned int>> tileData;
+};
+
+
+class LevelWatcher
+{
+
+public:
+
+	// Constructor
+	LevelWatcher();
+
+	// Destructor (stops the watcher thread)
+	~LevelWatcher();
+
+	// Method to start watching level files (level_files[i] is level i), returns false if they cannot be watched
+	bool Start(const std::vector<std::string>& level_files);
+
+	// Method to stop and join the watcher thread
+	void Stop();
+
+	// Method to return whether the watcher thread is running
+	bool IsWatching() const;
+
+	// Method to take the edits queued since the last call (returns false if there were none, or the queue was busy)
+	// NOTE: Never blocks, so it can be called every step
+	bool TakeEdits(std::vector<LevelEdit>& edits_out);
+
+private:
+
+	// Level file paths, by level index
+	std::vector<std::string> levelFiles;
+
+	// Watcher thread and the variables used to communicate with it
+	std::thread watchThread;
+	std::atomic<bool> isStopping;
+
+	// inotify handle and the folder each watch descriptor watches (Linux only, the handle is -1 elsewhere)
+	int notifyHandle;
+	std::vector<std::pair<int, std::string>> watchedFolders;
+
+	// Edits read by the watcher thread, waiting for the game (at most one per level)
+	std::mutex editMutex;
+	std::vector<LevelEdit> pendingEdits;
+	std::atomic<bool> hasEdits;
+
+	// Method run by the watcher thread
+	void WatchLoop();
+
+	// Method to read a changed level file and queue its tile data
+	void ReadLevelFile(unsigned int level_index);
+};
+
+#endif
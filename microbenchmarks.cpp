@@ -0,0 +1,639 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//  BREAKOUT REMIX
+//  --------------
+//  by slate2b
+//
+//  Microbenchmarks for the simulation hot paths.
+//
+//  This headless program times the collision helpers, ball movement,
+//  collision processing, state hashing, snapshots, netplay rollbacks,
+//  level loading, the training environments and the paddle controller.
+//  Run with --benchmark_out=results.json to save the results for
+//  comparing against another commit (see benchmark.h for all the
+//  options).
+//
+///////////////////////////////////////////////////////////////////////////
+
+#include "benchmark.h"
+#include "breakout_env.h"
+#include "frame_encoder.h"
+#include "game.h"
+#include "game_snapshot.h"
+#include "level_generator.h"
+#include "paddle_controller.h"
+#include "rollback_session.h"
+
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Constants for the simulated screen (matches Source.cpp)
+const unsigned int SCREEN_WIDTH = 800;
+const unsigned int SCREEN_HEIGHT = 600;
+
+// Fixed time step used for simulated frames (60 frames per second)
+const float FRAME_DT = 1.0f / 60.0f;
+
+
+// Method to return the shared headless game used by the game benchmarks
+// NOTE: Created once, so the level pack is only loaded once
+// ---------------------------------------------------------------------
+Game& BenchmarkGame()
+{
+    static Game* game = nullptr;
+
+    if (game == nullptr)
+    {
+        game = new Game(SCREEN_WIDTH, SCREEN_HEIGHT);
+        game->InitSimulation();
+    }
+
+    return *game;
+}
+
+
+// Method to add a ball object in play, with the same size as the game's ball objects, to a balls archetype
+// -------------------------------------------------------------------------------------------------------
+BallObject MakeBall(BallArchetype& balls, glm::vec2 position, glm::vec2 velocity)
+{
+    BallObject ball_object = balls.Add();
+    ball_object.InitBall(SCREEN_WIDTH, SCREEN_HEIGHT, BenchmarkGame().player);
+    ball_object.Position = position;
+    ball_object.Velocity = velocity;
+    ball_object.isInPlay = true;
+    ball_object.isHeld = false;
+    ball_object.isDestroyed = false;
+    return ball_object;
+}
+
+
+/////////////////////////
+//
+// Collision helpers
+//
+/////////////////////////
+
+// Ball against a brick it overlaps (arg 1) or misses (arg 0)
+void BM_DetectCircleCollision(BenchmarkState& state)
+{
+    BrickArchetype bricks;
+    BrickObject brick_object = BrickObject::Create(bricks, glm::vec2(100.0f, 100.0f), glm::vec2(53.0f, 20.0f), glm::vec3(1.0f), false);
+    glm::vec2 ballPosition = state.Range(0) ? glm::vec2(120.0f, 112.0f) : glm::vec2(400.0f, 400.0f);
+    BallArchetype balls;
+    BallObject ball_object = MakeBall(balls, ballPosition, glm::vec2(100.0f, -350.0f));
+
+    for (unsigned long long i = 0; i < state.iterations; ++i)
+    {
+        DoNotOptimize(ball_object.Position);
+        Collision collision = DetectCircleCollision(ball_object.Position, balls.Get<CircleCollider>(0), brick_object.Collider);
+        DoNotOptimize(collision);
+    }
+
+    state.SetItemsProcessed(state.iterations);
+}
+BREAKOUT_BENCHMARK(BM_DetectCircleCollision)->Arg(0)->Arg(1);
+
+// Impact vectors pointing in each of the four compass directions
+void BM_VectorDirection(BenchmarkState& state)
+{
+    glm::vec2 impactPoints[] = {
+        glm::vec2(0.3f, 5.0f),
+        glm::vec2(6.0f, -1.0f),
+        glm::vec2(-0.5f, -4.0f),
+        glm::vec2(-7.0f, 2.0f)
+    };
+
+    for (unsigned long long i = 0; i < state.iterations; ++i)
+    {
+        glm::vec2 impactPoint = impactPoints[i & 3];
+        DoNotOptimize(impactPoint);
+        Direction direction = VectorDirection(impactPoint);
+        DoNotOptimize(direction);
+    }
+
+    state.SetItemsProcessed(state.iterations);
+}
+BREAKOUT_BENCHMARK(BM_VectorDirection);
+
+
+/////////////////////////
+//
+// Ball movement
+//
+/////////////////////////
+
+// A single ball bouncing around the window
+void BM_MoveBall(BenchmarkState& state)
+{
+    BallArchetype balls;
+    BallObject ball_object = MakeBall(balls, glm::vec2(400.0f, 300.0f), glm::vec2(100.0f, -350.0f));
+
+    for (unsigned long long i = 0; i < state.iterations; ++i)
+    {
+        glm::vec2 position = ball_object.MoveBall(FRAME_DT, SCREEN_WIDTH);
+        DoNotOptimize(position);
+
+        // Bounce off the bottom of the window so the ball stays in play
+        if (ball_object.Position.y >= SCREEN_HEIGHT)
+            ball_object.Velocity.y = -ball_object.Velocity.y;
+    }
+
+    state.SetItemsProcessed(state.iterations);
+}
+BREAKOUT_BENCHMARK(BM_MoveBall);
+
+
+/////////////////////////
+//
+// Collision processing
+//
+/////////////////////////
+
+// Method to time ProcessCollisions with arg 0 bricks and arg 1 balls, using the given number of collision threads
+// NOTE: The balls sit below the bricks and above the paddle, so every frame tests every
+//       ball against every brick without changing the game state (the common case).  Balls
+//       which start out overlapping are pushed apart by the first few frames.
+// --------------------------------------------------------------------------------------------------------------
+void TimeProcessCollisions(BenchmarkState& state, unsigned int num_threads)
+{
+    state.PauseTiming();
+
+    Game& game = BenchmarkGame();
+    game.SetCollisionThreads(num_threads);
+
+    // Build a fully packed level with the requested number of bricks
+    LevelGenerator generator(1);
+    generator.density = 1.0f;
+    generator.SetGridForTileCount(static_cast<unsigned int>(state.Range(0)));
+    generator.BuildLevel(game.activeLevel, SCREEN_WIDTH, SCREEN_HEIGHT / 3);
+
+    // Spread the balls across the open space between the bricks and the paddle
+    unsigned int numBalls = static_cast<unsigned int>(state.Range(1));
+    game.ballObjects.Clear();
+
+    for (unsigned int i = 0; i < numBalls; ++i)
+    {
+        float x = (i * 37 % 750) + 10.0f;
+        float y = SCREEN_HEIGHT * 0.45f + (i * 53 % 200);
+        MakeBall(game.ballObjects, glm::vec2(x, y), glm::vec2(100.0f, -350.0f));
+    }
+
+    state.ResumeTiming();
+
+    for (unsigned long long i = 0; i < state.iterations; ++i)
+    {
+        game.ProcessCollisions();
+    }
+
+    DoNotOptimize(game.ballObjects[0].Velocity);
+    state.SetItemsProcessed(state.iterations * game.activeLevel.bricks.Size() * numBalls);
+
+    state.PauseTiming();
+    game.SetCollisionThreads(1);
+}
+
+// ProcessCollisions with arg 0 bricks and arg 1 balls
+void BM_ProcessCollisions(BenchmarkState& state)
+{
+    TimeProcessCollisions(state, 1);
+}
+BREAKOUT_BENCHMARK(BM_ProcessCollisions)->ArgsProduct({ 150, 1500, 15000, 150000 }, { 1, 5, 50, 500 });
+
+// ProcessCollisions with arg 0 bricks, arg 1 balls and arg 2 collision threads
+// NOTE: The results are the same for any number of threads, only the time changes
+void BM_ProcessCollisionsThreaded(BenchmarkState& state)
+{
+    TimeProcessCollisions(state, static_cast<unsigned int>(state.Range(2)));
+}
+BREAKOUT_BENCHMARK(BM_ProcessCollisionsThreaded)->ArgsProduct({ 1500, 15000 }, { 500, 5000 }, { 1, 2, 4, 8 });
+
+
+// Ball movement and ball against ball collisions for arg 0 balls spread across the window (no bricks)
+// NOTE: Each iteration is a whole frame, so the sweep and prune order is kept (and only nearly sorted) between iterations
+void BM_BallCollisions(BenchmarkState& state)
+{
+    state.PauseTiming();
+
+    Game& game = BenchmarkGame();
+
+    // Spread the balls across the window, moving in different directions
+    unsigned int numBalls = static_cast<unsigned int>(state.Range(0));
+    game.ballObjects.Clear();
+
+    for (unsigned int i = 0; i < numBalls; ++i)
+    {
+        float x = (i * 37 % 770) + 5.0f;
+        float y = (i * 53 % 570) + 5.0f;
+        glm::vec2 velocity(static_cast<float>(i * 71 % 400) - 200.0f, static_cast<float>(i * 29 % 400) - 200.0f);
+        MakeBall(game.ballObjects, glm::vec2(x, y), velocity);
+    }
+
+    state.ResumeTiming();
+
+    for (unsigned long long i = 0; i < state.iterations; ++i)
+    {
+        for (BallObject ball_object : game.ballObjects)
+        {
+            ball_object.MoveBall(FRAME_DT, SCREEN_WIDTH);
+
+            // Bounce off the bottom of the window so the balls stay in play
+            if (ball_object.Position.y >= SCREEN_HEIGHT - ball_object.Size.y)
+                ball_object.Velocity.y = -std::abs(ball_object.Velocity.y);
+        }
+
+        game.ProcessBallCollisions();
+    }
+
+    DoNotOptimize(game.ballObjects[0].Velocity);
+    state.SetItemsProcessed(state.iterations * numBalls);
+}
+BREAKOUT_BENCHMARK(BM_BallCollisions)->Arg(100)->Arg(1000)->Arg(5000)->Arg(10000);
+
+
+/////////////////////////
+//
+// State hashing
+//
+/////////////////////////
+
+// Game::ComputeStateHash (the hash taken after every step) for a level with arg 0 bricks and the game's 5 balls
+void BM_ComputeStateHash(BenchmarkState& state)
+{
+    state.PauseTiming();
+
+    Game& game = BenchmarkGame();
+
+    LevelGenerator generator(1);
+    generator.SetGridForTileCount(static_cast<unsigned int>(state.Range(0)));
+    generator.BuildLevel(game.activeLevel, SCREEN_WIDTH, SCREEN_HEIGHT / 3);
+    game.RefillBalls();
+
+    state.ResumeTiming();
+
+    for (unsigned long long i = 0; i < state.iterations; ++i)
+    {
+        uint64_t hash = game.ComputeStateHash();
+        DoNotOptimize(hash);
+    }
+
+    state.SetItemsProcessed(state.iterations);
+}
+BREAKOUT_BENCHMARK(BM_ComputeStateHash)->Arg(150)->Arg(15000);
+
+
+/////////////////////////
+//
+// Snapshots
+//
+/////////////////////////
+
+// Method to set up the benchmark game with a level of arg 0 bricks and the game's 5 balls, and save a snapshot of it
+// ------------------------------------------------------------------------------------------------------------------
+void PrepareSnapshot(BenchmarkState& state, GameSnapshot& snapshot)
+{
+    Game& game = BenchmarkGame();
+
+    LevelGenerator generator(1);
+    generator.SetGridForTileCount(static_cast<unsigned int>(state.Range(0)));
+    generator.BuildLevel(game.activeLevel, SCREEN_WIDTH, SCREEN_HEIGHT / 3);
+    game.RefillBalls();
+
+    snapshot.Reserve(game.ballObjects.Size(), game.activeLevel.bricks.Size());
+    snapshot.Save(game);
+}
+
+// GameSnapshot::Save for a level with arg 0 bricks and the game's 5 balls
+void BM_SnapshotSave(BenchmarkState& state)
+{
+    state.PauseTiming();
+
+    GameSnapshot snapshot;
+    PrepareSnapshot(state, snapshot);
+    Game& game = BenchmarkGame();
+
+    state.ResumeTiming();
+
+    for (unsigned long long i = 0; i < state.iterations; ++i)
+    {
+        snapshot.Save(game);
+        DoNotOptimize(snapshot);
+    }
+
+    state.SetItemsProcessed(state.iterations);
+}
+BREAKOUT_BENCHMARK(BM_SnapshotSave)->Arg(150)->Arg(15000);
+
+// GameSnapshot::Restore for a level with arg 0 bricks and the game's 5 balls
+void BM_SnapshotRestore(BenchmarkState& state)
+{
+    state.PauseTiming();
+
+    GameSnapshot snapshot;
+    PrepareSnapshot(state, snapshot);
+    Game& game = BenchmarkGame();
+
+    state.ResumeTiming();
+
+    for (unsigned long long i = 0; i < state.iterations; ++i)
+    {
+        snapshot.Restore(game);
+        DoNotOptimize(game.ballObjects[0].Position);
+    }
+
+    state.SetItemsProcessed(state.iterations);
+}
+BREAKOUT_BENCHMARK(BM_SnapshotRestore)->Arg(150)->Arg(15000);
+
+// Netplay rollback of RollbackSession::MAX_ROLLBACK_FRAMES frames (restore, then save and step each frame) for a level with arg 0 bricks and 5 moving balls
+// NOTE: Must fit well within the 16.7 ms frame budget
+void BM_Rollback(BenchmarkState& state)
+{
+    const unsigned int NUM_FRAMES = RollbackSession::MAX_ROLLBACK_FRAMES;
+
+    state.PauseTiming();
+
+    GameSnapshot snapshots[NUM_FRAMES];
+    PrepareSnapshot(state, snapshots[0]);
+    Game& game = BenchmarkGame();
+
+    // Launch every ball from below the bricks, so the frames collide
+    unsigned int ballIndex = 0;
+
+    for (BallObject ball_object : game.ballObjects)
+    {
+        ball_object.Position = glm::vec2(100.0f + 120.0f * ballIndex, SCREEN_HEIGHT * 0.6f);
+        ball_object.Velocity = glm::vec2((ballIndex % 2 == 0) ? -100.0f : 100.0f, -350.0f);
+        ball_object.isInPlay = true;
+        ball_object.isHeld = false;
+        ballIndex += 1;
+    }
+
+    for (GameSnapshot& snapshot : snapshots)
+    {
+        snapshot.Reserve(game.ballObjects.Size(), game.activeLevel.bricks.Size());
+    }
+
+    snapshots[0].Save(game);
+
+    state.ResumeTiming();
+
+    for (unsigned long long i = 0; i < state.iterations; ++i)
+    {
+        snapshots[0].Restore(game);
+
+        for (unsigned int frame = 0; frame < NUM_FRAMES; ++frame)
+        {
+            if (frame > 0)
+                snapshots[frame].Save(game);
+
+            RollbackSession::StepFrame(game, NET_INPUT_LEFT, 0);
+        }
+
+        DoNotOptimize(game.ballObjects[0].Position);
+    }
+
+    state.SetItemsProcessed(state.iterations * NUM_FRAMES);
+}
+BREAKOUT_BENCHMARK(BM_Rollback)->Arg(150)->Arg(15000);
+
+
+/////////////////////////
+//
+// Level loading
+//
+/////////////////////////
+
+// GameLevel::Load (file parsing and InitLevel) for a generated level with arg 0 tiles
+void BM_GameLevelLoad(BenchmarkState& state)
+{
+    state.PauseTiming();
+
+    // Write a generated level to a temporary file
+    std::string levelFile = "benchmark_" + std::to_string(state.Range(0)) + ".lvl";
+    LevelGenerator generator(1);
+    generator.SetGridForTileCount(static_cast<unsigned int>(state.Range(0)));
+    generator.WriteLevelFile(levelFile.c_str());
+
+    GameLevel level;
+    state.ResumeTiming();
+
+    for (unsigned long long i = 0; i < state.iterations; ++i)
+    {
+        level.Load(levelFile.c_str(), SCREEN_WIDTH, SCREEN_HEIGHT / 3);
+        DoNotOptimize(level.bricks.Column<Transform>().data());
+    }
+
+    state.PauseTiming();
+    std::remove(levelFile.c_str());
+    state.SetItemsProcessed(state.iterations * state.Range(0));
+}
+BREAKOUT_BENCHMARK(BM_GameLevelLoad)->Arg(150)->Arg(10000)->Arg(1000000);
+
+// InitLevel (through LoadTileData) for generated tile data with arg 0 tiles
+void BM_InitLevel(BenchmarkState& state)
+{
+    state.PauseTiming();
+
+    LevelGenerator generator(1);
+    generator.SetGridForTileCount(static_cast<unsigned int>(state.Range(0)));
+    std::vector<std::vector<unsigned int>> tileData = generator.GenerateTileData();
+
+    GameLevel level;
+    state.ResumeTiming();
+
+    for (unsigned long long i = 0; i < state.iterations; ++i)
+    {
+        level.LoadTileData(tileData, SCREEN_WIDTH, SCREEN_HEIGHT / 3);
+        DoNotOptimize(level.bricks.Column<Transform>().data());
+    }
+
+    state.SetItemsProcessed(state.iterations * state.Range(0));
+}
+BREAKOUT_BENCHMARK(BM_InitLevel)->Arg(150)->Arg(10000)->Arg(1000000);
+
+// GameLevel::PatchTiles for a level with arg 0 tiles, switching 16 tiles back and forth (the hot reload of an edited level file)
+void BM_PatchTiles(BenchmarkState& state)
+{
+    state.PauseTiming();
+
+    LevelGenerator generator(1);
+    generator.SetGridForTileCount(static_cast<unsigned int>(state.Range(0)));
+    std::vector<std::vector<unsigned int>> tileData = generator.GenerateTileData();
+
+    GameLevel level;
+    level.LoadTileData(tileData, SCREEN_WIDTH, SCREEN_HEIGHT / 3);
+
+    // The edited grid: 16 tiles spread over the level change type
+    std::vector<std::vector<unsigned int>> editedData = tileData;
+    unsigned int numRows = static_cast<unsigned int>(editedData.size());
+
+    for (unsigned int i = 0; i < 16; ++i)
+    {
+        std::vector<unsigned int>& row = editedData[(i * 7) % numRows];
+        unsigned int& tile = row[(i * 13) % row.size()];
+        tile = (tile == 0) ? 3 : 0;
+    }
+
+    unsigned int changedBricks = 0;
+    state.ResumeTiming();
+
+    for (unsigned long long i = 0; i < state.iterations; ++i)
+    {
+        level.PatchTiles((i % 2 == 0) ? editedData : tileData, changedBricks);
+        DoNotOptimize(changedBricks);
+    }
+
+    state.SetItemsProcessed(state.iterations * state.Range(0));
+}
+BREAKOUT_BENCHMARK(BM_PatchTiles)->Arg(150)->Arg(10000)->Arg(1000000);
+
+
+/////////////////////////
+//
+// Training environments
+//
+/////////////////////////
+
+// breakout_env_step for a batch of arg 0 environments, stepped by one thread per core (items are environment steps)
+void BM_EnvStep(BenchmarkState& state)
+{
+    state.PauseTiming();
+
+    unsigned int numEnvs = static_cast<unsigned int>(state.Range(0));
+    BreakoutEnv* env = breakout_env_create(numEnvs, 0, 10000);
+
+    std::vector<float> observations(static_cast<size_t>(numEnvs) * BREAKOUT_ENV_OBSERVATION_SIZE);
+    std::vector<float> rewards(numEnvs);
+    std::vector<unsigned char> dones(numEnvs);
+    std::vector<int> actions(numEnvs);
+
+    // Give each environment a different action, and keep firing so balls stay in play
+    for (unsigned int i = 0; i < numEnvs; ++i)
+    {
+        actions[i] = BREAKOUT_ACTION_FIRE + (i % 3);
+    }
+
+    breakout_env_reset(env, 1, observations.data());
+
+    state.ResumeTiming();
+
+    for (unsigned long long i = 0; i < state.iterations; ++i)
+    {
+        breakout_env_step(env, actions.data(), observations.data(), rewards.data(), dones.data());
+        DoNotOptimize(observations.data());
+    }
+
+    state.PauseTiming();
+    breakout_env_destroy(env);
+    state.ResumeTiming();
+
+    state.SetItemsProcessed(state.iterations * numEnvs);
+}
+BREAKOUT_BENCHMARK(BM_EnvStep)->Arg(64)->Arg(1024);
+
+// FrameEncoder::Encode of an 84x84 picture with arg 0 channels (1 = grayscale, 3 = RGB) for a level with 150 bricks
+void BM_EncodeFrame(BenchmarkState& state)
+{
+    state.PauseTiming();
+
+    Game& game = BenchmarkGame();
+
+    LevelGenerator generator(1);
+    generator.SetGridForTileCount(150);
+    generator.BuildLevel(game.activeLevel, SCREEN_WIDTH, SCREEN_HEIGHT / 3);
+    game.RefillBalls();
+
+    FrameEncoder encoder;
+    encoder.SetFormat(84, 84, static_cast<unsigned int>(state.Range(0)));
+    std::vector<unsigned char> pixels(encoder.GetFrameBytes());
+
+    state.ResumeTiming();
+
+    for (unsigned long long i = 0; i < state.iterations; ++i)
+    {
+        encoder.Encode(game, pixels.data());
+        DoNotOptimize(pixels.data());
+    }
+
+    state.SetItemsProcessed(state.iterations);
+}
+BREAKOUT_BENCHMARK(BM_EncodeFrame)->Arg(1)->Arg(3);
+
+// breakout_env_render of 84x84 grayscale pictures for a batch of arg 0 environments (items are pictures)
+void BM_EnvRender(BenchmarkState& state)
+{
+    state.PauseTiming();
+
+    unsigned int numEnvs = static_cast<unsigned int>(state.Range(0));
+    BreakoutEnv* env = breakout_env_create(numEnvs, 0, 10000);
+
+    std::vector<float> observations(static_cast<size_t>(numEnvs) * BREAKOUT_ENV_OBSERVATION_SIZE);
+    std::vector<unsigned char> pixels(static_cast<size_t>(numEnvs) * 84 * 84);
+    breakout_env_reset(env, 1, observations.data());
+
+    state.ResumeTiming();
+
+    for (unsigned long long i = 0; i < state.iterations; ++i)
+    {
+        breakout_env_render(env, 84, 84, 1, pixels.data());
+        DoNotOptimize(pixels.data());
+    }
+
+    state.PauseTiming();
+    breakout_env_destroy(env);
+    state.ResumeTiming();
+
+    state.SetItemsProcessed(state.iterations * numEnvs);
+}
+BREAKOUT_BENCHMARK(BM_EnvRender)->Arg(64);
+
+
+/////////////////////////
+//
+// Paddle controller
+//
+/////////////////////////
+
+// PaddleController predicting arg 0 balls spread across the window and choosing the paddle target (items are balls)
+void BM_PaddleController(BenchmarkState& state)
+{
+    state.PauseTiming();
+
+    Game& game = BenchmarkGame();
+
+    // Spread the balls across the window, moving in different directions
+    unsigned int numBalls = static_cast<unsigned int>(state.Range(0));
+    BallArchetype balls;
+
+    for (unsigned int i = 0; i < numBalls; ++i)
+    {
+        float x = (i * 37 % 770) + 5.0f;
+        float y = (i * 53 % 400) + 5.0f;
+        glm::vec2 velocity(static_cast<float>(i * 71 % 800) - 400.0f, static_cast<float>(i * 29 % 600) - 300.0f);
+        MakeBall(balls, glm::vec2(x, y), velocity);
+    }
+
+    PaddleController controller;
+    float paddleCenter = game.player.Position.x + game.player.Size.x / 2.0f;
+    float target = 0.0f;
+
+    state.ResumeTiming();
+
+    for (unsigned long long i = 0; i < state.iterations; ++i)
+    {
+        controller.PredictBalls(balls, game.player.Position.y, static_cast<float>(SCREEN_WIDTH), FRAME_DT);
+        controller.ChooseTarget(paddleCenter, game.player.Size.x, static_cast<float>(SCREEN_WIDTH), FRAME_DT, target);
+        DoNotOptimize(target);
+    }
+
+    state.SetItemsProcessed(state.iterations * numBalls);
+}
+BREAKOUT_BENCHMARK(BM_PaddleController)->Arg(1000)->Arg(10000);
+
+
+int main(int argc, char* argv[])
+{
+    return RunBenchmarks(argc, argv);
+}
@@ -0,0 +1,204 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//  BREAKOUT REMIX
+//  --------------
+//  by slate2b
+//
+//  Headless netplay test.
+//
+//  This program runs two peers of a co-op game in one process, each with
+//  its own Game and RollbackSession, talking over loopback UDP sockets.
+//  The peers step on a shared virtual clock (one frame every 1/60 s), so
+//  a run takes far less than real time and the simulated latency, jitter
+//  and packet loss come out the same on every run.
+//
+//  Each player's input is a pseudo-random function of the frame number
+//  (holding left, right or nothing for a while, and sometimes Space), so
+//  the remote input changes often and the peers roll back a lot.
+//
+//  When both peers have confirmed every frame, their state hashes are
+//  compared with a reference run which steps one Game with both players'
+//  inputs and no network.  The program exits with -1 if they differ.
+//
+//  Options:
+//
+//     --frames N          Number of frames to play (default 3600, 1 minute at 60 FPS)
+//     --latency MS        One way latency added to every packet (default 50)
+//     --jitter MS         Random extra latency of up to +/- MS (default 10)
+//     --loss F            Fraction of the packets dropped (default 0.02)
+//     --seed N            Seed for the simulated network (default 1)
+//     --port N            Port of the first peer (the second peer uses N + 1, default 7000)
+//     --fixed-point       Use the deterministic (fixed point) physics
+//
+///////////////////////////////////////////////////////////////////////////
+
+#include "game.h"
+#include "rollback_session.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+// Constants for the simulated screen (matches Source.cpp)
+const unsigned int SCREEN_WIDTH = 800;
+const unsigned int SCREEN_HEIGHT = 600;
+
+
+// Method to return a player's input for a frame (changes every quarter of a second or so)
+// ---------------------------------------------------------------------------------------
+unsigned char PlayerInput(unsigned int player_index, unsigned int frame)
+{
+    // Hash the player and the quarter second (each player switches at a different frame)
+    uint32_t hash = ((frame + 7 * player_index) / 15) * 2654435761u ^ (player_index * 0x9e3779b9u);
+    hash ^= hash >> 15;
+    hash *= 0x85ebca6bu;
+    hash ^= hash >> 13;
+
+    unsigned char input = 0;
+
+    // Hold left, right or nothing
+    switch (hash % 3)
+    {
+    case 0: input |= NET_INPUT_LEFT; break;
+    case 1: input |= NET_INPUT_RIGHT; break;
+    default: break;
+    }
+
+    // Sometimes press Space to release a ball
+    if ((hash >> 8) % 4 == 0)
+        input |= NET_INPUT_SPACE;
+
+    return input;
+}
+
+
+int main(int argc, char* argv[])
+{
+    // Netplay settings
+    unsigned int numFrames = 3600;
+    double latency = 0.050;
+    double jitter = 0.010;
+    double loss = 0.02;
+    unsigned int seed = 1;
+    unsigned int port = 7000;
+    bool isFixedPoint = false;
+
+    // Read the command line options
+    for (int i = 1; i < argc; ++i)
+    {
+        bool hasValue = (i + 1 < argc);
+
+        if (std::strcmp(argv[i], "--frames") == 0 && hasValue)
+            numFrames = std::strtoul(argv[++i], nullptr, 10);
+        else if (std::strcmp(argv[i], "--latency") == 0 && hasValue)
+            latency = std::strtod(argv[++i], nullptr) / 1000.0;
+        else if (std::strcmp(argv[i], "--jitter") == 0 && hasValue)
+            jitter = std::strtod(argv[++i], nullptr) / 1000.0;
+        else if (std::strcmp(argv[i], "--loss") == 0 && hasValue)
+            loss = std::strtod(argv[++i], nullptr);
+        else if (std::strcmp(argv[i], "--seed") == 0 && hasValue)
+            seed = std::strtoul(argv[++i], nullptr, 10);
+        else if (std::strcmp(argv[i], "--port") == 0 && hasValue)
+            port = std::strtoul(argv[++i], nullptr, 10);
+        else if (std::strcmp(argv[i], "--fixed-point") == 0)
+            isFixedPoint = true;
+        else
+        {
+            std::cout << "Error: Unknown option " << argv[i] << std::endl;
+            return -1;
+        }
+    }
+
+    if (port == 0 || port > 65534)
+    {
+        std::cout << "Error: --port must be between 1 and 65534" << std::endl;
+        return -1;
+    }
+
+    // Create both peers' games and the reference game, all from the same start
+    Game firstGame(SCREEN_WIDTH, SCREEN_HEIGHT);
+    Game secondGame(SCREEN_WIDTH, SCREEN_HEIGHT);
+    Game reference(SCREEN_WIDTH, SCREEN_HEIGHT);
+    Game* games[2] = { &firstGame, &secondGame };
+
+    for (Game* game : games)
+    {
+        game->InitSimulation();
+        game->SetFixedPoint(isFixedPoint);
+    }
+
+    reference.InitSimulation();
+    reference.SetFixedPoint(isFixedPoint);
+
+    // Connect the peers (each one's network settings delay the packets it sends)
+    RollbackSession sessions[2];
+    unsigned short ports[2] = { static_cast<unsigned short>(port), static_cast<unsigned short>(port + 1) };
+
+    for (unsigned int peer = 0; peer < 2; ++peer)
+    {
+        if (!sessions[peer].Start(*games[peer], ports[peer], ports[1 - peer]))
+            return -1;
+
+        sessions[peer].SetSimulatedNetwork(latency, jitter, loss, seed + peer);
+    }
+
+    // Play until both peers have simulated every frame, then until every frame is confirmed (stop if a peer gets stuck)
+    const unsigned int MAX_TICKS = numFrames * 4 + 600;
+    unsigned int tick = 0;
+
+    for (; tick < MAX_TICKS; ++tick)
+    {
+        double now = tick / 60.0;
+        bool isFinished = true;
+
+        for (unsigned int peer = 0; peer < 2; ++peer)
+        {
+            RollbackSession& session = sessions[peer];
+
+            if (session.GetFrame() < numFrames)
+                session.AdvanceFrame(*games[peer], PlayerInput(peer, session.GetFrame()), now);
+            else
+                session.Poll(*games[peer], now);
+
+            if (session.GetConfirmedFrame() < numFrames)
+                isFinished = false;
+        }
+
+        if (isFinished)
+            break;
+    }
+
+    // Run the reference game with both players' inputs and no network
+    for (unsigned int frame = 0; frame < numFrames; ++frame)
+    {
+        RollbackSession::StepFrame(reference, PlayerInput(0, frame), PlayerInput(1, frame));
+    }
+
+    // Report each peer
+    uint64_t referenceHash = reference.ComputeStateHash();
+    bool isMatching = true;
+
+    for (unsigned int peer = 0; peer < 2; ++peer)
+    {
+        uint64_t hash = games[peer]->ComputeStateHash();
+        isMatching = isMatching && (hash == referenceHash) && (sessions[peer].GetConfirmedFrame() == numFrames);
+
+        std::cout << "Peer " << (peer + 1) << " (port " << ports[peer] << ")" << std::endl;
+        sessions[peer].PrintReport();
+        std::cout << "State hash: " << std::hex << hash << std::dec << std::endl;
+        std::cout << std::endl;
+    }
+
+    std::cout << "Reference hash: " << std::hex << referenceHash << std::dec << std::endl;
+    std::cout << "Ticks: " << tick << " for " << numFrames << " frames" << std::endl;
+
+    if (!isMatching)
+    {
+        std::cout << "Error: The peers did not end up in the reference state" << std::endl;
+        return -1;
+    }
+
+    std::cout << "Both peers match the reference" << std::endl;
+
+    return 0;
+}
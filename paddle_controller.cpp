@@ -0,0 +1,241 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//  BREAKOUT REMIX
+//  --------------
+//  by slate2b
+//
+//  The PaddleController class is a bot which plays the game (for soak
+//  tests and attract mode).
+//
+//  The PaddleController class is responsible for the following:
+//
+//     * Predicting where and when each ball reaches the paddle row
+//     * Choosing the paddle position which saves the most balls
+//     * Pressing the keys which move the paddle there and launch balls
+//
+///////////////////////////////////////////////////////////////////////////
+
+#include "paddle_controller.h"
+
+#include <algorithm>
+#include <cmath>
+
+// Distance the paddle moves per second while A or D is held (matches Game::MovePlayer)
+const float PADDLE_SPEED = 500.0f;
+
+
+// Method to return a position after a number of steps of step length between walls at 0 and limit
+// NOTE: Follows MoveBall, which puts a ball which crossed a wall back against the wall and turns it around
+// -------------------------------------------------------------------------------------------------------
+static double PositionAfterSteps(double position, double step, double limit, double steps)
+{
+    if (step == 0.0 || limit <= 0.0)
+        return position;
+
+    double distance = std::fabs(step);
+
+    // Steps until the ball reaches the wall it is heading for (at least one, as MoveBall moves before checking)
+    double toWall = (step > 0.0) ? std::ceil((limit - position) / distance) : std::ceil(position / distance);
+    toWall = std::max(toWall, 1.0);
+
+    if (steps < toWall)
+        return position + step * steps;
+
+    // From then on, every crossing from one wall to the other takes the same number of steps
+    double crossingSteps = std::max(std::ceil(limit / distance), 1.0);
+    double remaining = steps - toWall;
+    double crossings = std::floor(remaining / crossingSteps);
+    double extra = remaining - crossings * crossingSteps;
+
+    // After an even number of crossings the ball is moving away from the first wall it hit
+    bool isFromFirstWall = (std::fmod(crossings, 2.0) == 0.0);
+    bool isFromRightWall = ((step > 0.0) == isFromFirstWall);
+
+    return isFromRightWall ? limit - distance * extra : distance * extra;
+}
+
+
+PaddleController::PaddleController()
+{
+    this->targetX = -1.0f;
+}
+
+
+// Method to predict the balls and press the keys for the next step of the game
+// ----------------------------------------------------------------------------
+void PaddleController::Update(Game& game, float dt)
+{
+    float paddleWidth = game.player.Size.x;
+    float paddleCenter = game.player.Position.x + paddleWidth / 2.0f;
+
+    this->PredictBalls(game.ballObjects, game.player.Position.y, static_cast<float>(game.windowWidth), dt);
+
+    float target = -1.0f;
+
+    if (!this->ChooseTarget(paddleCenter, paddleWidth, static_cast<float>(game.windowWidth), dt, target) && !this->predictions.empty())
+    {
+        // No ball can be saved any more, so follow the ball which arrives first
+        const BallPrediction* first = &this->predictions[0];
+
+        for (const BallPrediction& prediction : this->predictions)
+        {
+            if (prediction.steps < first->steps)
+                first = &prediction;
+        }
+
+        target = first->landingX;
+    }
+
+    this->targetX = target;
+
+    // Only move if the target is more than half a step of the paddle away (so the paddle does not jitter around it)
+    float deadZone = 0.5f * PADDLE_SPEED * dt;
+
+    game.keys[KEY_A] = (target >= 0.0f && target < paddleCenter - deadZone);
+    game.keys[KEY_D] = (target >= 0.0f && target > paddleCenter + deadZone);
+
+    // Press Space whenever the game takes it (places a ball on the paddle, then releases it)
+    game.keys[KEY_SPACE] = (game.ballInPlayTimer >= 240);
+}
+
+
+// Method to predict every moving ball of balls which will reach paddle_top
+// ------------------------------------------------------------------------
+unsigned int PaddleController::PredictBalls(const BallArchetype& balls, float paddle_top, float window_width, float dt)
+{
+    this->predictions.clear();
+
+    // Read the packed columns directly (no BallObject views needed)
+    const std::vector<Transform>& transforms = balls.Column<Transform>();
+    const std::vector<Velocity>& velocities = balls.Column<Velocity>();
+    const std::vector<BallState>& ballStates = balls.Column<BallState>();
+
+    for (unsigned int i = 0; i < balls.Size(); ++i)
+    {
+        if (!ballStates[i].isInPlay || ballStates[i].isHeld || ballStates[i].isDestroyed)
+            continue;
+
+        BallPrediction prediction;
+
+        if (PredictBall(transforms[i].position, transforms[i].size, velocities[i].velocity, paddle_top, window_width, dt, prediction))
+            this->predictions.push_back(prediction);
+    }
+
+    return static_cast<unsigned int>(this->predictions.size());
+}
+
+
+// Method to choose the paddle centre which saves the most predicted balls
+// NOTE: Each ball adds its weight to every pixel column (paddle centre) which would save it in time, then the
+//       best column closest to the paddle wins.  Sooner balls weigh slightly more, but never as much as another ball.
+// -----------------------------------------------------------------------------------------------------------------
+bool PaddleController::ChooseTarget(float paddle_center, float paddle_width, float window_width, float dt, float& target_out)
+{
+    int numColumns = static_cast<int>(window_width);
+
+    if (numColumns <= 0 || this->predictions.empty())
+        return false;
+
+    // Coverage is built as differences (add at the first column, subtract after the last), then summed once
+    this->coverage.assign(numColumns + 1, 0.0);
+
+    float halfWidth = paddle_width / 2.0f;
+    double soonerScale = 0.5 / this->predictions.size();
+    bool isAnySaved = false;
+
+    for (const BallPrediction& prediction : this->predictions)
+    {
+        // Paddle centres which put the ball within the paddle, and which the paddle can reach before the ball arrives
+        float reach = PADDLE_SPEED * dt * prediction.steps;
+        float low = std::max(std::max(prediction.landingX - halfWidth, paddle_center - reach), halfWidth);
+        float high = std::min(std::min(prediction.landingX + halfWidth, paddle_center + reach), window_width - halfWidth);
+
+        if (low > high)
+            continue;
+
+        int firstColumn = std::min(static_cast<int>(std::ceil(low)), numColumns - 1);
+        int lastColumn = std::max(static_cast<int>(std::floor(high)), firstColumn);
+        lastColumn = std::min(lastColumn, numColumns - 1);
+
+        double weight = 1.0 + soonerScale / (1.0 + prediction.steps);
+        this->coverage[firstColumn] += weight;
+        this->coverage[lastColumn + 1] -= weight;
+        isAnySaved = true;
+    }
+
+    if (!isAnySaved)
+        return false;
+
+    // Find the best column, taking the one closest to the paddle when several are equal
+    const double TOLERANCE = 1e-9;
+
+    double saved = 0.0;
+    double bestSaved = 0.0;
+    int bestColumn = -1;
+
+    for (int column = 0; column < numColumns; ++column)
+    {
+        saved += this->coverage[column];
+
+        bool isBetter = (saved > bestSaved + TOLERANCE);
+        bool isEqual = (!isBetter && saved > bestSaved - TOLERANCE);
+
+        if (isBetter || (isEqual && bestColumn >= 0 && std::fabs(column - paddle_center) < std::fabs(bestColumn - paddle_center)))
+        {
+            bestSaved = std::max(saved, bestSaved);
+            bestColumn = column;
+        }
+    }
+
+    target_out = static_cast<float>(bestColumn);
+
+    return true;
+}
+
+
+// Method to return the paddle centre the bot is heading for (-1 if none)
+// ----------------------------------------------------------------------
+float PaddleController::GetTargetX() const
+{
+    return this->targetX;
+}
+
+
+// Method to predict where (ball centre x) and after how many steps a ball reaches paddle_top
+// ------------------------------------------------------------------------------------------
+bool PaddleController::PredictBall(const glm::vec2& position, const glm::vec2& size, const glm::vec2& velocity, float paddle_top, float window_width, float dt, BallPrediction& prediction)
+{
+    // Ignore balls which would take longer than this to arrive (ten minutes at 60 steps per second)
+    const double MAX_STEPS = 36000.0;
+
+    // The ball touches the paddle row once its top reaches this
+    double touchY = paddle_top - size.y;
+    double stepY = static_cast<double>(velocity.y) * dt;
+    double steps;
+
+    if (velocity.y > 0.0f)
+    {
+        // Falling: straight down to the paddle row
+        steps = std::max(std::ceil((touchY - position.y) / stepY), 0.0);
+    }
+    else if (velocity.y < 0.0f)
+    {
+        // Rising: up to the top wall, where MoveBall puts the ball at 0 and turns it around, then down from there
+        double toTop = std::max(std::ceil(position.y / -stepY), 1.0);
+        steps = toTop + std::max(std::ceil(touchY / -stepY), 0.0);
+    }
+    else
+    {
+        return false;
+    }
+
+    if (steps > MAX_STEPS)
+        return false;
+
+    double x = PositionAfterSteps(position.x, static_cast<double>(velocity.x) * dt, window_width - size.x, steps);
+
+    prediction.landingX = static_cast<float>(x) + size.x / 2.0f;
+    prediction.steps = static_cast<unsigned int>(steps);
+
+    return true;
+}
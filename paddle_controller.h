@@ -0,0 +1,98 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//  BREAKOUT REMIX
+//  --------------
+//  by slate2b
+//
+//  The PaddleController class is a bot which plays the game (for soak
+//  tests and attract mode).
+//
+//  Every step it predicts where each ball will reach the paddle row, and
+//  when.  The prediction solves the ball's path in closed form instead of
+//  stepping it: MoveBall moves a ball the same distance every step and
+//  puts it back against a wall when it crosses one, so after the first
+//  bounce the ball takes the same number of steps to cross from one wall
+//  to the other every time.  Counting the steps to the first wall, then
+//  whole crossings, gives the position after any number of steps in a few
+//  operations.  It matches MoveBall to within one step of the ball for
+//  flights of several seconds (MoveBall adds floats every step, so very
+//  long flights drift), and bricks, other balls and the paddle are not
+//  predicted, so the prediction is redone every step.
+//
+//  Each ball which can still be reached gives the range of paddle centres
+//  which would save it.  The ranges are added up in a coverage array with
+//  one entry per pixel, and the paddle heads for the covered spot which
+//  saves the most balls (the sooner they arrive, the better), so choosing
+//  the target costs one pass over the balls and one over the window width.
+//
+//  The bot plays through the keys (A, D and Space), like a player or a
+//  replay, so the game still moves the paddle and any ball it holds.
+//
+//     PaddleController controller;
+//     controller.Update(game, dt);
+//     game.ProcessInput(dt);
+//     game.UpdateGame(dt);
+//
+//  The PaddleController class is responsible for the following:
+//
+//     * Predicting where and when each ball reaches the paddle row
+//     * Choosing the paddle position which saves the most balls
+//     * Pressing the keys which move the paddle there and launch balls
+//
+///////////////////////////////////////////////////////////////////////////
+
+#ifndef PADDLECONTROLLER_H
+#define PADDLECONTROLLER_H
+
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "game.h"
+
+// Struct to hold where and when a ball reaches the paddle row
+struct BallPrediction
+{
+	float landingX;
+	unsigned int steps;
+};
+
+
+class PaddleController
+{
+
+public:
+
+	// Constructor
+	PaddleController();
+
+	// Method to predict the balls and press the keys for the next step of the game
+	void Update(Game& game, float dt);
+
+	// Method to predict every moving ball of balls which will reach paddle_top (fills predictions, returns how many)
+	// NOTE: Balls which are held, out of play or not moving vertically are skipped
+	unsigned int PredictBalls(const BallArchetype& balls, float paddle_top, float window_width, float dt);
+
+	// Method to choose the paddle centre which saves the most predicted balls (returns false if none can be saved)
+	bool ChooseTarget(float paddle_center, float paddle_width, float window_width, float dt, float& target_out);
+
+	// Method to return the paddle centre the bot is heading for (-1 if none)
+	float GetTargetX() const;
+
+	// Method to predict where (ball centre x) and after how many steps a ball reaches paddle_top
+	// NOTE: Returns false if it never does (not moving down after the top wall)
+	static bool PredictBall(const glm::vec2& position, const glm::vec2& size, const glm::vec2& velocity, float paddle_top, float window_width, float dt, BallPrediction& prediction);
+
+	// Predictions made by the last PredictBalls call
+	std::vector<BallPrediction> predictions;
+
+private:
+
+	// Paddle centre the bot is heading for (-1 if none)
+	float targetX;
+
+	// Balls saved at each pixel column (reused every step)
+	std::vector<double> coverage;
+};
+
+#endif
@@ -0,0 +1,153 @@
+#!/usr/bin/env bash
+###########################################################################
+#
+#  BREAKOUT REMIX
+#  --------------
+#  by slate2b
+#
+#  Profile-guided optimization workflow (GCC or Clang).
+#
+#  1. Builds the default (baseline) configuration
+#  2. Builds an instrumented configuration (BREAKOUT_PGO=GENERATE)
+#  3. Trains the profiles by playing every replay in the replays folder
+#     through headless_sim (fails if no profiles were written)
+#  4. Rebuilds the same folder with the profiles (BREAKOUT_PGO=USE)
+#     NOTE: GCC names each profile after the object file's full path, so
+#           the instrumented and optimized builds must share a folder
+#  5. Optionally (--bolt) instruments the PGO build of headless_sim with
+#     llvm-bolt, trains it on the same replays and writes a BOLT-optimized
+#     copy
+#  6. Reports the speedup over the baseline for the collision benchmark
+#     (BM_ProcessCollisions) and for whole-frame time (replays)
+#
+#  Usage:
+#
+#     ./pgo_build.sh [--bolt] [--repeat N] [--build-root DIR] [-- <extra cmake args>]
+#
+###########################################################################
+
+set -euo pipefail
+
+SOURCE_DIR="$(cd "$(dirname "$0")" && pwd)"
+BUILD_ROOT="${SOURCE_DIR}/build-pgo"
+USE_BOLT=0
+REPEAT=3
+EXTRA_CMAKE_ARGS=()
+
+# Read the command line options
+while [ $# -gt 0 ]; do
+    case "$1" in
+        --bolt) USE_BOLT=1 ;;
+        --repeat) REPEAT="$2"; shift ;;
+        --build-root) BUILD_ROOT="$2"; shift ;;
+        --) shift; EXTRA_CMAKE_ARGS=("$@"); break ;;
+        *) echo "Error: Unknown option $1"; exit 1 ;;
+    esac
+    shift
+done
+
+BASE_DIR="${BUILD_ROOT}/base"
+PGO_DIR="${BUILD_ROOT}/pgo"
+PROFILE_DIR="${BUILD_ROOT}/profiles"
+REPLAYS=("${SOURCE_DIR}"/replays/*.rpl)
+
+BOLT_ARGS=()
+if [ "${USE_BOLT}" -eq 1 ]; then
+    BOLT_ARGS=(-DBREAKOUT_BOLT_READY=ON)
+fi
+
+# Method to configure and build one variant (folder, then extra cmake args)
+build_variant() {
+    local dir="$1"
+    shift
+    cmake -S "${SOURCE_DIR}" -B "${dir}" -DCMAKE_BUILD_TYPE=Release -DBREAKOUT_BUILD_GAME=OFF \
+        ${BOLT_ARGS[@]+"${BOLT_ARGS[@]}"} ${EXTRA_CMAKE_ARGS[@]+"${EXTRA_CMAKE_ARGS[@]}"} "$@" > "${dir}.configure.log"
+    cmake --build "${dir}" -j > "${dir}.build.log"
+}
+
+# Method to play every replay through a headless_sim executable (runs in the folder holding the level files)
+play_replays() {
+    local simulator="$1"
+    local folder="$2"
+    for replay in "${REPLAYS[@]}"; do
+        (cd "${folder}" && "${simulator}" --replay "${replay}" --repeat "${REPEAT}" > /dev/null)
+    done
+}
+
+# Method to return the mean frame time (ns) over every replay
+mean_frame_time() {
+    local simulator="$1"
+    local folder="$2"
+    for replay in "${REPLAYS[@]}"; do
+        (cd "${folder}" && "${simulator}" --replay "${replay}" --repeat "${REPEAT}")
+    done | awk -F': *' '/Mean frame time/ { total += $2; count += 1 } END { printf "%.2f", total / count }'
+}
+
+# Method to print "name real_time" pairs from a benchmark JSON file
+benchmark_times() {
+    awk -F'"' '/"name":/ { name = $4 } /"real_time":/ { split($3, value, /[:, ]+/); print name, value[2] }' "$1"
+}
+
+if [ ${#REPLAYS[@]} -eq 0 ] || [ ! -f "${REPLAYS[0]}" ]; then
+    echo "Error: No replays found in ${SOURCE_DIR}/replays"
+    exit 1
+fi
+
+mkdir -p "${BUILD_ROOT}"
+rm -rf "${PROFILE_DIR}"
+
+echo "== Building baseline"
+build_variant "${BASE_DIR}"
+
+echo "== Building instrumented (PGO generate)"
+build_variant "${PGO_DIR}" -DBREAKOUT_PGO=GENERATE -DBREAKOUT_PGO_DIR="${PROFILE_DIR}"
+
+echo "== Training on ${#REPLAYS[@]} replays"
+play_replays "${PGO_DIR}/headless_sim" "${PGO_DIR}"
+
+# Make sure the training run actually wrote profiles (GCC .gcda or Clang .profraw)
+if [ -z "$(find "${PROFILE_DIR}" \( -name '*.gcda' -o -name '*.profraw' \) -print -quit 2> /dev/null)" ]; then
+    echo "Error: The training run wrote no profiles to ${PROFILE_DIR}"
+    exit 1
+fi
+
+# Clang writes raw profiles which must be merged before they can be used
+if ls "${PROFILE_DIR}"/*.profraw > /dev/null 2>&1; then
+    llvm-profdata merge -o "${PROFILE_DIR}/default.profdata" "${PROFILE_DIR}"/*.profraw
+fi
+
+echo "== Building optimized (PGO use, same folder so the profile names match)"
+build_variant "${PGO_DIR}" -DBREAKOUT_PGO=USE -DBREAKOUT_PGO_DIR="${PROFILE_DIR}"
+
+OPTIMIZED_SIM="${PGO_DIR}/headless_sim"
+
+if [ "${USE_BOLT}" -eq 1 ]; then
+    echo "== Training BOLT profile"
+    BOLT_PROFILE="${BUILD_ROOT}/headless_sim.fdata"
+    rm -f "${BOLT_PROFILE}"
+    llvm-bolt "${PGO_DIR}/headless_sim" -instrument -instrumentation-file="${BOLT_PROFILE}" \
+        -instrumentation-file-append-pid=0 -o "${PGO_DIR}/headless_sim.instrumented" > "${BUILD_ROOT}/bolt.log"
+    play_replays "${PGO_DIR}/headless_sim.instrumented" "${PGO_DIR}"
+    llvm-bolt "${PGO_DIR}/headless_sim" -data="${BOLT_PROFILE}" -o "${PGO_DIR}/headless_sim.bolt" \
+        -reorder-blocks=ext-tsp -reorder-functions=hfsort -split-functions -split-all-cold -icf=1 >> "${BUILD_ROOT}/bolt.log"
+    OPTIMIZED_SIM="${PGO_DIR}/headless_sim.bolt"
+fi
+
+echo "== Measuring collision benchmark"
+"${BASE_DIR}/microbenchmarks" --benchmark_filter=BM_ProcessCollisions/ --benchmark_out="${BUILD_ROOT}/base.json" > /dev/null
+"${PGO_DIR}/microbenchmarks" --benchmark_filter=BM_ProcessCollisions/ --benchmark_out="${BUILD_ROOT}/pgo.json" > /dev/null
+
+echo "== Measuring whole-frame time"
+BASE_FRAME=$(mean_frame_time "${BASE_DIR}/headless_sim" "${BASE_DIR}")
+OPTIMIZED_FRAME=$(mean_frame_time "${OPTIMIZED_SIM}" "${PGO_DIR}")
+
+echo
+echo "Collision benchmark (real time, ns)"
+join <(benchmark_times "${BUILD_ROOT}/base.json" | sort) <(benchmark_times "${BUILD_ROOT}/pgo.json" | sort) \
+    | awk '{ speedup = $2 / $3; product += log(speedup); count += 1; printf "  %-36s %14.1f %14.1f   %.3fx\n", $1, $2, $3, speedup }
+           END { if (count > 0) printf "  %-36s %32s   %.3fx\n", "geometric mean", "", exp(product / count) }'
+
+echo
+echo "Whole-frame time over the replays (mean, ns)"
+awk -v base="${BASE_FRAME}" -v optimized="${OPTIMIZED_FRAME}" -v label="$(basename "${OPTIMIZED_SIM}")" \
+    'BEGIN { printf "  baseline %.2f   %s %.2f   %.3fx\n", base, label, optimized, base / optimized }'
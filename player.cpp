@@ -24,12 +24,6 @@ Player::Player(glm::vec2 pos, glm::vec2 size, glm::vec3 color, glm::vec2 velocit
 {
 }
 
-Player::~Player()
-{
-	GameObject::~GameObject();
-
-}
-
 // Method to initizlize the player object
 void Player::InitPlayer(unsigned int window_width, unsigned int window_height)
 {
@@ -45,10 +39,3 @@ void Player::InitPlayer(unsigned int window_width, unsigned int window_height)
 	glm::vec2 playerPos = glm::vec2((window_width / 2.0f) - (this->Size.x / 2.0f), window_height - this->Size.y);
 	this->Position = playerPos;
 }
-
-// Method to draw the player
-void Player::DrawPlayer(ShapeRenderer& shape_renderer, Shader& shader)
-{
-	// Calling the GameObject class's Draw method
-	this->DrawObject(shape_renderer, shader);
-}
\ No newline at end of file
@@ -26,13 +26,11 @@ public:
 	// Full Constructor
 	Player(glm::vec2 pos, glm::vec2 size, glm::vec3 color, glm::vec2 velocity);
 
-	// Destructor
-	~Player();
-
 	// Method to initialize player object
 	void InitPlayer(unsigned int window_width, unsigned int window_height);
 
 	// Method to draw the player
+	// NOTE: Defined in game_render.cpp (renderer library)
 	void DrawPlayer(ShapeRenderer& shape_renderer, Shader& shader);
 
 };
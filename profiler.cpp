@@ -0,0 +1,106 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//  BREAKOUT REMIX
+//  --------------
+//  by slate2b
+//
+//  The Profiler class collects wall clock timings for named sections of
+//  the game.
+//
+//  The Profiler class is responsible for the following:
+//
+//     * Recording the time taken by each named section
+//     * Keeping the count, total, maximum and latest time per section
+//	   * Printing a report of every section
+//
+///////////////////////////////////////////////////////////////////////////
+
+#include "profiler.h"
+
+#include <iostream>
+
+
+// Method to record one timing for a section (the section is created the first time)
+// ---------------------------------------------------------------------------------
+void Profiler::Record(const char* section_name, double seconds)
+{
+    // Only a handful of sections are used, so a linear search is enough
+    for (ProfileSection& section : this->sections)
+    {
+        if (section.name == section_name)
+        {
+            section.count += 1;
+            section.totalSeconds += seconds;
+            section.lastSeconds = seconds;
+
+            if (seconds > section.maxSeconds)
+                section.maxSeconds = seconds;
+
+            return;
+        }
+    }
+
+    ProfileSection section;
+    section.name = section_name;
+    section.count = 1;
+    section.totalSeconds = seconds;
+    section.maxSeconds = seconds;
+    section.lastSeconds = seconds;
+
+    this->sections.push_back(section);
+}
+
+
+// Method to find a section by name (returns nullptr if nothing has been recorded for it)
+// -------------------------------------------------------------------------------------
+const Profiler::ProfileSection* Profiler::FindSection(const char* section_name) const
+{
+    for (const ProfileSection& section : this->sections)
+    {
+        if (section.name == section_name)
+            return &section;
+    }
+
+    return nullptr;
+}
+
+
+// Method to print the timings of every section
+// --------------------------------------------
+void Profiler::PrintReport() const
+{
+    for (const ProfileSection& section : this->sections)
+    {
+        std::cout << section.name << " (ms): " << section.count << " times"
+            << "  avg " << section.totalSeconds / section.count * 1000.0
+            << "  max " << section.maxSeconds * 1000.0
+            << "  last " << section.lastSeconds * 1000.0 << std::endl;
+    }
+}
+
+
+// Method to remove every section
+// ------------------------------
+void Profiler::Clear()
+{
+    this->sections.clear();
+}
+
+
+// Constructor (starts timing the section)
+// ---------------------------------------
+ProfileScope::ProfileScope(Profiler& profiler, const char* section_name)
+    : profiler(profiler), sectionName(section_name)
+{
+    startTime = std::chrono::steady_clock::now();
+}
+
+
+// Destructor (records the time taken)
+// -----------------------------------
+ProfileScope::~ProfileScope()
+{
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - this->startTime).count();
+
+    this->profiler.Record(this->sectionName, seconds);
+}
@@ -0,0 +1,84 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//  BREAKOUT REMIX
+//  --------------
+//  by slate2b
+//
+//  The Profiler class collects wall clock timings for named sections of
+//  the game (e.g. level transitions), so rare but important events can be
+//  checked for stalls without a full profiling tool.
+//
+//  A section is timed with a ProfileScope, which measures from where it
+//  is created to the end of the enclosing block:
+//
+//     {
+//         ProfileScope scope(profiler, "Level transition");
+//         ...
+//     }
+//
+//  The Profiler class is responsible for the following:
+//
+//     * Recording the time taken by each named section
+//     * Keeping the count, total, maximum and latest time per section
+//	   * Printing a report of every section
+//
+///////////////////////////////////////////////////////////////////////////
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+class Profiler
+{
+
+public:
+
+	// Struct to hold the timings recorded for one named section
+	struct ProfileSection
+	{
+		std::string name;
+		unsigned int count;
+		double totalSeconds;
+		double maxSeconds;
+		double lastSeconds;
+	};
+
+	// Sections in the order they were first recorded
+	std::vector<ProfileSection> sections;
+
+	// Method to record one timing for a section (the section is created the first time)
+	void Record(const char* section_name, double seconds);
+
+	// Method to find a section by name (returns nullptr if nothing has been recorded for it)
+	const ProfileSection* FindSection(const char* section_name) const;
+
+	// Method to print the timings of every section
+	void PrintReport() const;
+
+	// Method to remove every section
+	void Clear();
+};
+
+
+class ProfileScope
+{
+
+public:
+
+	// Constructor (starts timing the section)
+	ProfileScope(Profiler& profiler, const char* section_name);
+
+	// Destructor (records the time taken)
+	~ProfileScope();
+
+private:
+
+	Profiler& profiler;
+	const char* sectionName;
+	std::chrono::steady_clock::time_point startTime;
+};
+
+#endif
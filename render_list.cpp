@@ -0,0 +1,81 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//  BREAKOUT REMIX
+//  --------------
+//  by slate2b
+//
+//  The RenderState and RenderList classes let the shapes for a frame be
+//  prepared away from the main thread.
+//
+//  The RenderState and RenderList classes are responsible for the following:
+//
+//     * Copying the drawable components out of the game
+//     * Building the list of shapes to draw for a frame
+//
+///////////////////////////////////////////////////////////////////////////
+
+#include "render_list.h"
+
+
+// Method to remove every shape (keeps the memory for the next frame)
+// ------------------------------------------------------------------
+void RenderList::Clear()
+{
+    this->shapes.clear();
+}
+
+
+// Method to add a shape to the end of the list
+// --------------------------------------------
+void RenderList::AddShape(const glm::vec2& position, const glm::vec2& size, const glm::vec3& color)
+{
+    ShapeInstance shape;
+    shape.position = position;
+    shape.size = size;
+    shape.color = color;
+
+    this->shapes.push_back(shape);
+}
+
+
+// Method to copy the drawable components out of the bricks, balls and player paddle
+// ---------------------------------------------------------------------------------
+void RenderState::Capture(const BrickArchetype& bricks, const BallArchetype& balls, const GameObject& player_object)
+{
+    this->brickTransforms = bricks.Column<Transform>();
+    this->brickRenderables = bricks.Column<Renderable>();
+    this->brickStates = bricks.Column<Breakable>();
+
+    this->ballTransforms = balls.Column<Transform>();
+    this->ballRenderables = balls.Column<Renderable>();
+    this->ballStates = balls.Column<BallState>();
+
+    this->playerTransform.position = player_object.Position;
+    this->playerTransform.size = player_object.Size;
+    this->playerRenderable.color = player_object.Color;
+}
+
+
+// Method to build the list of shapes to draw (bricks, then the player, then the balls)
+// ------------------------------------------------------------------------------------
+void RenderState::BuildRenderList(RenderList& render_list) const
+{
+    render_list.Clear();
+
+    // Add the bricks which are NOT destroyed
+    for (unsigned int i = 0; i < this->brickTransforms.size(); ++i)
+    {
+        if (!this->brickStates[i].isDestroyed)
+            render_list.AddShape(this->brickTransforms[i].position, this->brickTransforms[i].size, this->brickRenderables[i].color);
+    }
+
+    // Add the player
+    render_list.AddShape(this->playerTransform.position, this->playerTransform.size, this->playerRenderable.color);
+
+    // Add the balls which are in play and NOT destroyed
+    for (unsigned int i = 0; i < this->ballTransforms.size(); ++i)
+    {
+        if (this->ballStates[i].isInPlay && !this->ballStates[i].isDestroyed)
+            render_list.AddShape(this->ballTransforms[i].position, this->ballTransforms[i].size, this->ballRenderables[i].color);
+    }
+}
@@ -0,0 +1,92 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//  BREAKOUT REMIX
+//  --------------
+//  by slate2b
+//
+//  The RenderState and RenderList classes let the shapes for a frame be
+//  prepared away from the main thread.
+//
+//  A RenderState is a copy of everything needed to draw one frame (the
+//  bricks, the balls and the player paddle).  Once it has been captured,
+//  the game can go on to simulate the next frame while a job builds the
+//  RenderList from the captured copy.  The live game state and the
+//  captured RenderState act as a double buffer.
+//
+//  A RenderList is the list of shapes (position, size and color) to draw,
+//  in draw order.  Only drawing the list needs OpenGL (see
+//  Game::DrawRenderList in game_render.cpp), so it must stay on the
+//  thread which owns the OpenGL context.
+//
+//  The RenderState and RenderList classes are responsible for the following:
+//
+//     * Copying the drawable components out of the game
+//     * Building the list of shapes to draw for a frame
+//
+///////////////////////////////////////////////////////////////////////////
+
+#ifndef RENDERLIST_H
+#define RENDERLIST_H
+
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "components.h"
+#include "brick_object.h"
+#include "ball_object.h"
+#include "game_object.h"
+
+// Struct to hold one shape to draw
+struct ShapeInstance
+{
+	glm::vec2 position;
+	glm::vec2 size;
+	glm::vec3 color;
+};
+
+
+class RenderList
+{
+
+public:
+
+	// The shapes to draw, in draw order
+	std::vector<ShapeInstance> shapes;
+
+	// Method to remove every shape (keeps the memory for the next frame)
+	void Clear();
+
+	// Method to add a shape to the end of the list
+	void AddShape(const glm::vec2& position, const glm::vec2& size, const glm::vec3& color);
+};
+
+
+class RenderState
+{
+
+public:
+
+	// Copies of the brick components needed for drawing
+	std::vector<Transform> brickTransforms;
+	std::vector<Renderable> brickRenderables;
+	std::vector<Breakable> brickStates;
+
+	// Copies of the ball components needed for drawing
+	std::vector<Transform> ballTransforms;
+	std::vector<Renderable> ballRenderables;
+	std::vector<BallState> ballStates;
+
+	// Copy of the player paddle
+	Transform playerTransform;
+	Renderable playerRenderable;
+
+	// Method to copy the drawable components out of the bricks, balls and player paddle
+	// NOTE: Copying into the existing vectors reuses their memory from the previous frame
+	void Capture(const BrickArchetype& bricks, const BallArchetype& balls, const GameObject& player_object);
+
+	// Method to build the list of shapes to draw (bricks, then the player, then the balls)
+	void BuildRenderList(RenderList& render_list) const;
+};
+
+#endif
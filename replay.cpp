@@ -0,0 +1,168 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//  BREAKOUT REMIX
+//  --------------
+//  by slate2b
+//
+//  The Replay class records the player's input one frame at a time so a
+//  session can be played back later without a window (e.g. by the
+//  headless simulation, or to train profile-guided optimization).
+//
+//  The Replay class is responsible for the following:
+//
+//     * Recording the keys and delta time for each frame
+//     * Saving and loading replay files
+//	   * Applying a recorded frame's keys to the game
+//
+///////////////////////////////////////////////////////////////////////////
+
+#include "replay.h"
+
+#include <fstream>
+#include <iostream>
+#include <string>
+
+Replay::Replay()
+{
+    playLine = 0;
+    playFrame = 0;
+}
+
+
+// Method to record the game's current keys for a frame with the given delta time
+// ------------------------------------------------------------------------------
+void Replay::RecordFrame(const Game& game, float dt)
+{
+    // Pack the keys used by the game into a key mask
+    unsigned int keyMask = 0;
+
+    if (game.keys[KEY_A])
+        keyMask |= REPLAY_KEY_A;
+    if (game.keys[KEY_D])
+        keyMask |= REPLAY_KEY_D;
+    if (game.keys[KEY_SPACE])
+        keyMask |= REPLAY_KEY_SPACE;
+
+    // If the frame matches the previous one, extend that line instead of adding a new one
+    if (!this->frames.empty() && this->frames.back().deltaTime == dt && this->frames.back().keyMask == keyMask)
+    {
+        this->frames.back().frameCount += 1;
+        return;
+    }
+
+    ReplayFrame frame;
+    frame.frameCount = 1;
+    frame.deltaTime = dt;
+    frame.keyMask = keyMask;
+    this->frames.push_back(frame);
+}
+
+
+// Method to return the total number of frames in the replay
+// ---------------------------------------------------------
+unsigned int Replay::GetFrameCount() const
+{
+    unsigned int frameCount = 0;
+
+    for (const ReplayFrame& frame : this->frames)
+    {
+        frameCount += frame.frameCount;
+    }
+
+    return frameCount;
+}
+
+
+// Method to save the replay to file
+// ---------------------------------
+bool Replay::Save(const char* file) const
+{
+    std::ofstream fstream(file);
+
+    if (!fstream)
+    {
+        std::cout << "Error: Writing Replay " << file << std::endl;
+        return false;
+    }
+
+    // Write enough digits for the delta time to load back as the exact same float
+    fstream.precision(9);
+    fstream << "BREAKOUT_REPLAY 1\n";
+
+    for (const ReplayFrame& frame : this->frames)
+    {
+        fstream << frame.frameCount << ' ' << frame.deltaTime << ' ' << frame.keyMask << '\n';
+    }
+
+    return static_cast<bool>(fstream);
+}
+
+
+// Method to load a replay from file
+// ---------------------------------
+bool Replay::Load(const char* file)
+{
+    std::ifstream fstream(file);
+    std::string header;
+    int version = 0;
+
+    // Check the header
+    if (!fstream || !(fstream >> header >> version) || header != "BREAKOUT_REPLAY" || version != 1)
+    {
+        std::cout << "Error: Loading Replay " << file << std::endl;
+        return false;
+    }
+
+    this->frames.clear();
+
+    ReplayFrame frame;
+
+    // Read one line of identical frames at a time
+    while (fstream >> frame.frameCount >> frame.deltaTime >> frame.keyMask)
+    {
+        if (frame.frameCount > 0)
+            this->frames.push_back(frame);
+    }
+
+    this->Rewind();
+
+    return true;
+}
+
+
+// Method to restart playback from the first frame
+// -----------------------------------------------
+void Replay::Rewind()
+{
+    this->playLine = 0;
+    this->playFrame = 0;
+}
+
+
+// Method to apply the next frame's keys to the game and return its delta time (returns false at the end)
+// ------------------------------------------------------------------------------------------------------
+bool Replay::PlayFrame(Game& game, float& dt_out)
+{
+    // Stop at the end of the replay
+    if (this->playLine >= this->frames.size())
+        return false;
+
+    const ReplayFrame& frame = this->frames[this->playLine];
+
+    // Press the recorded keys
+    game.keys[KEY_A] = (frame.keyMask & REPLAY_KEY_A) != 0;
+    game.keys[KEY_D] = (frame.keyMask & REPLAY_KEY_D) != 0;
+    game.keys[KEY_SPACE] = (frame.keyMask & REPLAY_KEY_SPACE) != 0;
+    dt_out = frame.deltaTime;
+
+    // Move to the next frame
+    this->playFrame += 1;
+
+    if (this->playFrame >= frame.frameCount)
+    {
+        this->playLine += 1;
+        this->playFrame = 0;
+    }
+
+    return true;
+}
@@ -0,0 +1,87 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//  BREAKOUT REMIX
+//  --------------
+//  by slate2b
+//
+//  The Replay class records the player's input one frame at a time so a
+//  session can be played back later without a window (e.g. by the
+//  headless simulation, or to train profile-guided optimization).
+//
+//  Replay files are plain text:
+//
+//     BREAKOUT_REPLAY 1
+//     <frame count> <delta time> <key mask>
+//     ...
+//
+//  Consecutive frames with the same delta time and keys share one line.
+//  The key mask holds one bit per key used by the game (see ReplayKey).
+//
+//  The Replay class is responsible for the following:
+//
+//     * Recording the keys and delta time for each frame
+//     * Saving and loading replay files
+//	   * Applying a recorded frame's keys to the game
+//
+///////////////////////////////////////////////////////////////////////////
+
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include <vector>
+
+#include "game.h"
+
+// Bits used in the replay key mask
+enum ReplayKey {
+	REPLAY_KEY_A = 1,
+	REPLAY_KEY_D = 2,
+	REPLAY_KEY_SPACE = 4
+};
+
+class Replay
+{
+
+public:
+
+	// Struct to hold one or more identical frames
+	struct ReplayFrame
+	{
+		unsigned int frameCount;
+		float deltaTime;
+		unsigned int keyMask;
+	};
+
+	// Recorded frames (run-length encoded)
+	std::vector<ReplayFrame> frames;
+
+	// Constructor
+	Replay();
+
+	// Method to record the game's current keys for a frame with the given delta time
+	void RecordFrame(const Game& game, float dt);
+
+	// Method to return the total number of frames in the replay
+	unsigned int GetFrameCount() const;
+
+	// Method to save the replay to file
+	bool Save(const char* file) const;
+
+	// Method to load a replay from file
+	bool Load(const char* file);
+
+	// Methods to play the replay back one frame at a time
+	// ---------------------------------------------------
+	// Method to restart playback from the first frame
+	void Rewind();
+	// Method to apply the next frame's keys to the game and return its delta time (returns false at the end)
+	bool PlayFrame(Game& game, float& dt_out);
+
+private:
+
+	// Playback position (line in frames, and frame within that line)
+	unsigned int playLine;
+	unsigned int playFrame;
+};
+
+#endif
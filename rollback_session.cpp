@@ -0,0 +1,399 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//  BREAKOUT REMIX
+//  --------------
+//  by slate2b
+//
+//  The RollbackSession class runs a two player co-op game between two
+//  game instances with GGPO style rollback netcode.
+//
+//  Packet layout (little endian):
+//
+//     uint32  first frame of the inputs carried
+//     uint32  number of remote inputs the sender has received in order (acknowledgement)
+//     uint32  number of inputs carried
+//     uint8   one input per frame
+//
+//  The RollbackSession class is responsible for the following:
+//
+//     * Sending local inputs to the remote peer and receiving its inputs
+//     * Predicting the remote input for the frames not yet received
+//     * Saving a snapshot of the game before each frame
+//     * Rolling back and resimulating when a prediction was wrong
+//     * Simulating network latency, jitter and packet loss
+//
+///////////////////////////////////////////////////////////////////////////
+
+#include "rollback_session.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+
+const float RollbackSession::FRAME_DT = 1.0f / 60.0f;
+
+
+// Method to write a 32-bit value into a packet
+// --------------------------------------------
+static unsigned char* WriteUint32(unsigned char* out, uint32_t value)
+{
+    out[0] = static_cast<unsigned char>(value);
+    out[1] = static_cast<unsigned char>(value >> 8);
+    out[2] = static_cast<unsigned char>(value >> 16);
+    out[3] = static_cast<unsigned char>(value >> 24);
+    return out + 4;
+}
+
+// Method to read a 32-bit value from a packet
+// -------------------------------------------
+static const unsigned char* ReadUint32(const unsigned char* in, uint32_t& value)
+{
+    value = static_cast<uint32_t>(in[0]) | (static_cast<uint32_t>(in[1]) << 8)
+        | (static_cast<uint32_t>(in[2]) << 16) | (static_cast<uint32_t>(in[3]) << 24);
+    return in + 4;
+}
+
+
+RollbackSession::RollbackSession()
+    : networkRandom(1)
+{
+    this->remotePort = 0;
+    this->currentFrame = 0;
+    this->remoteFrames = 0;
+    this->localFramesAcked = 0;
+
+    std::memset(this->localInputs, 0, sizeof(this->localInputs));
+    std::memset(this->remoteInputs, 0, sizeof(this->remoteInputs));
+    std::memset(this->usedRemoteInputs, 0, sizeof(this->usedRemoteInputs));
+
+    this->latency = 0.0;
+    this->jitter = 0.0;
+    this->loss = 0.0;
+
+    this->rollbacks = 0;
+    this->framesResimulated = 0;
+    this->maxRollbackFrames = 0;
+    this->maxRollbackTime = 0.0;
+    this->totalRollbackTime = 0.0;
+    this->stalls = 0;
+    this->packetsSent = 0;
+    this->packetsDropped = 0;
+    this->packetsReceived = 0;
+}
+
+
+// Method to open the socket on local_port and start at frame 0 of the game
+// NOTE: Both peers must start from the same game state
+// ------------------------------------------------------------------------
+bool RollbackSession::Start(Game& game, unsigned short local_port, unsigned short remote_port)
+{
+    if (!this->socket.Open(local_port))
+        return false;
+
+    this->remotePort = remote_port;
+    this->currentFrame = 0;
+    this->remoteFrames = 0;
+    this->localFramesAcked = 0;
+    this->delayedPackets.clear();
+
+    // A rollback can restore the level played before a level change, so keep that level built
+    game.levelPack.SetRetainPreviousLevel(true);
+
+    // Size every snapshot up front, so saving a frame does not allocate
+    for (GameSnapshot& snapshot : this->snapshots)
+    {
+        snapshot.Reserve(game.ballObjects.Size(), game.activeLevel.bricks.Size());
+    }
+
+    return true;
+}
+
+
+// Method to hold back outgoing packets by latency +/- jitter seconds and drop a fraction loss of them
+// ---------------------------------------------------------------------------------------------------
+void RollbackSession::SetSimulatedNetwork(double latency, double jitter, double loss, unsigned int seed)
+{
+    this->latency = std::max(latency, 0.0);
+    this->jitter = std::max(jitter, 0.0);
+    this->loss = std::min(std::max(loss, 0.0), 1.0);
+    this->networkRandom.seed(seed);
+}
+
+
+// Method to receive remote inputs (rolling back if needed), then step the game one frame with local_input
+// -------------------------------------------------------------------------------------------------------
+bool RollbackSession::AdvanceFrame(Game& game, unsigned char local_input, double now)
+{
+    this->FlushDelayedPackets(now);
+    this->ReceiveInputs(game);
+
+    // Stall if this peer is as far ahead of the remote input as a rollback can reach (resending in case inputs were lost)
+    if (this->currentFrame - this->remoteFrames >= MAX_ROLLBACK_FRAMES)
+    {
+        this->stalls += 1;
+        this->SendInputs(now);
+        this->FlushDelayedPackets(now);
+        return false;
+    }
+
+    unsigned int slot = this->currentFrame % INPUT_HISTORY;
+    this->localInputs[slot] = local_input;
+
+    // Save the state before the frame, then step it with the remote input (or its prediction)
+    this->snapshots[this->currentFrame % (MAX_ROLLBACK_FRAMES + 1)].Save(game);
+
+    unsigned char remoteInput = this->GetRemoteInput(this->currentFrame);
+    this->usedRemoteInputs[slot] = remoteInput;
+    StepFrame(game, local_input, remoteInput);
+
+    this->currentFrame += 1;
+
+    // Send the new input straight away
+    this->SendInputs(now);
+    this->FlushDelayedPackets(now);
+
+    return true;
+}
+
+
+// Method to send and receive packets (rolling back if needed) without stepping the game
+// -------------------------------------------------------------------------------------
+void RollbackSession::Poll(Game& game, double now)
+{
+    this->FlushDelayedPackets(now);
+    this->ReceiveInputs(game);
+
+    // Resend the inputs the remote peer has not acknowledged, in case they were lost
+    if (this->localFramesAcked < this->currentFrame)
+        this->SendInputs(now);
+
+    this->FlushDelayedPackets(now);
+}
+
+
+// Method to return the number of frames simulated
+// -----------------------------------------------
+unsigned int RollbackSession::GetFrame() const
+{
+    return this->currentFrame;
+}
+
+
+// Method to return the number of frames for which both players' inputs are known
+// ------------------------------------------------------------------------------
+unsigned int RollbackSession::GetConfirmedFrame() const
+{
+    return std::min(this->currentFrame, this->remoteFrames);
+}
+
+
+// Method to print the rollback and network statistics
+// ---------------------------------------------------
+void RollbackSession::PrintReport() const
+{
+    const double FRAME_BUDGET_MS = 1000.0 * FRAME_DT;
+
+    std::cout << "Frames: " << this->currentFrame << " (" << this->GetConfirmedFrame() << " confirmed, "
+        << this->stalls << " stalls)" << std::endl;
+    std::cout << "Rollbacks: " << this->rollbacks << ", frames resimulated: " << this->framesResimulated
+        << ", deepest: " << this->maxRollbackFrames << " frames" << std::endl;
+
+    if (this->rollbacks > 0)
+    {
+        std::cout << "Rollback time: mean " << (1000.0 * this->totalRollbackTime / this->rollbacks) << " ms, max "
+            << (1000.0 * this->maxRollbackTime) << " ms (frame budget " << FRAME_BUDGET_MS << " ms)" << std::endl;
+    }
+
+    std::cout << "Packets: " << this->packetsSent << " sent, " << this->packetsDropped << " dropped, "
+        << this->packetsReceived << " received" << std::endl;
+}
+
+
+// Method to turn the keys held into an input (A = left, D = right, Space)
+// -----------------------------------------------------------------------
+unsigned char RollbackSession::InputFromKeys(const bool* keys)
+{
+    unsigned char input = 0;
+
+    if (keys[KEY_A])
+        input |= NET_INPUT_LEFT;
+    if (keys[KEY_D])
+        input |= NET_INPUT_RIGHT;
+    if (keys[KEY_SPACE])
+        input |= NET_INPUT_SPACE;
+
+    return input;
+}
+
+
+// Method to step the game one frame with the merged inputs of both players
+// ------------------------------------------------------------------------
+void RollbackSession::StepFrame(Game& game, unsigned char local_input, unsigned char remote_input)
+{
+    // A key is held if either player holds it (the order of the players does not matter, so both peers merge the same way)
+    unsigned char input = local_input | remote_input;
+
+    game.keys[KEY_A] = (input & NET_INPUT_LEFT) != 0;
+    game.keys[KEY_D] = (input & NET_INPUT_RIGHT) != 0;
+    game.keys[KEY_SPACE] = (input & NET_INPUT_SPACE) != 0;
+
+    game.ProcessInput(FRAME_DT);
+    game.UpdateGame(FRAME_DT);
+}
+
+
+// Method to return the remote input used for a frame (the real input if received, otherwise the prediction)
+// ---------------------------------------------------------------------------------------------------------
+unsigned char RollbackSession::GetRemoteInput(unsigned int frame) const
+{
+    if (frame < this->remoteFrames)
+        return this->remoteInputs[frame % INPUT_HISTORY];
+
+    // Predict that the remote player still holds the keys of the last input received
+    if (this->remoteFrames == 0)
+        return 0;
+
+    return this->remoteInputs[(this->remoteFrames - 1) % INPUT_HISTORY];
+}
+
+
+// Method to read the waiting packets, then roll back to the first frame simulated with a wrong prediction
+// ------------------------------------------------------------------------------------------------------
+void RollbackSession::ReceiveInputs(Game& game)
+{
+    unsigned int firstMispredicted = this->currentFrame;
+
+    unsigned char packet[12 + MAX_PACKET_INPUTS];
+    size_t size;
+
+    while ((size = this->socket.Receive(packet, sizeof(packet))) > 0)
+    {
+        if (size < 12)
+            continue;
+
+        uint32_t firstFrame, ackFrames, numInputs;
+        const unsigned char* in = packet;
+        in = ReadUint32(in, firstFrame);
+        in = ReadUint32(in, ackFrames);
+        in = ReadUint32(in, numInputs);
+
+        // Ignore malformed packets
+        if (numInputs > MAX_PACKET_INPUTS || size < 12 + numInputs)
+            continue;
+
+        this->packetsReceived += 1;
+        this->localFramesAcked = std::max(this->localFramesAcked, std::min(ackFrames, this->currentFrame));
+
+        // Take the inputs which follow on from the last one received (a gap means an earlier packet is still to come)
+        for (uint32_t i = 0; i < numInputs; ++i)
+        {
+            unsigned int frame = firstFrame + i;
+
+            if (frame != this->remoteFrames)
+                continue;
+
+            // The remote peer never runs more than MAX_ROLLBACK_FRAMES ahead, so the history slot is free
+            if (frame >= this->currentFrame + INPUT_HISTORY - MAX_ROLLBACK_FRAMES)
+                break;
+
+            unsigned int slot = frame % INPUT_HISTORY;
+            this->remoteInputs[slot] = in[i];
+            this->remoteFrames += 1;
+
+            if (frame < this->currentFrame && this->usedRemoteInputs[slot] != in[i])
+                firstMispredicted = std::min(firstMispredicted, frame);
+        }
+    }
+
+    if (firstMispredicted < this->currentFrame)
+        this->Rollback(game, firstMispredicted);
+}
+
+
+// Method to restore the game to the start of first_frame and simulate again up to the current frame
+// -------------------------------------------------------------------------------------------------
+void RollbackSession::Rollback(Game& game, unsigned int first_frame)
+{
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    this->snapshots[first_frame % (MAX_ROLLBACK_FRAMES + 1)].Restore(game);
+
+    for (unsigned int frame = first_frame; frame < this->currentFrame; ++frame)
+    {
+        unsigned int slot = frame % INPUT_HISTORY;
+
+        // Save the corrected state (a later rollback may start here), except for the frame just restored
+        if (frame != first_frame)
+            this->snapshots[frame % (MAX_ROLLBACK_FRAMES + 1)].Save(game);
+
+        unsigned char remoteInput = this->GetRemoteInput(frame);
+        this->usedRemoteInputs[slot] = remoteInput;
+        StepFrame(game, this->localInputs[slot], remoteInput);
+    }
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    unsigned int numFrames = this->currentFrame - first_frame;
+
+    this->rollbacks += 1;
+    this->framesResimulated += numFrames;
+    this->maxRollbackFrames = std::max(this->maxRollbackFrames, numFrames);
+    this->maxRollbackTime = std::max(this->maxRollbackTime, seconds);
+    this->totalRollbackTime += seconds;
+}
+
+
+// Method to send the local inputs not yet acknowledged (through the simulated network)
+// ------------------------------------------------------------------------------------
+void RollbackSession::SendInputs(double now)
+{
+    // Send the oldest unacknowledged inputs first (the remote peer can only take them in order)
+    unsigned int firstFrame = this->localFramesAcked;
+    unsigned int numInputs = std::min(this->currentFrame - firstFrame, MAX_PACKET_INPUTS);
+
+    DelayedPacket packet;
+    unsigned char* out = packet.data;
+    out = WriteUint32(out, firstFrame);
+    out = WriteUint32(out, this->remoteFrames);
+    out = WriteUint32(out, numInputs);
+
+    for (unsigned int i = 0; i < numInputs; ++i)
+    {
+        out[i] = this->localInputs[(firstFrame + i) % INPUT_HISTORY];
+    }
+
+    packet.size = 12 + numInputs;
+    this->packetsSent += 1;
+
+    // Drop the packet, or hold it back for the latency plus or minus the jitter
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+
+    if (this->loss > 0.0 && uniform(this->networkRandom) < this->loss)
+    {
+        this->packetsDropped += 1;
+        return;
+    }
+
+    double delay = this->latency;
+
+    if (this->jitter > 0.0)
+        delay += this->jitter * (2.0 * uniform(this->networkRandom) - 1.0);
+
+    packet.deliveryTime = now + std::max(delay, 0.0);
+    this->delayedPackets.push_back(packet);
+}
+
+
+// Method to pass on the held back packets which are due
+// -----------------------------------------------------
+void RollbackSession::FlushDelayedPackets(double now)
+{
+    for (const DelayedPacket& packet : this->delayedPackets)
+    {
+        if (packet.deliveryTime <= now)
+            this->socket.Send(this->remotePort, packet.data, packet.size);
+    }
+
+    this->delayedPackets.erase(std::remove_if(this->delayedPackets.begin(), this->delayedPackets.end(),
+        [now](const DelayedPacket& packet) { return packet.deliveryTime <= now; }), this->delayedPackets.end());
+}
@@ -0,0 +1,182 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//  BREAKOUT REMIX
+//  --------------
+//  by slate2b
+//
+//  The RollbackSession class runs a two player co-op game between two
+//  game instances with GGPO style rollback netcode.
+//
+//  Each peer runs the whole simulation.  Every frame, a peer sends its
+//  own input to the other peer and steps the game straight away, using a
+//  prediction of the remote input (the last remote input received).  The
+//  state before each frame is saved in a GameSnapshot.  When a remote
+//  input arrives which differs from the prediction, the game is restored
+//  to the snapshot of that frame and the frames since then are simulated
+//  again with the real input.  The game must be deterministic for both
+//  peers to end up in the same state (see Game::ComputeStateHash).
+//
+//  Both players share the paddle: the inputs of the two peers are merged
+//  (a key is held if either player holds it) before each step.
+//
+//  A peer never runs more than MAX_ROLLBACK_FRAMES frames ahead of the
+//  last remote input received: it stalls (does not step) until the remote
+//  input catches up.  Each packet carries every local input the remote
+//  peer has not acknowledged, so the next packet covers a lost one.
+//
+//  The packets go over a loopback UDP socket, so both peers can run on one
+//  machine.  SetSimulatedNetwork holds back the outgoing packets to add
+//  latency, jitter (which also reorders packets) and packet loss.
+//
+//     RollbackSession session;
+//     session.Start(game, 7000, 7001);
+//     session.SetSimulatedNetwork(0.050, 0.010, 0.02, 1);
+//     ...
+//     session.AdvanceFrame(game, RollbackSession::InputFromKeys(keys), now);
+//
+//  The RollbackSession class is responsible for the following:
+//
+//     * Sending local inputs to the remote peer and receiving its inputs
+//     * Predicting the remote input for the frames not yet received
+//     * Saving a snapshot of the game before each frame
+//     * Rolling back and resimulating when a prediction was wrong
+//     * Simulating network latency, jitter and packet loss
+//
+///////////////////////////////////////////////////////////////////////////
+
+#ifndef ROLLBACKSESSION_H
+#define ROLLBACKSESSION_H
+
+#include <random>
+#include <vector>
+
+#include "game.h"
+#include "game_snapshot.h"
+#include "udp_socket.h"
+
+// Bits of a player's input for one frame
+enum NetInput {
+	NET_INPUT_LEFT = 1,
+	NET_INPUT_RIGHT = 2,
+	NET_INPUT_SPACE = 4
+};
+
+class RollbackSession
+{
+
+public:
+
+	// Most frames a peer can run ahead of the remote input (so the most frames resimulated by one rollback)
+	static const unsigned int MAX_ROLLBACK_FRAMES = 8;
+
+	// Frames of input history kept for each player (must be well above twice MAX_ROLLBACK_FRAMES)
+	static const unsigned int INPUT_HISTORY = 64;
+
+	// Most inputs carried by one packet
+	static const unsigned int MAX_PACKET_INPUTS = 32;
+
+	// Fixed time step of every frame (60 frames per second)
+	static const float FRAME_DT;
+
+	// Constructor
+	RollbackSession();
+
+	// Method to open the socket on local_port and start at frame 0 of the game (returns false if the socket failed)
+	bool Start(Game& game, unsigned short local_port, unsigned short remote_port);
+
+	// Method to hold back outgoing packets by latency +/- jitter seconds and drop a fraction loss of them
+	void SetSimulatedNetwork(double latency, double jitter, double loss, unsigned int seed);
+
+	// Method to receive remote inputs (rolling back if needed), then step the game one frame with local_input
+	// NOTE: now is the current time in seconds (used for the simulated network), returns false if the frame stalled
+	bool AdvanceFrame(Game& game, unsigned char local_input, double now);
+
+	// Method to send and receive packets (rolling back if needed) without stepping the game
+	void Poll(Game& game, double now);
+
+	// Method to return the number of frames simulated
+	unsigned int GetFrame() const;
+
+	// Method to return the number of frames for which both players' inputs are known (their state is final)
+	unsigned int GetConfirmedFrame() const;
+
+	// Method to print the rollback and network statistics
+	void PrintReport() const;
+
+	// Method to turn the keys held into an input (A = left, D = right, Space)
+	static unsigned char InputFromKeys(const bool* keys);
+
+	// Method to step the game one frame with the merged inputs of both players
+	static void StepFrame(Game& game, unsigned char local_input, unsigned char remote_input);
+
+private:
+
+	// Struct to hold a packet waiting in the simulated network
+	struct DelayedPacket
+	{
+		double deliveryTime;
+		unsigned int size;
+		unsigned char data[12 + MAX_PACKET_INPUTS];
+	};
+
+	// Socket and the remote peer's port
+	UdpSocket socket;
+	unsigned short remotePort;
+
+	// Number of frames simulated (the next frame to simulate)
+	unsigned int currentFrame;
+
+	// Input history, indexed by frame % INPUT_HISTORY
+	// NOTE: usedRemoteInputs holds the remote input each frame was last simulated with (confirmed or predicted)
+	unsigned char localInputs[INPUT_HISTORY];
+	unsigned char remoteInputs[INPUT_HISTORY];
+	unsigned char usedRemoteInputs[INPUT_HISTORY];
+
+	// Number of remote inputs received in order (frames 0 to remoteFrames - 1 are known)
+	unsigned int remoteFrames;
+
+	// Number of local inputs the remote peer has acknowledged
+	unsigned int localFramesAcked;
+
+	// Snapshot of the game before each frame, indexed by frame % (MAX_ROLLBACK_FRAMES + 1)
+	GameSnapshot snapshots[MAX_ROLLBACK_FRAMES + 1];
+
+	// Simulated network
+	double latency;
+	double jitter;
+	double loss;
+	std::mt19937 networkRandom;
+	std::vector<DelayedPacket> delayedPackets;
+
+	// Statistics
+	unsigned int rollbacks;
+	unsigned int framesResimulated;
+	unsigned int maxRollbackFrames;
+	double maxRollbackTime;
+	double totalRollbackTime;
+	unsigned int stalls;
+	unsigned int packetsSent;
+	unsigned int packetsDropped;
+	unsigned int packetsReceived;
+
+	// Method to return the remote input used for a frame (the real input if received, otherwise the prediction)
+	unsigned char GetRemoteInput(unsigned int frame) const;
+
+	// Method to read the waiting packets, then roll back to the first frame simulated with a wrong prediction
+	void ReceiveInputs(Game& game);
+
+	// Method to restore the game to the start of first_frame and simulate again up to the current frame
+	void Rollback(Game& game, unsigned int first_frame);
+
+	// Method to send the local inputs not yet acknowledged (through the simulated network)
+	void SendInputs(double now);
+
+	// Method to pass on the held back packets which are due
+	void FlushDelayedPackets(double now);
+
+	// Sessions cannot be copied
+	RollbackSession(const RollbackSession&);
+	RollbackSession& operator=(const RollbackSession&);
+};
+
+#endif
@@ -0,0 +1,510 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//  BREAKOUT REMIX
+//  --------------
+//  by slate2b
+//
+//  Headless soak test.
+//
+//  This program lets the AI paddle controller play the game for days of
+//  game time, as fast as it will run (three days take a few minutes), to
+//  catch problems which only show up in long sessions: memory which is
+//  never given back, frames which get slower as the session goes on, and
+//  state which stops coming out the same.
+//
+//  The run is split into windows of game time (an hour by default).  The
+//  first window is a warm-up, in which the level pack fills its cache and
+//  the game's arrays grow to their working sizes.  For every window it
+//  reports:
+//
+//     * The median, 99th and 99.9th percentile and longest frame times
+//     * The number of heap allocations, the heap in use at its end, and
+//       the peak heap use and resident memory so far
+//
+//  The bot hardly ever loses, so for the last minutes of every window it
+//  only launches balls and leaves the paddle alone, until the balls are
+//  lost and the level starts over (the game over path gets soaked too).
+//
+//  Every few hundred frames the step is checked instead of timed: the
+//  state hash must survive a snapshot round trip, running the step again
+//  from the snapshot must give the same hash, and the game state must
+//  make sense (timers in range, the live brick count matching the
+//  bricks, the paddle in the window and no ball off in NaN).
+//
+//  The program exits with 1 if any check failed, if the heap in use or
+//  the peak heap use grew after the warm-up by more than the slack, or if
+//  a window's median frame time is more than --max-slowdown times the
+//  first window's after the warm-up.
+//
+//  Options:
+//
+//     --hours N           Hours of game time to play (default 72)
+//     --window-hours N    Hours of game time in each reported window (default 1)
+//     --check-every N     Frames between checked steps (default 600, every 10 seconds of game time, at least 2)
+//     --miss-minutes N    Minutes of game time at the end of every window in which the paddle is left alone (default 10)
+//     --max-slowdown F    Slowest allowed median frame time, relative to the first window (default 2)
+//     --leak-slack-kb N   Heap growth allowed after the warm-up, in KB (default 256)
+//     --collision-threads N  Threads used to detect ball and brick collisions (default 1)
+//     --fixed-point       Use the deterministic (fixed point) physics
+//
+///////////////////////////////////////////////////////////////////////////
+
+#include "game.h"
+#include "game_snapshot.h"
+#include "paddle_controller.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+// Constants for the simulated screen (matches Source.cpp)
+const unsigned int SCREEN_WIDTH = 800;
+const unsigned int SCREEN_HEIGHT = 600;
+
+// Fixed time step used for every simulated frame (60 frames per second)
+const float FRAME_DT = 1.0f / 60.0f;
+
+
+/////////////////////////
+//
+// Heap counting
+//
+/////////////////////////
+
+// Every allocation made through new in this program (including the game's vectors) is counted by the
+// replacements of the global new and delete below.  Each block starts with a header holding its size,
+// so delete knows how many bytes are given back.
+// NOTE: Over-aligned allocations use the standard library's own new and are not counted
+
+// Bytes in front of every counted block (keeps the alignment new guarantees)
+const size_t ALLOCATION_HEADER = alignof(std::max_align_t);
+
+std::atomic<unsigned long long> allocationCount(0);
+std::atomic<long long> liveHeapBytes(0);
+std::atomic<long long> peakHeapBytes(0);
+
+
+// Method to count an allocation of size bytes and raise the peak heap use if needed
+// ---------------------------------------------------------------------------------
+static void CountAllocation(size_t size)
+{
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    long long live = liveHeapBytes.fetch_add(static_cast<long long>(size), std::memory_order_relaxed) + static_cast<long long>(size);
+    long long peak = peakHeapBytes.load(std::memory_order_relaxed);
+
+    while (live > peak && !peakHeapBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed))
+    {
+    }
+}
+
+
+void* operator new(size_t size)
+{
+    void* block = std::malloc(size + ALLOCATION_HEADER);
+
+    if (block == nullptr)
+        throw std::bad_alloc();
+
+    *static_cast<size_t*>(block) = size;
+    CountAllocation(size);
+
+    return static_cast<char*>(block) + ALLOCATION_HEADER;
+}
+
+
+void* operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+
+void operator delete(void* pointer) noexcept
+{
+    if (pointer == nullptr)
+        return;
+
+    void* block = static_cast<char*>(pointer) - ALLOCATION_HEADER;
+    liveHeapBytes.fetch_sub(static_cast<long long>(*static_cast<size_t*>(block)), std::memory_order_relaxed);
+    std::free(block);
+}
+
+
+void operator delete[](void* pointer) noexcept
+{
+    operator delete(pointer);
+}
+
+
+void operator delete(void* pointer, size_t) noexcept
+{
+    operator delete(pointer);
+}
+
+
+void operator delete[](void* pointer, size_t) noexcept
+{
+    operator delete(pointer);
+}
+
+
+// Method to return the most memory the process has had resident so far, in KB
+// ---------------------------------------------------------------------------
+static long long PeakResidentKB()
+{
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        return 0;
+
+    return static_cast<long long>(counters.PeakWorkingSetSize / 1024);
+#else
+    struct rusage usage;
+
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0;
+
+#ifdef __APPLE__
+    // macOS reports bytes, Linux reports KB
+    return static_cast<long long>(usage.ru_maxrss / 1024);
+#else
+    return static_cast<long long>(usage.ru_maxrss);
+#endif
+#endif
+}
+
+
+/////////////////////////
+//
+// State checks
+//
+/////////////////////////
+
+// Snapshot used by the checked steps (reused, so checking does not allocate once it has grown)
+GameSnapshot checkSnapshot;
+
+// Number of checked steps, and of the checks which failed
+unsigned long long stepsChecked = 0;
+unsigned long long checksFailed = 0;
+
+
+// Method to report a failed check (only the first few are printed)
+// ----------------------------------------------------------------
+static void FailCheck(unsigned long long frame, const char* message)
+{
+    const unsigned long long MAX_PRINTED = 10;
+
+    if (checksFailed < MAX_PRINTED)
+        std::cout << "Error: Frame " << frame << ": " << message << std::endl;
+
+    checksFailed += 1;
+}
+
+
+// Method to check that the game state makes sense (returns the broken rule, or nullptr if there is none)
+// -------------------------------------------------------------------------------------------------------
+static const char* FindBrokenInvariant(const Game& game)
+{
+    // The ball in play timer is put back to 240 once it passes 1000
+    if (game.ballInPlayTimer > 1000)
+        return "ball in play timer is past 1000";
+
+    // The live brick count must match the bricks which are not destroyed
+    const std::vector<Breakable>& brickStates = game.activeLevel.bricks.Column<Breakable>();
+    unsigned int liveBricks = 0;
+
+    for (const Breakable& brickState : brickStates)
+    {
+        if (!brickState.isDestroyed)
+            liveBricks += 1;
+    }
+
+    if (liveBricks != game.activeLevel.liveBricks)
+        return "live brick count does not match the bricks";
+
+    // The paddle stays in the window
+    if (game.player.Position.x < 0.0f || game.player.Position.x + game.player.Size.x > game.windowWidth)
+        return "paddle is outside the window";
+
+    // Every ball has a real position and velocity
+    const std::vector<Transform>& transforms = game.ballObjects.Column<Transform>();
+    const std::vector<Velocity>& velocities = game.ballObjects.Column<Velocity>();
+
+    for (unsigned int i = 0; i < game.ballObjects.Size(); ++i)
+    {
+        if (!std::isfinite(transforms[i].position.x) || !std::isfinite(transforms[i].position.y) ||
+            !std::isfinite(velocities[i].velocity.x) || !std::isfinite(velocities[i].velocity.y))
+            return "ball position or velocity is not a number";
+    }
+
+    return nullptr;
+}
+
+
+// Method to run one step of the game with every state check
+// ---------------------------------------------------------
+static void CheckedStep(Game& game, float dt, unsigned long long frame)
+{
+    stepsChecked += 1;
+
+    // The state must come back exactly after a snapshot round trip...
+    uint64_t startHash = game.ComputeStateHash();
+    checkSnapshot.Save(game);
+    checkSnapshot.Restore(game);
+
+    if (game.ComputeStateHash() != startHash)
+        FailCheck(frame, "state hash changed after restoring a snapshot");
+
+    // ...and the step must come out the same when run again from the snapshot
+    game.ProcessInput(dt);
+    game.UpdateGame(dt);
+    uint64_t stepHash = game.ComputeStateHash();
+
+    checkSnapshot.Restore(game);
+    game.ProcessInput(dt);
+    game.UpdateGame(dt);
+
+    if (game.ComputeStateHash() != stepHash)
+        FailCheck(frame, "state hash differs when the step is run again from a snapshot");
+
+    const char* brokenInvariant = FindBrokenInvariant(game);
+
+    if (brokenInvariant != nullptr)
+        FailCheck(frame, brokenInvariant);
+}
+
+
+// Method to press the keys for the next step (with is_missing, only balls are launched and the paddle stays put)
+// -------------------------------------------------------------------------------------------------------------
+static void PlayStep(PaddleController& controller, Game& game, bool is_missing)
+{
+    controller.Update(game, FRAME_DT);
+
+    if (is_missing)
+    {
+        game.keys[KEY_A] = false;
+        game.keys[KEY_D] = false;
+    }
+}
+
+
+/////////////////////////
+//
+// Windows
+//
+/////////////////////////
+
+// Struct to hold the measurements of one window
+struct WindowReport
+{
+    double medianNs;
+    double p99Ns;
+    double p999Ns;
+    double maxNs;
+    unsigned long long allocations;
+    long long liveHeapBytes;
+    long long peakHeapBytes;
+    long long peakResidentKB;
+};
+
+
+// Method to return the value at a fraction (0 to 1) of the way through the sorted frame times
+// NOTE: Partially sorts frame_times around that place (only the one value needs to be right)
+// -------------------------------------------------------------------------------------------
+static double Percentile(std::vector<float>& frame_times, double fraction)
+{
+    size_t index = static_cast<size_t>(fraction * (frame_times.size() - 1));
+    std::nth_element(frame_times.begin(), frame_times.begin() + index, frame_times.end());
+    return frame_times[index];
+}
+
+
+int main(int argc, char* argv[])
+{
+    double hours = 72.0;
+    double windowHours = 1.0;
+    unsigned int checkEvery = 600;
+    double missMinutes = 10.0;
+    double maxSlowdown = 2.0;
+    long long leakSlackKB = 256;
+    unsigned int collisionThreads = 1;
+    bool isFixedPoint = false;
+
+    // Read the command line options
+    for (int i = 1; i < argc; ++i)
+    {
+        bool hasValue = (i + 1 < argc);
+
+        if (std::strcmp(argv[i], "--hours") == 0 && hasValue)
+            hours = std::atof(argv[++i]);
+        else if (std::strcmp(argv[i], "--window-hours") == 0 && hasValue)
+            windowHours = std::atof(argv[++i]);
+        else if (std::strcmp(argv[i], "--check-every") == 0 && hasValue)
+            checkEvery = std::strtoul(argv[++i], nullptr, 10);
+        else if (std::strcmp(argv[i], "--miss-minutes") == 0 && hasValue)
+            missMinutes = std::atof(argv[++i]);
+        else if (std::strcmp(argv[i], "--max-slowdown") == 0 && hasValue)
+            maxSlowdown = std::atof(argv[++i]);
+        else if (std::strcmp(argv[i], "--leak-slack-kb") == 0 && hasValue)
+            leakSlackKB = std::atoll(argv[++i]);
+        else if (std::strcmp(argv[i], "--collision-threads") == 0 && hasValue)
+            collisionThreads = std::strtoul(argv[++i], nullptr, 10);
+        else if (std::strcmp(argv[i], "--fixed-point") == 0)
+            isFixedPoint = true;
+        else
+        {
+            std::cout << "Error: Unknown option " << argv[i] << std::endl;
+            return -1;
+        }
+    }
+
+    unsigned long long framesPerWindow = static_cast<unsigned long long>(windowHours * 3600.0 * 60.0 + 0.5);
+    unsigned long long numWindows = static_cast<unsigned long long>(std::ceil(hours / windowHours));
+    unsigned long long missFrames = static_cast<unsigned long long>(std::max(missMinutes, 0.0) * 60.0 * 60.0 + 0.5);
+    unsigned long long firstMissFrame = (missFrames < framesPerWindow) ? framesPerWindow - missFrames : 0;
+
+    // At least the warm-up window and one window to compare with it, and some timed (unchecked) steps between the checked ones
+    if (framesPerWindow == 0 || numWindows < 2 || checkEvery < 2)
+    {
+        std::cout << "Error: The soak test needs --hours of at least two windows and --check-every of at least 2" << std::endl;
+        return -1;
+    }
+
+    // Create the game without a window
+    Game game(SCREEN_WIDTH, SCREEN_HEIGHT);
+    game.InitSimulation();
+    game.SetCollisionThreads(collisionThreads);
+    game.SetFixedPoint(isFixedPoint);
+
+    PaddleController controller;
+
+    // Everything the test itself needs is allocated up front, so the windows only count the game's allocations
+    std::vector<float> frameTimes;
+    frameTimes.reserve(static_cast<size_t>(framesPerWindow));
+
+    std::vector<WindowReport> reports;
+    reports.reserve(static_cast<size_t>(numWindows));
+
+    std::cout << "Soak test: " << numWindows << " windows of " << windowHours << " game hours (" << framesPerWindow << " frames each)" << std::endl;
+    std::cout << std::endl;
+    std::cout << "Window  Game hours  Median (ns)  p99 (ns)  p99.9 (ns)  Max (us)  Allocations  Heap (KB)  Peak heap (KB)  Peak RSS (KB)" << std::endl;
+
+    unsigned long long frame = 0;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    for (unsigned long long window = 0; window < numWindows; ++window)
+    {
+        frameTimes.clear();
+        unsigned long long windowAllocations = allocationCount.load(std::memory_order_relaxed);
+
+        for (unsigned long long i = 0; i < framesPerWindow; ++i, ++frame)
+        {
+            bool isMissing = (i >= firstMissFrame);
+
+            // Checked steps do several times the work, so they are not timed
+            if (frame % checkEvery == 0)
+            {
+                PlayStep(controller, game, isMissing);
+                CheckedStep(game, FRAME_DT, frame);
+                continue;
+            }
+
+            std::chrono::steady_clock::time_point frameStart = std::chrono::steady_clock::now();
+
+            PlayStep(controller, game, isMissing);
+            game.ProcessInput(FRAME_DT);
+            game.UpdateGame(FRAME_DT);
+
+            frameTimes.push_back(std::chrono::duration<float, std::nano>(std::chrono::steady_clock::now() - frameStart).count());
+        }
+
+        WindowReport report;
+        report.maxNs = 0.0;
+        report.p999Ns = 0.0;
+        report.p99Ns = 0.0;
+        report.medianNs = 0.0;
+
+        // A window of a single checked step has no timed frames
+        if (!frameTimes.empty())
+        {
+            report.maxNs = *std::max_element(frameTimes.begin(), frameTimes.end());
+            report.p999Ns = Percentile(frameTimes, 0.999);
+            report.p99Ns = Percentile(frameTimes, 0.99);
+            report.medianNs = Percentile(frameTimes, 0.5);
+        }
+        report.allocations = allocationCount.load(std::memory_order_relaxed) - windowAllocations;
+        report.liveHeapBytes = liveHeapBytes.load(std::memory_order_relaxed);
+        report.peakHeapBytes = peakHeapBytes.load(std::memory_order_relaxed);
+        report.peakResidentKB = PeakResidentKB();
+        reports.push_back(report);
+
+        std::cout << std::setw(6) << window << (window == 0 ? "*" : " ")
+                  << std::setw(11) << std::fixed << std::setprecision(1) << (frame / 216000.0)
+                  << std::setw(13) << std::setprecision(0) << report.medianNs
+                  << std::setw(10) << report.p99Ns
+                  << std::setw(12) << report.p999Ns
+                  << std::setw(10) << report.maxNs / 1000.0
+                  << std::setw(13) << report.allocations
+                  << std::setw(11) << report.liveHeapBytes / 1024
+                  << std::setw(16) << report.peakHeapBytes / 1024
+                  << std::setw(15) << report.peakResidentKB << std::endl;
+    }
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << std::defaultfloat << std::setprecision(6) << std::endl;
+    std::cout << "(* warm-up window, not compared)" << std::endl;
+    std::cout << "Frames simulated:     " << frame << std::endl;
+    std::cout << "Wall time (s):        " << seconds << std::endl;
+    std::cout << "Game time per second: " << (frame / 60.0) / seconds << std::endl;
+    std::cout << "Levels cleared:       " << game.levelsCleared << std::endl;
+    std::cout << "Game overs:           " << game.levelResets << std::endl;
+    std::cout << "Steps checked:        " << stepsChecked << std::endl;
+    std::cout << "Checks failed:        " << checksFailed << std::endl;
+
+    // Compare every window after the warm-up with the end of the warm-up (memory) and the first window after it (speed)
+    const WindowReport& warmUp = reports[0];
+    const WindowReport& baseline = reports[1];
+    long long leakSlackBytes = leakSlackKB * 1024;
+    bool isPassed = (checksFailed == 0);
+
+    for (size_t i = 1; i < reports.size(); ++i)
+    {
+        if (reports[i].liveHeapBytes > warmUp.liveHeapBytes + leakSlackBytes)
+        {
+            std::cout << "Error: Window " << i << ": heap in use grew by " << (reports[i].liveHeapBytes - warmUp.liveHeapBytes) / 1024 << " KB since the warm-up" << std::endl;
+            isPassed = false;
+        }
+
+        if (reports[i].peakHeapBytes > warmUp.peakHeapBytes + leakSlackBytes)
+        {
+            std::cout << "Error: Window " << i << ": peak heap use grew by " << (reports[i].peakHeapBytes - warmUp.peakHeapBytes) / 1024 << " KB since the warm-up" << std::endl;
+            isPassed = false;
+        }
+
+        if (reports[i].medianNs > baseline.medianNs * maxSlowdown)
+        {
+            std::cout << "Error: Window " << i << ": median frame time " << reports[i].medianNs << " ns is more than " << maxSlowdown << " times the first window's " << baseline.medianNs << " ns" << std::endl;
+            isPassed = false;
+        }
+    }
+
+    std::cout << (isPassed ? "Soak test passed" : "Soak test FAILED") << std::endl;
+
+    return isPassed ? 0 : 1;
+}
@@ -0,0 +1,320 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//  BREAKOUT REMIX
+//  --------------
+//  by slate2b
+//
+//  The StateHasher class calculates a fast 64-bit hash of the game state
+//  (the xxHash64 algorithm), and the StateHashLog class streams one hash
+//  per simulation step to a file, or compares a run against such a file.
+//
+//  The StateHasher and StateHashLog classes are responsible for the following:
+//
+//     * Hashing pieces of the game state (xxHash64)
+//     * Streaming the hash of each step to a log file
+//	   * Comparing the hashes of a run with a saved log
+//
+///////////////////////////////////////////////////////////////////////////
+
+#include "state_hash.h"
+
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+// xxHash64 primes
+static const uint64_t PRIME_1 = 0x9E3779B185EBCA87ULL;
+static const uint64_t PRIME_2 = 0xC2B2AE3D27D4EB4FULL;
+static const uint64_t PRIME_3 = 0x165667B19E3779F9ULL;
+static const uint64_t PRIME_4 = 0x85EBCA77C2B2AE63ULL;
+static const uint64_t PRIME_5 = 0x27D4EB2F165667C5ULL;
+
+
+// Method to rotate a 64-bit value left
+// ------------------------------------
+static inline uint64_t RotateLeft(uint64_t value, unsigned int bits)
+{
+    return (value << bits) | (value >> (64 - bits));
+}
+
+// Method to read 8 bytes (memcpy, so the data does not need to be aligned)
+// ------------------------------------------------------------------------
+static inline uint64_t Read64(const unsigned char* data)
+{
+    uint64_t value;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+// Method to read 4 bytes
+// ----------------------
+static inline uint32_t Read32(const unsigned char* data)
+{
+    uint32_t value;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+// Method to mix 8 bytes of input into a lane
+// ------------------------------------------
+static inline uint64_t MixLane(uint64_t lane, uint64_t input)
+{
+    lane += input * PRIME_2;
+    lane = RotateLeft(lane, 31);
+    return lane * PRIME_1;
+}
+
+// Method to merge a lane into the final hash
+// ------------------------------------------
+static inline uint64_t MergeLane(uint64_t hash, uint64_t lane)
+{
+    hash ^= MixLane(0, lane);
+    return hash * PRIME_1 + PRIME_4;
+}
+
+
+/////////////////
+//
+// StateHasher
+//
+/////////////////
+
+StateHasher::StateHasher(uint64_t seed)
+{
+    this->Reset(seed);
+}
+
+
+// Method to start a new hash with the given seed
+// ----------------------------------------------
+void StateHasher::Reset(uint64_t seed)
+{
+    this->seed = seed;
+    this->lanes[0] = seed + PRIME_1 + PRIME_2;
+    this->lanes[1] = seed + PRIME_2;
+    this->lanes[2] = seed;
+    this->lanes[3] = seed - PRIME_1;
+    this->bufferSize = 0;
+    this->totalLength = 0;
+}
+
+
+// Method to add length bytes of data to the hash
+// ----------------------------------------------
+void StateHasher::Update(const void* data, size_t length)
+{
+    const unsigned char* input = static_cast<const unsigned char*>(data);
+    const unsigned char* end = input + length;
+
+    this->totalLength += length;
+
+    // Not enough for a full stripe yet, so keep the bytes for later
+    if (this->bufferSize + length < 32)
+    {
+        std::memcpy(this->buffer + this->bufferSize, input, length);
+        this->bufferSize += length;
+        return;
+    }
+
+    // Finish the stripe started by an earlier call
+    if (this->bufferSize > 0)
+    {
+        size_t fill = 32 - this->bufferSize;
+        std::memcpy(this->buffer + this->bufferSize, input, fill);
+        input += fill;
+
+        for (unsigned int i = 0; i < 4; ++i)
+            this->lanes[i] = MixLane(this->lanes[i], Read64(this->buffer + i * 8));
+
+        this->bufferSize = 0;
+    }
+
+    // Mix each full 32-byte stripe straight from the input
+    while (end - input >= 32)
+    {
+        for (unsigned int i = 0; i < 4; ++i)
+            this->lanes[i] = MixLane(this->lanes[i], Read64(input + i * 8));
+
+        input += 32;
+    }
+
+    // Keep the remaining bytes for the next call (or Digest)
+    this->bufferSize = static_cast<size_t>(end - input);
+    std::memcpy(this->buffer, input, this->bufferSize);
+}
+
+
+// Method to return the hash of everything added since the last Reset
+// ------------------------------------------------------------------
+uint64_t StateHasher::Digest() const
+{
+    uint64_t hash;
+
+    // Merge the lanes (only used once at least one full stripe has been added)
+    if (this->totalLength >= 32)
+    {
+        hash = RotateLeft(this->lanes[0], 1) + RotateLeft(this->lanes[1], 7) + RotateLeft(this->lanes[2], 12) + RotateLeft(this->lanes[3], 18);
+
+        for (unsigned int i = 0; i < 4; ++i)
+            hash = MergeLane(hash, this->lanes[i]);
+    }
+    else
+    {
+        hash = this->seed + PRIME_5;
+    }
+
+    hash += this->totalLength;
+
+    // Mix in the bytes which did not fill a stripe, 8, then 4, then 1 at a time
+    const unsigned char* input = this->buffer;
+    const unsigned char* end = this->buffer + this->bufferSize;
+
+    while (end - input >= 8)
+    {
+        hash ^= MixLane(0, Read64(input));
+        hash = RotateLeft(hash, 27) * PRIME_1 + PRIME_4;
+        input += 8;
+    }
+
+    if (end - input >= 4)
+    {
+        hash ^= static_cast<uint64_t>(Read32(input)) * PRIME_1;
+        hash = RotateLeft(hash, 23) * PRIME_2 + PRIME_3;
+        input += 4;
+    }
+
+    while (input < end)
+    {
+        hash ^= (*input) * PRIME_5;
+        hash = RotateLeft(hash, 11) * PRIME_1;
+        input += 1;
+    }
+
+    // Final avalanche so every input bit affects every output bit
+    hash ^= hash >> 33;
+    hash *= PRIME_2;
+    hash ^= hash >> 29;
+    hash *= PRIME_3;
+    hash ^= hash >> 32;
+
+    return hash;
+}
+
+
+/////////////////
+//
+// StateHashLog
+//
+/////////////////
+
+// Method to start streaming the hash of each step to a file
+// ---------------------------------------------------------
+bool StateHashLog::Open(const char* file)
+{
+    this->stream.open(file);
+
+    if (!this->stream)
+    {
+        std::cout << "Error: Writing State Hash Log " << file << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+
+// Method to write the hash of a step to the file opened with Open
+// NOTE: Fixed width hex, so two logs can also be compared with diff
+// -----------------------------------------------------------------
+void StateHashLog::Write(unsigned int step, uint64_t hash)
+{
+    this->stream << step << ' ' << std::hex << std::setw(16) << std::setfill('0') << hash << std::dec << '\n';
+}
+
+
+// Method to finish writing the file
+// ---------------------------------
+bool StateHashLog::Close()
+{
+    this->stream.close();
+    return !this->stream.fail();
+}
+
+
+// Method to load a log written by another run
+// -------------------------------------------
+bool StateHashLog::Load(const char* file)
+{
+    std::ifstream fstream(file);
+
+    if (!fstream)
+    {
+        std::cout << "Error: Reading State Hash Log " << file << std::endl;
+        return false;
+    }
+
+    this->loadedHashes.clear();
+    this->hasMismatch = false;
+    this->firstMismatch = 0;
+
+    std::string line;
+
+    while (std::getline(fstream, line))
+    {
+        std::istringstream sstream(line);
+        unsigned int step;
+        uint64_t hash;
+
+        if (!(sstream >> step >> std::hex >> hash))
+            continue;
+
+        if (step >= this->loadedHashes.size())
+            this->loadedHashes.resize(step + 1, 0);
+
+        this->loadedHashes[step] = hash;
+    }
+
+    return true;
+}
+
+
+// Method to compare the hash of a step against the loaded log
+// -----------------------------------------------------------
+bool StateHashLog::Check(unsigned int step, uint64_t hash)
+{
+    bool isMatch = step < this->loadedHashes.size() && this->loadedHashes[step] == hash;
+
+    if (!isMatch && !this->hasMismatch)
+    {
+        this->hasMismatch = true;
+        this->firstMismatch = step;
+    }
+
+    return isMatch;
+}
+
+
+// Method to return whether any step checked so far did not match the loaded log
+// -----------------------------------------------------------------------------
+bool StateHashLog::HasMismatch() const
+{
+    return this->hasMismatch;
+}
+
+
+// Method to return the first step which did not match the loaded log
+// ------------------------------------------------------------------
+unsigned int StateHashLog::GetFirstMismatch() const
+{
+    return this->firstMismatch;
+}
+
+
+// Method to return the number of steps in the loaded log
+// ------------------------------------------------------
+unsigned int StateHashLog::GetLoadedStepCount() const
+{
+    return static_cast<unsigned int>(this->loadedHashes.size());
+}
@@ -0,0 +1,120 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//  BREAKOUT REMIX
+//  --------------
+//  by slate2b
+//
+//  The StateHasher class calculates a fast 64-bit hash of the game state
+//  (the xxHash64 algorithm), and the StateHashLog class streams one hash
+//  per simulation step to a file, or compares a run against such a file.
+//
+//  Hashing the state after every step of a replayed session gives a
+//  compact record of how the session played out.  Two builds (or two
+//  machines) which play the same replay can then be compared step by step
+//  from their hash logs, and the first step with a different hash shows
+//  where their behavior split, without dumping the whole state.
+//
+//  The hasher is incremental: Update can be called any number of times
+//  with pieces of the state, and Digest returns the hash of everything
+//  added since the last Reset.
+//
+//     StateHasher hasher;
+//     hasher.Update(&score, sizeof(score));
+//     hasher.Update(balls.data(), balls.size() * sizeof(Ball));
+//     uint64_t hash = hasher.Digest();
+//
+//  NOTE: Raw memory is hashed, so hashes only match between machines with
+//        the same byte order (every platform the game currently targets).
+//
+//  The StateHasher and StateHashLog classes are responsible for the following:
+//
+//     * Hashing pieces of the game state (xxHash64)
+//     * Streaming the hash of each step to a log file
+//	   * Comparing the hashes of a run with a saved log
+//
+///////////////////////////////////////////////////////////////////////////
+
+#ifndef STATEHASH_H
+#define STATEHASH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <vector>
+
+class StateHasher
+{
+
+public:
+
+	// Constructor (starts a new hash with the given seed)
+	StateHasher(uint64_t seed = 0);
+
+	// Method to start a new hash with the given seed
+	void Reset(uint64_t seed = 0);
+
+	// Method to add length bytes of data to the hash
+	void Update(const void* data, size_t length);
+
+	// Method to return the hash of everything added since the last Reset (more data can still be added afterwards)
+	uint64_t Digest() const;
+
+private:
+
+	// The four lanes which each 32-byte stripe of data is mixed into
+	uint64_t lanes[4];
+
+	// Bytes waiting for a full stripe
+	unsigned char buffer[32];
+	size_t bufferSize;
+
+	// Total number of bytes added, and the seed used by Reset
+	uint64_t totalLength;
+	uint64_t seed;
+};
+
+
+class StateHashLog
+{
+
+public:
+
+	// Method to start streaming the hash of each step to a file (one "step hash" line per step)
+	bool Open(const char* file);
+
+	// Method to write the hash of a step to the file opened with Open
+	void Write(unsigned int step, uint64_t hash);
+
+	// Method to finish writing the file
+	bool Close();
+
+	// Method to load a log written by another run, to compare this run against with Check
+	bool Load(const char* file);
+
+	// Method to compare the hash of a step against the loaded log (returns false if it differs or is missing)
+	// NOTE: The first step which did not match is remembered, see GetFirstMismatch
+	bool Check(unsigned int step, uint64_t hash);
+
+	// Method to return whether any step checked so far did not match the loaded log
+	bool HasMismatch() const;
+
+	// Method to return the first step which did not match the loaded log
+	unsigned int GetFirstMismatch() const;
+
+	// Method to return the number of steps in the loaded log
+	unsigned int GetLoadedStepCount() const;
+
+private:
+
+	// File the hashes are streamed to
+	std::ofstream stream;
+
+	// Hashes loaded from another run's log (index = step)
+	std::vector<uint64_t> loadedHashes;
+
+	// Variables used to track the first step which did not match the loaded log
+	bool hasMismatch = false;
+	unsigned int firstMismatch = 0;
+};
+
+#endif
@@ -0,0 +1,190 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//  BREAKOUT REMIX
+//  --------------
+//  by slate2b
+//
+//  The UdpSocket class sends and receives datagrams between two game
+//  instances on the same machine (the loopback address, 127.0.0.1).
+//
+//  The UdpSocket class is responsible for the following:
+//
+//     * Opening a non-blocking socket on a loopback port
+//     * Sending a datagram to another loopback port
+//	   * Receiving the datagrams sent to this socket's port
+//
+///////////////////////////////////////////////////////////////////////////
+
+#include "udp_socket.h"
+
+#include <cstring>
+#include <iostream>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+typedef int SocketLength;
+#else
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+typedef socklen_t SocketLength;
+#endif
+
+
+// Method to fill in the loopback address for a port
+// -------------------------------------------------
+static sockaddr_in LoopbackAddress(unsigned short port)
+{
+    sockaddr_in address;
+    std::memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons(port);
+    return address;
+}
+
+
+UdpSocket::UdpSocket()
+{
+    this->socketHandle = -1;
+    this->isOpen = false;
+}
+
+UdpSocket::~UdpSocket()
+{
+    this->Close();
+}
+
+
+// Method to open a non-blocking socket bound to the given loopback port
+// ---------------------------------------------------------------------
+bool UdpSocket::Open(unsigned short port)
+{
+    this->Close();
+
+#ifdef _WIN32
+    // Start Winsock (every WSAStartup is matched by the WSACleanup in Close)
+    WSADATA wsaData;
+
+    if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0)
+    {
+        std::cout << "Error: Starting Winsock" << std::endl;
+        return false;
+    }
+
+    SOCKET handle = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+
+    if (handle == INVALID_SOCKET)
+    {
+        WSACleanup();
+        std::cout << "Error: Creating UDP Socket" << std::endl;
+        return false;
+    }
+#else
+    int handle = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+
+    if (handle < 0)
+    {
+        std::cout << "Error: Creating UDP Socket" << std::endl;
+        return false;
+    }
+#endif
+
+    this->socketHandle = static_cast<intptr_t>(handle);
+    this->isOpen = true;
+
+    sockaddr_in address = LoopbackAddress(port);
+
+    if (bind(handle, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0)
+    {
+        std::cout << "Error: Binding UDP Socket to port " << port << std::endl;
+        this->Close();
+        return false;
+    }
+
+    // Make the socket non-blocking, so Receive can be polled every frame
+#ifdef _WIN32
+    u_long isNonBlocking = 1;
+    bool isSet = (ioctlsocket(handle, FIONBIO, &isNonBlocking) == 0);
+#else
+    bool isSet = (fcntl(handle, F_SETFL, fcntl(handle, F_GETFL, 0) | O_NONBLOCK) == 0);
+#endif
+
+    if (!isSet)
+    {
+        std::cout << "Error: Making UDP Socket non-blocking" << std::endl;
+        this->Close();
+        return false;
+    }
+
+    return true;
+}
+
+
+// Method to close the socket
+// --------------------------
+void UdpSocket::Close()
+{
+    if (!this->isOpen)
+        return;
+
+#ifdef _WIN32
+    closesocket(static_cast<SOCKET>(this->socketHandle));
+    WSACleanup();
+#else
+    close(static_cast<int>(this->socketHandle));
+#endif
+
+    this->socketHandle = -1;
+    this->isOpen = false;
+}
+
+
+// Method to send a datagram to the given loopback port
+// ----------------------------------------------------
+bool UdpSocket::Send(unsigned short port, const void* data, size_t size)
+{
+    if (!this->isOpen)
+        return false;
+
+    sockaddr_in address = LoopbackAddress(port);
+
+#ifdef _WIN32
+    int sent = sendto(static_cast<SOCKET>(this->socketHandle), static_cast<const char*>(data), static_cast<int>(size), 0,
+        reinterpret_cast<const sockaddr*>(&address), sizeof(address));
+#else
+    ssize_t sent = sendto(static_cast<int>(this->socketHandle), data, size, 0,
+        reinterpret_cast<const sockaddr*>(&address), sizeof(address));
+#endif
+
+    return sent == static_cast<long long>(size);
+}
+
+
+// Method to receive one waiting datagram into buffer (returns its size, or 0 if nothing is waiting)
+// -------------------------------------------------------------------------------------------------
+size_t UdpSocket::Receive(void* buffer, size_t buffer_size)
+{
+    if (!this->isOpen)
+        return 0;
+
+    sockaddr_in sender;
+    SocketLength senderLength = sizeof(sender);
+
+#ifdef _WIN32
+    int received = recvfrom(static_cast<SOCKET>(this->socketHandle), static_cast<char*>(buffer), static_cast<int>(buffer_size), 0,
+        reinterpret_cast<sockaddr*>(&sender), &senderLength);
+#else
+    ssize_t received = recvfrom(static_cast<int>(this->socketHandle), buffer, buffer_size, 0,
+        reinterpret_cast<sockaddr*>(&sender), &senderLength);
+#endif
+
+    // Nothing waiting (or an error, which is treated the same way)
+    if (received <= 0)
+        return 0;
+
+    return static_cast<size_t>(received);
+}
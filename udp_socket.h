@@ -0,0 +1,61 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//  BREAKOUT REMIX
+//  --------------
+//  by slate2b
+//
+//  The UdpSocket class sends and receives datagrams between two game
+//  instances on the same machine (the loopback address, 127.0.0.1).
+//
+//  The socket never blocks: Receive returns straight away when no
+//  datagram is waiting, so it can be polled once per frame.
+//
+//  The UdpSocket class is responsible for the following:
+//
+//     * Opening a non-blocking socket on a loopback port
+//     * Sending a datagram to another loopback port
+//	   * Receiving the datagrams sent to this socket's port
+//
+///////////////////////////////////////////////////////////////////////////
+
+#ifndef UDPSOCKET_H
+#define UDPSOCKET_H
+
+#include <cstddef>
+#include <cstdint>
+
+class UdpSocket
+{
+
+public:
+
+	// Constructor (no socket until Open is called)
+	UdpSocket();
+
+	// Destructor (closes the socket)
+	~UdpSocket();
+
+	// Method to open a non-blocking socket bound to the given loopback port (returns false on failure)
+	bool Open(unsigned short port);
+
+	// Method to close the socket
+	void Close();
+
+	// Method to send a datagram to the given loopback port (returns false if it could not be sent)
+	bool Send(unsigned short port, const void* data, size_t size);
+
+	// Method to receive one waiting datagram into buffer (returns its size, or 0 if nothing is waiting)
+	size_t Receive(void* buffer, size_t buffer_size);
+
+private:
+
+	// Platform socket handle (a SOCKET on Windows, a file descriptor elsewhere)
+	intptr_t socketHandle;
+	bool isOpen;
+
+	// Sockets cannot be copied
+	UdpSocket(const UdpSocket&);
+	UdpSocket& operator=(const UdpSocket&);
+};
+
+#endif
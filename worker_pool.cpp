@@ -0,0 +1,174 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//  BREAKOUT REMIX
+//  --------------
+//  by slate2b
+//
+//  The WorkerPool class keeps a set of worker threads alive between
+//  frames so work can be split across CPU cores without starting new
+//  threads every frame.
+//
+//  The WorkerPool class is responsible for the following:
+//
+//     * Starting and stopping the worker threads
+//     * Handing out tasks to the workers
+//	   * Waiting for every task to finish
+//
+///////////////////////////////////////////////////////////////////////////
+
+#include "worker_pool.h"
+
+WorkerPool::WorkerPool()
+{
+    currentTask = nullptr;
+    numTasks = 0;
+    nextTask = 0;
+    workGeneration = 0;
+    busyWorkers = 0;
+    isStopping = false;
+}
+
+WorkerPool::~WorkerPool()
+{
+    this->StopWorkers();
+}
+
+
+// Method to set the number of threads used by Run, including the calling thread (minimum of 1)
+// --------------------------------------------------------------------------------------------
+void WorkerPool::SetThreadCount(unsigned int num_threads)
+{
+    if (num_threads < 1)
+        num_threads = 1;
+
+    // Nothing to do if the thread count has not changed
+    if (num_threads == this->threads.size() + 1)
+        return;
+
+    // Restart the workers with the new thread count
+    this->StopWorkers();
+
+    // New workers start from the current work generation (it is never reset), so they wait for the next Run
+    unsigned long long startGeneration;
+    {
+        std::lock_guard<std::mutex> lock(this->poolMutex);
+        this->isStopping = false;
+        startGeneration = this->workGeneration;
+    }
+
+    for (unsigned int i = 1; i < num_threads; ++i)
+    {
+        this->threads.push_back(std::thread(&WorkerPool::WorkerLoop, this, i, startGeneration));
+    }
+}
+
+
+// Method to return the number of threads used by Run, including the calling thread
+// --------------------------------------------------------------------------------
+unsigned int WorkerPool::GetThreadCount() const
+{
+    return static_cast<unsigned int>(this->threads.size()) + 1;
+}
+
+
+// Method to run a task for every task index in [0, num_tasks), and wait until they are all done
+// ---------------------------------------------------------------------------------------------
+void WorkerPool::Run(unsigned int num_tasks, const Task& task)
+{
+    // Without worker threads (or with a single task), run everything on the calling thread
+    if (this->threads.empty() || num_tasks <= 1)
+    {
+        for (unsigned int i = 0; i < num_tasks; ++i)
+            task(i, 0);
+
+        return;
+    }
+
+    // Publish the work and wake the workers
+    {
+        std::lock_guard<std::mutex> lock(this->poolMutex);
+        this->currentTask = &task;
+        this->numTasks = num_tasks;
+        this->nextTask = 0;
+        this->busyWorkers = static_cast<unsigned int>(this->threads.size());
+        this->workGeneration += 1;
+    }
+
+    this->workReady.notify_all();
+
+    // The calling thread works on tasks as worker 0
+    this->RunTasks(0);
+
+    // Wait until every worker has run out of tasks
+    std::unique_lock<std::mutex> lock(this->poolMutex);
+    this->workFinished.wait(lock, [this] { return this->busyWorkers == 0; });
+    this->currentTask = nullptr;
+}
+
+
+// Method run by each worker thread (start_generation is the last work generation the worker should not run)
+// ---------------------------------------------------------------------------------------------------------
+void WorkerPool::WorkerLoop(unsigned int worker_index, unsigned long long start_generation)
+{
+    unsigned long long seenGeneration = start_generation;
+
+    while (true)
+    {
+        // Wait for new work (or for the pool to stop)
+        {
+            std::unique_lock<std::mutex> lock(this->poolMutex);
+            this->workReady.wait(lock, [this, seenGeneration] { return this->isStopping || this->workGeneration != seenGeneration; });
+
+            if (this->isStopping)
+                return;
+
+            seenGeneration = this->workGeneration;
+        }
+
+        this->RunTasks(worker_index);
+
+        // Let Run know this worker is done
+        bool isLastWorker;
+        {
+            std::lock_guard<std::mutex> lock(this->poolMutex);
+            this->busyWorkers -= 1;
+            isLastWorker = (this->busyWorkers == 0);
+        }
+
+        if (isLastWorker)
+            this->workFinished.notify_one();
+    }
+}
+
+
+// Method to run tasks until there are none left
+// ---------------------------------------------
+void WorkerPool::RunTasks(unsigned int worker_index)
+{
+    // Each worker takes the next task index until all of them have been handed out
+    for (unsigned int i = this->nextTask++; i < this->numTasks; i = this->nextTask++)
+    {
+        (*this->currentTask)(i, worker_index);
+    }
+}
+
+
+// Method to stop and join the worker threads
+// ------------------------------------------
+void WorkerPool::StopWorkers()
+{
+    {
+        std::lock_guard<std::mutex> lock(this->poolMutex);
+        this->isStopping = true;
+    }
+
+    this->workReady.notify_all();
+
+    for (std::thread& thread : this->threads)
+    {
+        if (thread.joinable())
+            thread.join();
+    }
+
+    this->threads.clear();
+}
@@ -0,0 +1,85 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//  BREAKOUT REMIX
+//  --------------
+//  by slate2b
+//
+//  The WorkerPool class keeps a set of worker threads alive between
+//  frames so work can be split across CPU cores without starting new
+//  threads every frame.
+//
+//  Run() splits the work into numbered tasks.  The calling thread works
+//  on tasks too (as worker 0), and Run() only returns once every task is
+//  done.  Each task is also told which worker is running it, so tasks
+//  can write their results into per-worker buffers without locking.
+//
+//  The WorkerPool class is responsible for the following:
+//
+//     * Starting and stopping the worker threads
+//     * Handing out tasks to the workers
+//	   * Waiting for every task to finish
+//
+///////////////////////////////////////////////////////////////////////////
+
+#ifndef WORKERPOOL_H
+#define WORKERPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class WorkerPool
+{
+
+public:
+
+	// Typedef for a task: receives the task index and the index of the worker running it
+	typedef std::function<void(unsigned int task_index, unsigned int worker_index)> Task;
+
+	// Constructor (single threaded until SetThreadCount is called)
+	WorkerPool();
+
+	// Destructor (stops the worker threads)
+	~WorkerPool();
+
+	// Method to set the number of threads used by Run, including the calling thread (minimum of 1)
+	void SetThreadCount(unsigned int num_threads);
+
+	// Method to return the number of threads used by Run, including the calling thread
+	unsigned int GetThreadCount() const;
+
+	// Method to run a task for every task index in [0, num_tasks), and wait until they are all done
+	void Run(unsigned int num_tasks, const Task& task);
+
+private:
+
+	// Worker threads (worker indices 1 to threads.size(); the calling thread is worker 0)
+	std::vector<std::thread> threads;
+
+	// The work being run and the next task index to hand out
+	const Task* currentTask;
+	unsigned int numTasks;
+	std::atomic<unsigned int> nextTask;
+
+	// Variables used to communicate with the worker threads
+	std::mutex poolMutex;
+	std::condition_variable workReady;
+	std::condition_variable workFinished;
+	unsigned long long workGeneration;
+	unsigned int busyWorkers;
+	bool isStopping;
+
+	// Method run by each worker thread (start_generation is the work generation when the thread was started)
+	void WorkerLoop(unsigned int worker_index, unsigned long long start_generation);
+
+	// Method to run tasks until there are none left
+	void RunTasks(unsigned int worker_index);
+
+	// Method to stop and join the worker threads
+	void StopWorkers();
+};
+
+#endif